@@ -1,99 +1,116 @@
 #include "analisis_datos.h"
+#include "memoria.h"
+#include "poblacion.h"
+#include "arena.h"
 #include <stdlib.h>
 #include <string.h>
 
 // ============================================================
 // SUBPROBLEMA 1: Análisis de Datos
 // Implementaciones de MergeSort, QuickSort y HeapSort
+// Se ordenan índices de fila: las columnas de la Poblacion no se copian
 // ============================================================
 
-int comparar_individuos(const Individuo *a, const Individuo *b, CriterioOrdenamiento criterio) {
-  if (!a || !b) return 0;
+int comparar_individuos(const Poblacion *poblacion, int a, int b, CriterioOrdenamiento criterio) {
+  if (!poblacion) return 0;
   
   switch (criterio) {
     case ORDENAR_POR_RIESGO:
-      return a->riesgo - b->riesgo;
+      return poblacion->riesgo[a] - poblacion->riesgo[b];
     case ORDENAR_POR_TIEMPO:
-      return a->tiempo_infeccion - b->tiempo_infeccion;
-    case ORDENAR_POR_NOMBRE:
-      return strcmp(a->nombre, b->nombre);
+      return poblacion->tiempo_infeccion[a] - poblacion->tiempo_infeccion[b];
+    case ORDENAR_POR_NOMBRE: {
+      char nombre_a[MAX_NOMBRE], nombre_b[MAX_NOMBRE];
+      return strcmp(poblacion_nombre(poblacion, a, nombre_a), poblacion_nombre(poblacion, b, nombre_b));
+    }
     default:
       return 0;
   }
 }
 
 // MergeSort: O(n log n) garantizado
-void merge(Individuo *array, int izq, int mid, int der, CriterioOrdenamiento criterio) {
+// Solo la mitad izquierda se copia al buffer temporal; la mezcla escribe
+// sobre indices sin pisar elementos de la derecha aún no leídos
+void merge(const Poblacion *poblacion, int *indices, int *temporal, int izq, int mid, int der,
+           CriterioOrdenamiento criterio) {
   int n1 = mid - izq + 1;
-  int n2 = der - mid;
-  
-  Individuo *L = (Individuo *)malloc(n1 * sizeof(Individuo));
-  Individuo *R = (Individuo *)malloc(n2 * sizeof(Individuo));
   
-  for (int i = 0; i < n1; i++)
-    L[i] = array[izq + i];
-  for (int i = 0; i < n2; i++)
-    R[i] = array[mid + 1 + i];
+  memcpy(temporal, indices + izq, n1 * sizeof(int));
   
-  int i = 0, j = 0, k = izq;
-  while (i < n1 && j < n2) {
-    if (comparar_individuos(&L[i], &R[j], criterio) <= 0) {
-      array[k++] = L[i++];
+  int i = 0, j = mid + 1, k = izq;
+  while (i < n1 && j <= der) {
+    if (comparar_individuos(poblacion, temporal[i], indices[j], criterio) <= 0) {
+      indices[k++] = temporal[i++];
     } else {
-      array[k++] = R[j++];
+      indices[k++] = indices[j++];
     }
   }
   
-  while (i < n1) array[k++] = L[i++];
-  while (j < n2) array[k++] = R[j++];
-  
-  free(L);
-  free(R);
+  while (i < n1) indices[k++] = temporal[i++];
 }
 
-void merge_sort_helper(Individuo *array, int izq, int der, CriterioOrdenamiento criterio) {
+void merge_sort_helper(const Poblacion *poblacion, int *indices, int *temporal, int izq, int der,
+                       CriterioOrdenamiento criterio) {
   if (izq < der) {
     int mid = izq + (der - izq) / 2;
-    merge_sort_helper(array, izq, mid, criterio);
-    merge_sort_helper(array, mid + 1, der, criterio);
-    merge(array, izq, mid, der, criterio);
+    merge_sort_helper(poblacion, indices, temporal, izq, mid, criterio);
+    merge_sort_helper(poblacion, indices, temporal, mid + 1, der, criterio);
+    merge(poblacion, indices, temporal, izq, mid, der, criterio);
   }
 }
 
-void merge_sort(Individuo *array, int izq, int der, CriterioOrdenamiento criterio) {
-  merge_sort_helper(array, izq, der, criterio);
+void merge_sort(const Poblacion *poblacion, int *indices, int izq, int der, CriterioOrdenamiento criterio,
+                Arena *arena) {
+  if (izq >= der) return;
+  
+  // Un único buffer temporal para toda la recursión (mitad del rango)
+  size_t bytes = (size_t)((der - izq) / 2 + 1) * sizeof(int);
+  MarcaArena marca;
+  int *temporal;
+  if (arena) {
+    marca = arena_marca(arena);
+    temporal = (int *)arena_reservar(arena, bytes);
+  } else {
+    temporal = (int *)bio_malloc(bytes);
+  }
+  if (!temporal) return;
+  
+  merge_sort_helper(poblacion, indices, temporal, izq, der, criterio);
+  
+  if (arena) arena_restaurar(arena, marca);
+  else bio_free(temporal);
 }
 
 // QuickSort: O(n log n) promedio, O(n^2) peor caso
-int partition(Individuo *array, int izq, int der, CriterioOrdenamiento criterio) {
-  Individuo pivot = array[der];
+int partition(const Poblacion *poblacion, int *indices, int izq, int der, CriterioOrdenamiento criterio) {
+  int pivot = indices[der];
   int i = izq - 1;
   
   for (int j = izq; j < der; j++) {
-    if (comparar_individuos(&array[j], &pivot, criterio) < 0) {
+    if (comparar_individuos(poblacion, indices[j], pivot, criterio) < 0) {
       i++;
-      Individuo temp = array[i];
-      array[i] = array[j];
-      array[j] = temp;
+      int temp = indices[i];
+      indices[i] = indices[j];
+      indices[j] = temp;
     }
   }
   
-  Individuo temp = array[i + 1];
-  array[i + 1] = array[der];
-  array[der] = temp;
+  int temp = indices[i + 1];
+  indices[i + 1] = indices[der];
+  indices[der] = temp;
   return i + 1;
 }
 
-void quick_sort_helper(Individuo *array, int izq, int der, CriterioOrdenamiento criterio) {
+void quick_sort_helper(const Poblacion *poblacion, int *indices, int izq, int der, CriterioOrdenamiento criterio) {
   if (izq < der) {
-    int pi = partition(array, izq, der, criterio);
-    quick_sort_helper(array, izq, pi - 1, criterio);
-    quick_sort_helper(array, pi + 1, der, criterio);
+    int pi = partition(poblacion, indices, izq, der, criterio);
+    quick_sort_helper(poblacion, indices, izq, pi - 1, criterio);
+    quick_sort_helper(poblacion, indices, pi + 1, der, criterio);
   }
 }
 
-void quick_sort(Individuo *array, int izq, int der, CriterioOrdenamiento criterio) {
-  quick_sort_helper(array, izq, der, criterio);
+void quick_sort(const Poblacion *poblacion, int *indices, int izq, int der, CriterioOrdenamiento criterio) {
+  quick_sort_helper(poblacion, indices, izq, der, criterio);
 }
 
 // HeapSort: O(n log n) garantizado
@@ -103,38 +120,38 @@ static int padre_idx(int i) { return (i - 1) / 2; }
 static int hijo_izq_idx(int i) { return 2 * i + 1; }
 static int hijo_der_idx(int i) { return 2 * i + 2; }
 
-static void heapify_down(Individuo *array, int n, int i, CriterioOrdenamiento criterio) {
+static void heapify_down(const Poblacion *poblacion, int *indices, int n, int i, CriterioOrdenamiento criterio) {
   int mayor = i;
   int izq = hijo_izq_idx(i);
   int der = hijo_der_idx(i);
   
-  if (izq < n && comparar_individuos(&array[izq], &array[mayor], criterio) > 0)
+  if (izq < n && comparar_individuos(poblacion, indices[izq], indices[mayor], criterio) > 0)
     mayor = izq;
-  if (der < n && comparar_individuos(&array[der], &array[mayor], criterio) > 0)
+  if (der < n && comparar_individuos(poblacion, indices[der], indices[mayor], criterio) > 0)
     mayor = der;
   
   if (mayor != i) {
-    Individuo temp = array[i];
-    array[i] = array[mayor];
-    array[mayor] = temp;
-    heapify_down(array, n, mayor, criterio);
+    int temp = indices[i];
+    indices[i] = indices[mayor];
+    indices[mayor] = temp;
+    heapify_down(poblacion, indices, n, mayor, criterio);
   }
 }
 
-void heap_sort(Individuo *array, int n, CriterioOrdenamiento criterio) {
+void heap_sort(const Poblacion *poblacion, int *indices, int n, CriterioOrdenamiento criterio) {
   // Construir el heap (Max-Heap)
   // O(n) operación de heapificación
   for (int i = n / 2 - 1; i >= 0; i--) {
-    heapify_down(array, n, i, criterio);
+    heapify_down(poblacion, indices, n, i, criterio);
   }
   
   // Extraer elementos uno por uno del heap
   // O(n log n): n iteraciones, cada una O(log n)
   for (int i = n - 1; i > 0; i--) {
-    Individuo temp = array[0];
-    array[0] = array[i];
-    array[i] = temp;
-    heapify_down(array, i, 0, criterio);
+    int temp = indices[0];
+    indices[0] = indices[i];
+    indices[i] = temp;
+    heapify_down(poblacion, indices, i, 0, criterio);
   }
 }
 
@@ -142,128 +159,137 @@ void heap_sort(Individuo *array, int n, CriterioOrdenamiento criterio) {
 // FUNCION DE PRUEBA: Test de los tres algoritmos
 // ============================================================
 
-void test_analisis_datos(Individuo *poblacion, int num_individuos) {
-  if (!poblacion || num_individuos <= 0) {
-    printf("ERROR: Poblacion invalida para test\n");
+static void inicializar_indices(int *indices, int n) {
+  for (int i = 0; i < n; i++) {
+    indices[i] = i;
+  }
+}
+
+void test_analisis_datos(Poblacion *poblacion, FILE *salida) {
+  if (!poblacion || poblacion->num_individuos <= 0) {
+    fprintf(salida, "ERROR: Poblacion invalida para test\n");
     return;
   }
   
-  printf("\n========== SUBPROBLEMA 1: ANALISIS DE DATOS ==========\n");
-  printf("Población: %d individuos\n\n", num_individuos);
+  char nombre[MAX_NOMBRE]; // Buffer para nombres sintéticos
+  int num_individuos = poblacion->num_individuos;
+  
+  fprintf(salida, "\n========== SUBPROBLEMA 1: ANALISIS DE DATOS ==========\n");
+  fprintf(salida, "Población: %d individuos\n\n", num_individuos);
+  
+  // Arena de la etapa: permutaciones y buffer de MergeSort en un bloque
+  size_t bytes_indices = (size_t)num_individuos * sizeof(int);
+  Arena *arena = arena_crear(bytes_indices * 4 + 4 * ARENA_ALINEACION);
   
-  // Crear copias de la poblacion para cada algoritmo
-  Individuo *copia_merge = (Individuo *)malloc(num_individuos * sizeof(Individuo));
-  Individuo *copia_quick = (Individuo *)malloc(num_individuos * sizeof(Individuo));
-  Individuo *copia_heap = (Individuo *)malloc(num_individuos * sizeof(Individuo));
+  // Un array de índices por algoritmo (las columnas no se copian)
+  int *copia_merge = (int *)arena_reservar(arena, bytes_indices);
+  int *copia_quick = (int *)arena_reservar(arena, bytes_indices);
+  int *copia_heap = (int *)arena_reservar(arena, bytes_indices);
   
   if (!copia_merge || !copia_quick || !copia_heap) {
-    printf("ERROR: No se pudo asignar memoria para copias\n");
-    free(copia_merge);
-    free(copia_quick);
-    free(copia_heap);
+    fprintf(salida, "ERROR: No se pudo asignar memoria para copias\n");
+    arena_liberar(arena);
     return;
   }
   
   // ===== PRUEBA 1: ORDENAR POR RIESGO =====
-  printf("--- PRUEBA 1: Ordenar por RIESGO ---\n");
+  fprintf(salida, "--- PRUEBA 1: Ordenar por RIESGO ---\n");
   
-  // Copiar datos
-  memcpy(copia_merge, poblacion, num_individuos * sizeof(Individuo));
-  memcpy(copia_quick, poblacion, num_individuos * sizeof(Individuo));
-  memcpy(copia_heap, poblacion, num_individuos * sizeof(Individuo));
+  // Inicializar permutaciones
+  inicializar_indices(copia_merge, num_individuos);
+  inicializar_indices(copia_quick, num_individuos);
+  inicializar_indices(copia_heap, num_individuos);
   
   // MergeSort
-  merge_sort(copia_merge, 0, num_individuos - 1, ORDENAR_POR_RIESGO);
+  merge_sort(poblacion, copia_merge, 0, num_individuos - 1, ORDENAR_POR_RIESGO, arena);
   
   // QuickSort
-  quick_sort(copia_quick, 0, num_individuos - 1, ORDENAR_POR_RIESGO);
+  quick_sort(poblacion, copia_quick, 0, num_individuos - 1, ORDENAR_POR_RIESGO);
   
   // HeapSort
-  heap_sort(copia_heap, num_individuos, ORDENAR_POR_RIESGO);
+  heap_sort(poblacion, copia_heap, num_individuos, ORDENAR_POR_RIESGO);
   
-  printf("MergeSort - Últimos 5 individuos por riesgo (MAYOR RIESGO):\n");
+  fprintf(salida, "MergeSort - Últimos 5 individuos por riesgo (MAYOR RIESGO):\n");
   for (int i = num_individuos - 5; i < num_individuos && i >= 0; i++) {
-    printf("  %s: riesgo=%d\n", copia_merge[i].nombre, copia_merge[i].riesgo);
+    fprintf(salida, "  %s: riesgo=%d\n", poblacion_nombre(poblacion, copia_merge[i], nombre), poblacion->riesgo[copia_merge[i]]);
   }
   
-  printf("\nQuickSort - Últimos 5 individuos por riesgo (MAYOR RIESGO):\n");
+  fprintf(salida, "\nQuickSort - Últimos 5 individuos por riesgo (MAYOR RIESGO):\n");
   for (int i = num_individuos - 5; i < num_individuos && i >= 0; i++) {
-    printf("  %s: riesgo=%d\n", copia_quick[i].nombre, copia_quick[i].riesgo);
+    fprintf(salida, "  %s: riesgo=%d\n", poblacion_nombre(poblacion, copia_quick[i], nombre), poblacion->riesgo[copia_quick[i]]);
   }
   
-  printf("\nHeapSort - Últimos 5 individuos por riesgo (MAYOR RIESGO):\n");
+  fprintf(salida, "\nHeapSort - Últimos 5 individuos por riesgo (MAYOR RIESGO):\n");
   for (int i = num_individuos - 5; i < num_individuos && i >= 0; i++) {
-    printf("  %s: riesgo=%d\n", copia_heap[i].nombre, copia_heap[i].riesgo);
+    fprintf(salida, "  %s: riesgo=%d\n", poblacion_nombre(poblacion, copia_heap[i], nombre), poblacion->riesgo[copia_heap[i]]);
   }
   
   // ===== PRUEBA 2: ORDENAR POR TIEMPO DE INFECCION =====
-  printf("\n--- PRUEBA 2: Ordenar por TIEMPO DE INFECCION ---\n");
+  fprintf(salida, "\n--- PRUEBA 2: Ordenar por TIEMPO DE INFECCION ---\n");
   
-  // Copiar datos
-  memcpy(copia_merge, poblacion, num_individuos * sizeof(Individuo));
-  memcpy(copia_quick, poblacion, num_individuos * sizeof(Individuo));
-  memcpy(copia_heap, poblacion, num_individuos * sizeof(Individuo));
+  // Inicializar permutaciones
+  inicializar_indices(copia_merge, num_individuos);
+  inicializar_indices(copia_quick, num_individuos);
+  inicializar_indices(copia_heap, num_individuos);
   
   // MergeSort
-  merge_sort(copia_merge, 0, num_individuos - 1, ORDENAR_POR_TIEMPO);
+  merge_sort(poblacion, copia_merge, 0, num_individuos - 1, ORDENAR_POR_TIEMPO, arena);
   
   // QuickSort
-  quick_sort(copia_quick, 0, num_individuos - 1, ORDENAR_POR_TIEMPO);
+  quick_sort(poblacion, copia_quick, 0, num_individuos - 1, ORDENAR_POR_TIEMPO);
   
   // HeapSort
-  heap_sort(copia_heap, num_individuos, ORDENAR_POR_TIEMPO);
+  heap_sort(poblacion, copia_heap, num_individuos, ORDENAR_POR_TIEMPO);
   
-  printf("MergeSort - Últimos 5 infectados (mayor tiempo):\n");
+  fprintf(salida, "MergeSort - Últimos 5 infectados (mayor tiempo):\n");
   for (int i = num_individuos - 5; i < num_individuos && i >= 0; i++) {
-    printf("  %s: tiempo_infeccion=%d\n", copia_merge[i].nombre, copia_merge[i].tiempo_infeccion);
+    fprintf(salida, "  %s: tiempo_infeccion=%d\n", poblacion_nombre(poblacion, copia_merge[i], nombre), poblacion->tiempo_infeccion[copia_merge[i]]);
   }
   
-  printf("\nQuickSort - Últimos 5 infectados (mayor tiempo):\n");
+  fprintf(salida, "\nQuickSort - Últimos 5 infectados (mayor tiempo):\n");
   for (int i = num_individuos - 5; i < num_individuos && i >= 0; i++) {
-    printf("  %s: tiempo_infeccion=%d\n", copia_quick[i].nombre, copia_quick[i].tiempo_infeccion);
+    fprintf(salida, "  %s: tiempo_infeccion=%d\n", poblacion_nombre(poblacion, copia_quick[i], nombre), poblacion->tiempo_infeccion[copia_quick[i]]);
   }
   
-  printf("\nHeapSort - Últimos 5 infectados (mayor tiempo):\n");
+  fprintf(salida, "\nHeapSort - Últimos 5 infectados (mayor tiempo):\n");
   for (int i = num_individuos - 5; i < num_individuos && i >= 0; i++) {
-    printf("  %s: tiempo_infeccion=%d\n", copia_heap[i].nombre, copia_heap[i].tiempo_infeccion);
+    fprintf(salida, "  %s: tiempo_infeccion=%d\n", poblacion_nombre(poblacion, copia_heap[i], nombre), poblacion->tiempo_infeccion[copia_heap[i]]);
   }
   
   // ===== PRUEBA 3: ORDENAR POR NOMBRE =====
-  printf("\n--- PRUEBA 3: Ordenar por NOMBRE (alfabetico) ---\n");
+  fprintf(salida, "\n--- PRUEBA 3: Ordenar por NOMBRE (alfabetico) ---\n");
   
-  // Copiar datos
-  memcpy(copia_merge, poblacion, num_individuos * sizeof(Individuo));
-  memcpy(copia_quick, poblacion, num_individuos * sizeof(Individuo));
-  memcpy(copia_heap, poblacion, num_individuos * sizeof(Individuo));
+  // Inicializar permutaciones
+  inicializar_indices(copia_merge, num_individuos);
+  inicializar_indices(copia_quick, num_individuos);
+  inicializar_indices(copia_heap, num_individuos);
   
   // MergeSort
-  merge_sort(copia_merge, 0, num_individuos - 1, ORDENAR_POR_NOMBRE);
+  merge_sort(poblacion, copia_merge, 0, num_individuos - 1, ORDENAR_POR_NOMBRE, arena);
   
   // QuickSort
-  quick_sort(copia_quick, 0, num_individuos - 1, ORDENAR_POR_NOMBRE);
+  quick_sort(poblacion, copia_quick, 0, num_individuos - 1, ORDENAR_POR_NOMBRE);
   
   // HeapSort
-  heap_sort(copia_heap, num_individuos, ORDENAR_POR_NOMBRE);
+  heap_sort(poblacion, copia_heap, num_individuos, ORDENAR_POR_NOMBRE);
   
-  printf("MergeSort - Primeros 5 por nombre:\n");
+  fprintf(salida, "MergeSort - Primeros 5 por nombre:\n");
   for (int i = 0; i < 5 && i < num_individuos; i++) {
-    printf("  %s\n", copia_merge[i].nombre);
+    fprintf(salida, "  %s\n", poblacion_nombre(poblacion, copia_merge[i], nombre));
   }
   
-  printf("\nQuickSort - Primeros 5 por nombre:\n");
+  fprintf(salida, "\nQuickSort - Primeros 5 por nombre:\n");
   for (int i = 0; i < 5 && i < num_individuos; i++) {
-    printf("  %s\n", copia_quick[i].nombre);
+    fprintf(salida, "  %s\n", poblacion_nombre(poblacion, copia_quick[i], nombre));
   }
   
-  printf("\nHeapSort - Primeros 5 por nombre:\n");
+  fprintf(salida, "\nHeapSort - Primeros 5 por nombre:\n");
   for (int i = 0; i < 5 && i < num_individuos; i++) {
-    printf("  %s\n", copia_heap[i].nombre);
+    fprintf(salida, "  %s\n", poblacion_nombre(poblacion, copia_heap[i], nombre));
   }
   
-  printf("\n===== FIN PRUEBAS SUBPROBLEMA 1 =====\n\n");
+  fprintf(salida, "\n===== FIN PRUEBAS SUBPROBLEMA 1 =====\n\n");
   
-  // Liberar memoria
-  free(copia_merge);
-  free(copia_quick);
-  free(copia_heap);
+  // Liberar memoria (toda la etapa de una vez)
+  arena_liberar(arena);
 }
@@ -2,12 +2,15 @@
 #define ANALISIS_DATOS_H
 
 #include "estructuras.h"
+#include "arena.h"
 
 // ============================================================
 // SUBPROBLEMA 1: Análisis de Datos
 // Ordenar individuos por Riesgo, Tiempo y Nombre
 // Restricción: O(n log n)
 // Algoritmos: MergeSort, QuickSort, HeapSort
+// Los algoritmos ordenan un array de índices de fila de la Poblacion;
+// las columnas no se mueven y la clave se lee de la columna del criterio.
 // ============================================================
 
 typedef enum {
@@ -17,34 +20,39 @@ typedef enum {
 } CriterioOrdenamiento;
 
 /**
- * Implementa MergeSort para ordenar individuos
+ * Implementa MergeSort para ordenar índices de individuos
+ * Usa un único buffer temporal de n/2 enteros, tomado de la arena si se
+ * indica (NULL: malloc/free una vez por llamada)
  * Complejidad: O(n log n) garantizado
  */
-void merge_sort(Individuo *array, int izq, int der, CriterioOrdenamiento criterio);
+void merge_sort(const Poblacion *poblacion, int *indices, int izq, int der, CriterioOrdenamiento criterio,
+                Arena *arena);
 
 /**
- * Implementa QuickSort para ordenar individuos
+ * Implementa QuickSort para ordenar índices de individuos
  * Complejidad: O(n log n) promedio, O(n^2) peor caso
  */
-void quick_sort(Individuo *array, int izq, int der, CriterioOrdenamiento criterio);
+void quick_sort(const Poblacion *poblacion, int *indices, int izq, int der, CriterioOrdenamiento criterio);
 
 /**
- * Implementa HeapSort para ordenar individuos
+ * Implementa HeapSort para ordenar índices de individuos
  * Complejidad: O(n log n) garantizado
  */
-void heap_sort(Individuo *array, int n, CriterioOrdenamiento criterio);
+void heap_sort(const Poblacion *poblacion, int *indices, int n, CriterioOrdenamiento criterio);
 
 /**
  * Función de comparación para criterios de ordenamiento
+ * a, b: índices de fila en la Poblacion
  * Retorna: < 0 si a < b, 0 si a == b, > 0 si a > b
  */
-int comparar_individuos(const Individuo *a, const Individuo *b, CriterioOrdenamiento criterio);
+int comparar_individuos(const Poblacion *poblacion, int a, int b, CriterioOrdenamiento criterio);
 
 /**
  * Función de prueba para los tres algoritmos de ordenamiento
  * Complejidad: O(3 * n log n) = O(n log n)
  * Demuestra los tres algoritmos con tres criterios diferentes
+ * El reporte se escribe en salida (stdout o el buffer de la etapa)
  */
-void test_analisis_datos(Individuo *poblacion, int num_individuos);
+void test_analisis_datos(Poblacion *poblacion, FILE *salida);
 
 #endif // ANALISIS_DATOS_H
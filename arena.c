@@ -0,0 +1,115 @@
+#include "arena.h"
+#include "memoria.h"
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================
+// IMPLEMENTACION ARENA
+// Lista de bloques: 'actual' es el bloque donde se reserva; los bloques
+// posteriores (liberados por una restauración) se reutilizan antes de
+// pedir uno nuevo al sistema.
+// ============================================================
+
+#define TAMANO_BLOQUE_MINIMO 4096
+
+static size_t alinear(size_t valor) {
+  return (valor + ARENA_ALINEACION - 1) & ~(size_t)(ARENA_ALINEACION - 1);
+}
+
+static char* datos_bloque(BloqueArena *bloque) {
+  return (char *)bloque + alinear(sizeof(BloqueArena));
+}
+
+static BloqueArena* bloque_crear(Arena *arena, size_t capacidad) {
+  BloqueArena *bloque = (BloqueArena *)bio_malloc(alinear(sizeof(BloqueArena)) + capacidad);
+  if (!bloque) return NULL;
+  bloque->siguiente = NULL;
+  bloque->capacidad = capacidad;
+  bloque->usado = 0;
+  arena->bytes_reservados += capacidad;
+  return bloque;
+}
+
+Arena* arena_crear(size_t tamano_bloque) {
+  Arena *arena = (Arena *)bio_malloc(sizeof(Arena));
+  if (!arena) return NULL;
+  arena->primero = NULL;
+  arena->actual = NULL;
+  arena->tamano_bloque = tamano_bloque < TAMANO_BLOQUE_MINIMO ? TAMANO_BLOQUE_MINIMO : tamano_bloque;
+  arena->bytes_reservados = 0;
+  return arena;
+}
+
+void* arena_reservar(Arena *arena, size_t bytes) {
+  if (!arena) return NULL;
+  bytes = alinear(bytes > 0 ? bytes : 1);
+
+  // Camino rápido: cabe en el bloque actual
+  BloqueArena *bloque = arena->actual;
+  if (bloque && bloque->capacidad - bloque->usado >= bytes) {
+    void *puntero = datos_bloque(bloque) + bloque->usado;
+    bloque->usado += bytes;
+    return puntero;
+  }
+
+  // Reutilizar el siguiente bloque ya reservado si es suficiente
+  BloqueArena *siguiente = bloque ? bloque->siguiente : arena->primero;
+  if (siguiente && siguiente->capacidad >= bytes) {
+    siguiente->usado = bytes;
+    arena->actual = siguiente;
+    return datos_bloque(siguiente);
+  }
+
+  // Bloque nuevo (al menos del doble del pedido para amortizar), insertado
+  // a continuación del actual para no perder los que siguen
+  size_t capacidad = arena->tamano_bloque;
+  if (capacidad < bytes * 2) capacidad = bytes * 2;
+  BloqueArena *nuevo = bloque_crear(arena, capacidad);
+  if (!nuevo) return NULL;
+
+  nuevo->siguiente = siguiente;
+  if (bloque) bloque->siguiente = nuevo;
+  else arena->primero = nuevo;
+
+  nuevo->usado = bytes;
+  arena->actual = nuevo;
+  return datos_bloque(nuevo);
+}
+
+void* arena_reservar_cero(Arena *arena, size_t bytes) {
+  void *puntero = arena_reservar(arena, bytes);
+  if (puntero) memset(puntero, 0, bytes);
+  return puntero;
+}
+
+MarcaArena arena_marca(const Arena *arena) {
+  MarcaArena marca;
+  marca.bloque = arena->actual;
+  marca.usado = arena->actual ? arena->actual->usado : 0;
+  return marca;
+}
+
+void arena_restaurar(Arena *arena, MarcaArena marca) {
+  if (!arena) return;
+  arena->actual = marca.bloque;
+  if (marca.bloque) {
+    marca.bloque->usado = marca.usado;
+  }
+}
+
+void arena_reiniciar(Arena *arena) {
+  if (!arena) return;
+  arena->actual = NULL;
+}
+
+void arena_liberar(Arena *arena) {
+  if (!arena) return;
+
+  BloqueArena *bloque = arena->primero;
+  while (bloque) {
+    BloqueArena *siguiente = bloque->siguiente;
+    bio_free(bloque);
+    bloque = siguiente;
+  }
+  bio_free(arena);
+}
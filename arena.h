@@ -0,0 +1,76 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// ============================================================
+// ARENA - Asignador por desplazamiento (bump allocator)
+// Para buffers temporales de una etapa o consulta: reservar es avanzar
+// un puntero y todo se devuelve de una vez con arena_restaurar o
+// arena_reiniciar. Los bloques se conservan para la siguiente consulta,
+// así que las consultas repetidas no llaman a malloc.
+// ============================================================
+
+// Alineación de cada reserva (suficiente para cualquier tipo escalar)
+#define ARENA_ALINEACION 16
+
+typedef struct BloqueArena {
+  struct BloqueArena *siguiente;
+  size_t capacidad;
+  size_t usado;
+  // Los datos siguen a la cabecera (alineados a ARENA_ALINEACION)
+} BloqueArena;
+
+typedef struct {
+  BloqueArena *primero;
+  BloqueArena *actual;
+  size_t tamano_bloque;     // Capacidad mínima de los bloques nuevos
+  size_t bytes_reservados;  // Total pedido al sistema
+} Arena;
+
+// Punto de restauración: todo lo reservado después se libera de golpe
+typedef struct {
+  BloqueArena *bloque;
+  size_t usado;
+} MarcaArena;
+
+/**
+ * Crea una arena; los bloques se piden al sistema bajo demanda
+ * Complejidad: O(1)
+ */
+Arena* arena_crear(size_t tamano_bloque);
+
+/**
+ * Reserva bytes alineados (sin inicializar)
+ * Complejidad: O(1) amortizado
+ * Retorna: puntero o NULL si no hay memoria
+ */
+void* arena_reservar(Arena *arena, size_t bytes);
+
+/**
+ * Reserva bytes inicializados a cero
+ * Complejidad: O(bytes)
+ */
+void* arena_reservar_cero(Arena *arena, size_t bytes);
+
+/**
+ * Marca / restaura: alcance de una consulta o etapa
+ * Complejidad: O(1)
+ */
+MarcaArena arena_marca(const Arena *arena);
+void arena_restaurar(Arena *arena, MarcaArena marca);
+
+/**
+ * Vacía la arena conservando sus bloques
+ * Complejidad: O(bloques)
+ */
+void arena_reiniciar(Arena *arena);
+
+/**
+ * Devuelve todos los bloques al sistema
+ * Complejidad: O(bloques)
+ */
+void arena_liberar(Arena *arena);
+
+#endif // ARENA_H
@@ -0,0 +1,877 @@
+#define _POSIX_C_SOURCE 200809L
+#include "estructuras.h"
+#include "memoria.h"
+#include "poblacion.h"
+#include "grafo_csr.h"
+#include "hash_table.h"
+#include "hash_concurrente.h"
+#include "mapa_ids.h"
+#include "heap.h"
+#include "union_find.h"
+#include "trie.h"
+#include "analisis_datos.h"
+#include "ingesta.h"
+#include "arena.h"
+#include "rng.h"
+#include "instrumentacion.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+// ============================================================
+// BENCH - Microbenchmarks de las estructuras base
+// Binario aparte de generador: mide ns/op, throughput y percentiles
+// (por lotes de operaciones) para TablaHash, MapaIds, Heap, UnionFind,
+// Trie y los tres ordenamientos, en tamaños de 10^min a 10^max. La tabla
+// hash concurrente se mide además con 1, 2, 4 ... --hilos-max hilos y la
+// ingesta CSV/TSV con archivos de 10^min a 10^max registros (GB/s).
+//
+// Uso: bench [--min N] [--max N] [--repeticiones R] [--presupuesto seg]
+//            [--solo hash|hash_concurrente|mapa_ids|heap|union_find|trie|orden|ingesta]
+//            [--hilos-max N] [--semilla N] [--csv]
+// ============================================================
+
+// Operaciones por muestra de latencia (el reloj cuesta ~20 ns)
+#define OPS_POR_LOTE 256
+
+// Longitud de las secuencias ADN del Trie y de los prefijos buscados
+#define LARGO_ADN_BENCH 20
+#define LARGO_PREFIJO_BENCH 10
+
+typedef struct {
+  double *muestras;         // ns/op de cada lote
+  int num_muestras;
+  int capacidad;
+  uint64_t total_ns;
+  uint64_t operaciones;
+  uint64_t bytes;           // Bytes procesados (0 = sin columna GB/s)
+} Medicion;
+
+typedef struct {
+  int min_exponente;
+  int max_exponente;
+  int repeticiones;
+  double presupuesto_seg;  // Tamaños mayores se omiten si se prevé excederlo
+  const char *solo;
+  int hilos_max;           // Mayor número de hilos de hash_concurrente
+  uint64_t semilla;
+  bool csv;
+} OpcionesBench;
+
+static OpcionesBench opciones = { 3, 6, 3, 10.0, NULL, 64, 12345, false };
+
+// Evita que el compilador descarte resultados
+static volatile long long sumidero;
+
+// ===== MEDICION =====
+
+static void medicion_iniciar(Medicion *m) {
+  m->muestras = NULL;
+  m->num_muestras = 0;
+  m->capacidad = 0;
+  m->total_ns = 0;
+  m->operaciones = 0;
+  m->bytes = 0;
+}
+
+static void medicion_lote(Medicion *m, uint64_t ns, int ops) {
+  if (ops <= 0) return;
+  if (m->num_muestras == m->capacidad) {
+    m->capacidad = m->capacidad ? m->capacidad * 2 : 1024;
+    m->muestras = (double *)bio_realloc(m->muestras, m->capacidad * sizeof(double));
+  }
+  m->muestras[m->num_muestras++] = (double)ns / ops;
+  m->total_ns += ns;
+  m->operaciones += ops;
+}
+
+// Agrega los lotes y operaciones de origen (no su tiempo total)
+static void medicion_sumar_muestras(Medicion *destino, const Medicion *origen) {
+  for (int k = 0; k < origen->num_muestras; k++) {
+    if (destino->num_muestras == destino->capacidad) {
+      destino->capacidad = destino->capacidad ? destino->capacidad * 2 : 1024;
+      destino->muestras = (double *)bio_realloc(destino->muestras, destino->capacidad * sizeof(double));
+    }
+    destino->muestras[destino->num_muestras++] = origen->muestras[k];
+  }
+  destino->operaciones += origen->operaciones;
+}
+
+static void medicion_liberar(Medicion *m) {
+  bio_free(m->muestras);
+  medicion_iniciar(m);
+}
+
+static int comparar_double(const void *a, const void *b) {
+  double x = *(const double *)a, y = *(const double *)b;
+  return (x > y) - (x < y);
+}
+
+static double percentil(const double *ordenadas, int n, double p) {
+  if (n == 0) return 0.0;
+  int k = (int)(p * (n - 1) + 0.5);
+  return ordenadas[k];
+}
+
+static void imprimir_cabecera(void) {
+  if (opciones.csv) {
+    printf("estructura,operacion,n,operaciones,ns_op,mops_s,p50_ns,p90_ns,p99_ns,gb_s\n");
+  } else {
+    printf("%-12s %-18s %11s %12s %10s %10s %10s %10s %10s %8s\n",
+           "Estructura", "Operacion", "n", "Operaciones", "ns/op", "Mops/s",
+           "p50 ns", "p90 ns", "p99 ns", "GB/s");
+    printf("------------+------------------+-----------+------------+----------+"
+           "----------+----------+----------+----------+--------\n");
+  }
+}
+
+static void reportar(const char *estructura, const char *operacion, int n, Medicion *m) {
+  if (m->operaciones == 0) return;
+  qsort(m->muestras, m->num_muestras, sizeof(double), comparar_double);
+  double ns_op = (double)m->total_ns / (double)m->operaciones;
+  double mops = ns_op > 0 ? 1e3 / ns_op : 0.0;
+  double p50 = percentil(m->muestras, m->num_muestras, 0.50);
+  double p90 = percentil(m->muestras, m->num_muestras, 0.90);
+  double p99 = percentil(m->muestras, m->num_muestras, 0.99);
+
+  // bytes / ns = GB/s
+  char gb_s[32] = "";
+  if (m->bytes > 0 && m->total_ns > 0) {
+    snprintf(gb_s, sizeof(gb_s), "%.3f", (double)m->bytes / (double)m->total_ns);
+  }
+
+  if (opciones.csv) {
+    printf("%s,%s,%d,%llu,%.2f,%.3f,%.2f,%.2f,%.2f,%s\n", estructura, operacion, n,
+           (unsigned long long)m->operaciones, ns_op, mops, p50, p90, p99, gb_s);
+  } else {
+    printf("%-12s %-18s %11d %12llu %10.2f %10.3f %10.2f %10.2f %10.2f %8s\n",
+           estructura, operacion, n, (unsigned long long)m->operaciones,
+           ns_op, mops, p50, p90, p99, m->bytes > 0 ? gb_s : "-");
+  }
+  fflush(stdout);
+}
+
+// ===== DATOS DE ENTRADA =====
+
+// Permutación aleatoria de 0..n-1 (Fisher-Yates)
+static int* permutacion(int n, uint64_t flujo) {
+  int *p = (int *)bio_malloc((size_t)n * sizeof(int));
+  if (!p) return NULL;
+  RngFlujo rng = rng_flujo_crear(opciones.semilla, flujo);
+  for (int i = 0; i < n; i++) p[i] = i;
+  for (int i = n - 1; i > 0; i--) {
+    int j = rng_entero(&rng, i + 1);
+    int t = p[i];
+    p[i] = p[j];
+    p[j] = t;
+  }
+  return p;
+}
+
+static int* enteros_aleatorios(int n, int rango, uint64_t flujo) {
+  int *v = (int *)bio_malloc((size_t)n * sizeof(int));
+  if (!v) return NULL;
+  RngFlujo rng = rng_flujo_crear(opciones.semilla, flujo);
+  for (int i = 0; i < n; i++) v[i] = rng_entero(&rng, rango);
+  return v;
+}
+
+// ===== TABLA HASH =====
+// La tabla crece desde HASH_CAPACIDAD_MINIMA: insertar incluye las
+// ampliaciones. Además, con la capacidad fija (la mayor potencia de 2
+// cuyo 75% entra en n) se mide buscar, fallar y eliminar con la tabla al
+// 25%, 50% y 75% de carga
+
+static void medir_hash_carga(const int *claves, const int *orden, int n) {
+  int capacidad = HASH_CAPACIDAD_MINIMA;
+  while ((long long)capacidad * 2 * 3 <= (long long)n * 4) capacidad *= 2;
+  if ((long long)capacidad * 3 > (long long)n * 4) return;  // n muy chico
+
+  int *consultas = (int *)bio_malloc((size_t)n * sizeof(int));
+  if (!consultas) return;
+
+  for (int cuartos = 1; cuartos <= 3; cuartos++) {
+    int k = capacidad / 4 * cuartos;
+    // Las k claves insertadas, en orden aleatorio
+    int num_consultas = 0;
+    for (int i = 0; i < n; i++) {
+      if (orden[i] < k) consultas[num_consultas++] = claves[orden[i]];
+    }
+
+    Medicion buscar, fallar, eliminar;
+    medicion_iniciar(&buscar);
+    medicion_iniciar(&fallar);
+    medicion_iniciar(&eliminar);
+    for (int r = 0; r < opciones.repeticiones; r++) {
+      TablaHash *tabla = hash_table_crear();
+      if (!tabla || !hash_table_reservar(tabla, capacidad / 4 * 3)) {
+        hash_table_liberar(tabla);
+        break;
+      }
+      for (int i = 0; i < k; i++) hash_table_insertar(tabla, claves[i], i);
+
+      long long suma = 0;
+      for (int i = 0; i < k; i += OPS_POR_LOTE) {
+        int fin = i + OPS_POR_LOTE < k ? i + OPS_POR_LOTE : k;
+        uint64_t t0 = instr_reloj_ns();
+        for (int j = i; j < fin; j++) suma += hash_table_buscar(tabla, consultas[j]);
+        medicion_lote(&buscar, instr_reloj_ns() - t0, fin - i);
+      }
+      for (int i = 0; i < k; i += OPS_POR_LOTE) {
+        int fin = i + OPS_POR_LOTE < k ? i + OPS_POR_LOTE : k;
+        uint64_t t0 = instr_reloj_ns();
+        for (int j = i; j < fin; j++) suma += hash_table_buscar(tabla, n + consultas[j]);
+        medicion_lote(&fallar, instr_reloj_ns() - t0, fin - i);
+      }
+      for (int i = 0; i < k; i += OPS_POR_LOTE) {
+        int fin = i + OPS_POR_LOTE < k ? i + OPS_POR_LOTE : k;
+        uint64_t t0 = instr_reloj_ns();
+        for (int j = i; j < fin; j++) hash_table_eliminar(tabla, consultas[j]);
+        medicion_lote(&eliminar, instr_reloj_ns() - t0, fin - i);
+      }
+      sumidero += suma;
+      hash_table_liberar(tabla);
+    }
+
+    char operacion[32];
+    snprintf(operacion, sizeof(operacion), "buscar carga %d%%", 25 * cuartos);
+    reportar("TablaHash", operacion, k, &buscar);
+    snprintf(operacion, sizeof(operacion), "fallo carga %d%%", 25 * cuartos);
+    reportar("TablaHash", operacion, k, &fallar);
+    snprintf(operacion, sizeof(operacion), "eliminar carga %d%%", 25 * cuartos);
+    reportar("TablaHash", operacion, k, &eliminar);
+    medicion_liberar(&buscar);
+    medicion_liberar(&fallar);
+    medicion_liberar(&eliminar);
+  }
+  bio_free(consultas);
+}
+
+static bool bench_hash(int n) {
+  int *claves = permutacion(n, 1);
+  int *orden = permutacion(n, 2);
+  int *consultas = (int *)bio_malloc((size_t)n * sizeof(int));
+  if (!claves || !orden || !consultas) {
+    bio_free(claves);
+    bio_free(orden);
+    bio_free(consultas);
+    return false;
+  }
+  // Claves presentes en orden aleatorio, las mismas para buscar y lote
+  for (int i = 0; i < n; i++) consultas[i] = claves[orden[i]];
+  int filas[OPS_POR_LOTE];
+
+  Medicion insertar, buscar, lote, fallar, eliminar;
+  medicion_iniciar(&insertar);
+  medicion_iniciar(&buscar);
+  medicion_iniciar(&lote);
+  medicion_iniciar(&fallar);
+  medicion_iniciar(&eliminar);
+
+  for (int r = 0; r < opciones.repeticiones; r++) {
+    TablaHash *tabla = hash_table_crear();
+    for (int i = 0; i < n; i += OPS_POR_LOTE) {
+      int fin = i + OPS_POR_LOTE < n ? i + OPS_POR_LOTE : n;
+      uint64_t t0 = instr_reloj_ns();
+      for (int k = i; k < fin; k++) hash_table_insertar(tabla, claves[k], k);
+      medicion_lote(&insertar, instr_reloj_ns() - t0, fin - i);
+    }
+    long long suma = 0;
+    for (int i = 0; i < n; i += OPS_POR_LOTE) {
+      int fin = i + OPS_POR_LOTE < n ? i + OPS_POR_LOTE : n;
+      uint64_t t0 = instr_reloj_ns();
+      for (int k = i; k < fin; k++) suma += hash_table_buscar(tabla, consultas[k]);
+      medicion_lote(&buscar, instr_reloj_ns() - t0, fin - i);
+    }
+    for (int i = 0; i < n; i += OPS_POR_LOTE) {
+      int fin = i + OPS_POR_LOTE < n ? i + OPS_POR_LOTE : n;
+      uint64_t t0 = instr_reloj_ns();
+      hash_table_buscar_lote(tabla, &consultas[i], fin - i, filas);
+      for (int k = 0; k < fin - i; k++) suma += filas[k];
+      medicion_lote(&lote, instr_reloj_ns() - t0, fin - i);
+    }
+    // Claves ausentes: sondean hasta el primer grupo con un hueco
+    for (int i = 0; i < n; i += OPS_POR_LOTE) {
+      int fin = i + OPS_POR_LOTE < n ? i + OPS_POR_LOTE : n;
+      uint64_t t0 = instr_reloj_ns();
+      for (int k = i; k < fin; k++) suma += hash_table_buscar(tabla, n + orden[k]);
+      medicion_lote(&fallar, instr_reloj_ns() - t0, fin - i);
+    }
+    for (int i = 0; i < n; i += OPS_POR_LOTE) {
+      int fin = i + OPS_POR_LOTE < n ? i + OPS_POR_LOTE : n;
+      uint64_t t0 = instr_reloj_ns();
+      for (int k = i; k < fin; k++) hash_table_eliminar(tabla, claves[orden[k]]);
+      medicion_lote(&eliminar, instr_reloj_ns() - t0, fin - i);
+    }
+    sumidero += suma;
+    hash_table_liberar(tabla);
+  }
+
+  reportar("TablaHash", "insertar", n, &insertar);
+  reportar("TablaHash", "buscar acierto", n, &buscar);
+  reportar("TablaHash", "buscar lote", n, &lote);
+  reportar("TablaHash", "buscar fallo", n, &fallar);
+  reportar("TablaHash", "eliminar", n, &eliminar);
+  medir_hash_carga(claves, orden, n);
+
+  medicion_liberar(&insertar);
+  medicion_liberar(&buscar);
+  medicion_liberar(&lote);
+  medicion_liberar(&fallar);
+  medicion_liberar(&eliminar);
+  bio_free(claves);
+  bio_free(orden);
+  bio_free(consultas);
+  return true;
+}
+
+// ===== MAPA DE IDS =====
+// IDs densos 0..n-1 en filas al azar (como los de inicializar_poblacion):
+// todas las búsquedas van al índice directo
+
+static bool bench_mapa_ids(int n) {
+  int *ids = permutacion(n, 1);
+  int *consultas = permutacion(n, 2);
+  if (!ids || !consultas) {
+    bio_free(ids);
+    bio_free(consultas);
+    return false;
+  }
+  int filas[OPS_POR_LOTE];
+  Medicion construir, buscar, lote;
+  medicion_iniciar(&construir);
+  medicion_iniciar(&buscar);
+  medicion_iniciar(&lote);
+
+  for (int r = 0; r < opciones.repeticiones; r++) {
+    uint64_t t0 = instr_reloj_ns();
+    MapaIds *mapa = mapa_ids_construir(ids, n);
+    medicion_lote(&construir, instr_reloj_ns() - t0, n);
+    if (!mapa) break;
+
+    long long suma = 0;
+    for (int i = 0; i < n; i += OPS_POR_LOTE) {
+      int fin = i + OPS_POR_LOTE < n ? i + OPS_POR_LOTE : n;
+      t0 = instr_reloj_ns();
+      for (int k = i; k < fin; k++) suma += mapa_ids_buscar(mapa, consultas[k]);
+      medicion_lote(&buscar, instr_reloj_ns() - t0, fin - i);
+    }
+    for (int i = 0; i < n; i += OPS_POR_LOTE) {
+      int fin = i + OPS_POR_LOTE < n ? i + OPS_POR_LOTE : n;
+      t0 = instr_reloj_ns();
+      mapa_ids_buscar_lote(mapa, &consultas[i], fin - i, filas);
+      for (int k = 0; k < fin - i; k++) suma += filas[k];
+      medicion_lote(&lote, instr_reloj_ns() - t0, fin - i);
+    }
+    sumidero += suma;
+    mapa_ids_liberar(mapa);
+  }
+
+  reportar("MapaIds", "construir", n, &construir);
+  reportar("MapaIds", "buscar", n, &buscar);
+  reportar("MapaIds", "buscar lote", n, &lote);
+
+  medicion_liberar(&construir);
+  medicion_liberar(&buscar);
+  medicion_liberar(&lote);
+  bio_free(ids);
+  bio_free(consultas);
+  return true;
+}
+
+// ===== TABLA HASH CONCURRENTE =====
+// Lectores y escritores a la vez: 9 de cada 10 operaciones buscan y 1
+// actualiza la fila de una clave al azar. ns/op es el tiempo de pared
+// entre todas las operaciones de todos los hilos (inversa del throughput
+// agregado); los percentiles son de los lotes de cada hilo
+
+#define OPS_POR_HILO_CONCURRENTE 65536
+
+typedef struct {
+  TablaHashConcurrente *tabla;
+  const int *claves;        // OPS_POR_HILO_CONCURRENTE claves del hilo
+  Medicion medicion;
+  long long suma;
+} HiloHashConcurrente;
+
+static void* hilo_hash_concurrente(void *argumento) {
+  HiloHashConcurrente *hilo = (HiloHashConcurrente *)argumento;
+  long long suma = 0;
+  for (int i = 0; i < OPS_POR_HILO_CONCURRENTE; i += OPS_POR_LOTE) {
+    int fin = i + OPS_POR_LOTE;
+    uint64_t t0 = instr_reloj_ns();
+    for (int k = i; k < fin; k++) {
+      int clave = hilo->claves[k];
+      if (k % 10 == 0) {
+        hash_concurrente_insertar(hilo->tabla, clave, k);
+      } else {
+        suma += hash_concurrente_buscar(hilo->tabla, clave);
+      }
+    }
+    medicion_lote(&hilo->medicion, instr_reloj_ns() - t0, fin - i);
+  }
+  hilo->suma = suma;
+  return NULL;
+}
+
+static bool bench_hash_concurrente(int n) {
+  int max_hilos = opciones.hilos_max;
+  TablaHashConcurrente *tabla = hash_concurrente_crear(0);
+  int *claves = enteros_aleatorios(max_hilos * OPS_POR_HILO_CONCURRENTE, n, 3);
+  HiloHashConcurrente *hilos = (HiloHashConcurrente *)bio_malloc((size_t)max_hilos * sizeof(HiloHashConcurrente));
+  pthread_t *ids = (pthread_t *)bio_malloc((size_t)max_hilos * sizeof(pthread_t));
+  if (!tabla || !claves || !hilos || !ids || !hash_concurrente_reservar(tabla, n)) {
+    hash_concurrente_liberar(tabla);
+    bio_free(claves);
+    bio_free(hilos);
+    bio_free(ids);
+    return false;
+  }
+  for (int i = 0; i < n; i++) hash_concurrente_insertar(tabla, i, i);
+
+  for (int num_hilos = 1; num_hilos <= max_hilos; num_hilos *= 2) {
+    Medicion total;
+    medicion_iniciar(&total);
+    for (int r = 0; r < opciones.repeticiones; r++) {
+      int lanzados = 0;
+      uint64_t t0 = instr_reloj_ns();
+      for (int h = 0; h < num_hilos; h++) {
+        hilos[h].tabla = tabla;
+        hilos[h].claves = claves + (size_t)h * OPS_POR_HILO_CONCURRENTE;
+        medicion_iniciar(&hilos[h].medicion);
+        if (pthread_create(&ids[h], NULL, hilo_hash_concurrente, &hilos[h]) != 0) break;
+        lanzados++;
+      }
+      for (int h = 0; h < lanzados; h++) pthread_join(ids[h], NULL);
+      uint64_t pared = instr_reloj_ns() - t0;
+
+      // Lotes de todos los hilos; el tiempo total es el de pared
+      for (int h = 0; h < lanzados; h++) {
+        medicion_sumar_muestras(&total, &hilos[h].medicion);
+        sumidero += hilos[h].suma;
+        medicion_liberar(&hilos[h].medicion);
+      }
+      total.total_ns += pared;
+    }
+    char operacion[32];
+    snprintf(operacion, sizeof(operacion), "90/10 hilos=%d", num_hilos);
+    reportar("HashConc", operacion, n, &total);
+    medicion_liberar(&total);
+  }
+
+  hash_concurrente_liberar(tabla);
+  bio_free(claves);
+  bio_free(hilos);
+  bio_free(ids);
+  return true;
+}
+
+// ===== HEAP =====
+
+static bool bench_heap_tipo(int n, bool es_min) {
+  int *prioridades = enteros_aleatorios(n, 1 << 30, es_min ? 3 : 4);
+  if (!prioridades) return false;
+  Medicion insertar, extraer, mezcla;
+  medicion_iniciar(&insertar);
+  medicion_iniciar(&extraer);
+  medicion_iniciar(&mezcla);
+
+  for (int r = 0; r < opciones.repeticiones; r++) {
+    Heap *heap = heap_crear(n, es_min);
+    for (int i = 0; i < n; i += OPS_POR_LOTE) {
+      int fin = i + OPS_POR_LOTE < n ? i + OPS_POR_LOTE : n;
+      uint64_t t0 = instr_reloj_ns();
+      for (int k = i; k < fin; k++) heap_insertar(heap, k, prioridades[k], NULL);
+      medicion_lote(&insertar, instr_reloj_ns() - t0, fin - i);
+    }
+    // Régimen estable: extraer el extremo y reinsertar con otra prioridad
+    long long suma = 0;
+    for (int i = 0; i < n; i += OPS_POR_LOTE) {
+      int fin = i + OPS_POR_LOTE < n ? i + OPS_POR_LOTE : n;
+      uint64_t t0 = instr_reloj_ns();
+      for (int k = i; k < fin; k++) {
+        ElementoHeap e = heap_extraer(heap);
+        heap_insertar(heap, e.individuo_id, prioridades[n - 1 - k], NULL);
+        suma += e.prioridad;
+      }
+      medicion_lote(&mezcla, instr_reloj_ns() - t0, 2 * (fin - i));
+    }
+    for (int i = 0; i < n; i += OPS_POR_LOTE) {
+      int fin = i + OPS_POR_LOTE < n ? i + OPS_POR_LOTE : n;
+      uint64_t t0 = instr_reloj_ns();
+      for (int k = i; k < fin; k++) suma += heap_extraer(heap).prioridad;
+      medicion_lote(&extraer, instr_reloj_ns() - t0, fin - i);
+    }
+    sumidero += suma;
+    heap_liberar(heap);
+  }
+
+  const char *nombre = es_min ? "MinHeap" : "MaxHeap";
+  reportar(nombre, "insertar", n, &insertar);
+  reportar(nombre, "extraer+insertar", n, &mezcla);
+  reportar(nombre, "extraer", n, &extraer);
+
+  medicion_liberar(&insertar);
+  medicion_liberar(&extraer);
+  medicion_liberar(&mezcla);
+  bio_free(prioridades);
+  return true;
+}
+
+static bool bench_heap(int n) {
+  return bench_heap_tipo(n, true) && bench_heap_tipo(n, false);
+}
+
+// ===== UNION-FIND =====
+
+static bool bench_union_find(int n) {
+  int *a = enteros_aleatorios(n, n, 5);
+  int *b = enteros_aleatorios(n, n, 6);
+  if (!a || !b) {
+    bio_free(a);
+    bio_free(b);
+    return false;
+  }
+  Medicion unir, buscar;
+  medicion_iniciar(&unir);
+  medicion_iniciar(&buscar);
+
+  for (int r = 0; r < opciones.repeticiones; r++) {
+    UnionFind *uf = union_find_crear(n);
+    long long suma = 0;
+    for (int i = 0; i < n; i += OPS_POR_LOTE) {
+      int fin = i + OPS_POR_LOTE < n ? i + OPS_POR_LOTE : n;
+      uint64_t t0 = instr_reloj_ns();
+      for (int k = i; k < fin; k++) suma += union_find_unir(uf, a[k], b[k]);
+      medicion_lote(&unir, instr_reloj_ns() - t0, fin - i);
+    }
+    for (int i = 0; i < n; i += OPS_POR_LOTE) {
+      int fin = i + OPS_POR_LOTE < n ? i + OPS_POR_LOTE : n;
+      uint64_t t0 = instr_reloj_ns();
+      for (int k = i; k < fin; k++) suma += union_find_buscar(uf, b[k]);
+      medicion_lote(&buscar, instr_reloj_ns() - t0, fin - i);
+    }
+    sumidero += suma;
+    union_find_liberar(uf);
+  }
+
+  reportar("UnionFind", "unir", n, &unir);
+  reportar("UnionFind", "buscar", n, &buscar);
+  medicion_liberar(&unir);
+  medicion_liberar(&buscar);
+  bio_free(a);
+  bio_free(b);
+  return true;
+}
+
+// ===== TRIE =====
+
+static bool bench_trie(int n) {
+  static const char BASES[4] = { 'A', 'C', 'G', 'T' };
+  size_t ancho = LARGO_ADN_BENCH + 1;
+  char *adn = (char *)bio_malloc((size_t)n * ancho);
+  int *orden = permutacion(n, 7);
+  if (!adn || !orden) {
+    bio_free(adn);
+    bio_free(orden);
+    return false;
+  }
+  RngFlujo rng = rng_flujo_crear(opciones.semilla, 8);
+  for (int i = 0; i < n; i++) {
+    char *s = adn + (size_t)i * ancho;
+    for (int j = 0; j < LARGO_ADN_BENCH; j++) s[j] = BASES[rng_entero(&rng, 4)];
+    s[LARGO_ADN_BENCH] = '\0';
+  }
+
+  Medicion insertar, buscar, prefijo;
+  medicion_iniciar(&insertar);
+  medicion_iniciar(&buscar);
+  medicion_iniciar(&prefijo);
+  char consulta[LARGO_PREFIJO_BENCH + 1];
+
+  for (int r = 0; r < opciones.repeticiones; r++) {
+    Trie *trie = trie_crear();
+    for (int i = 0; i < n; i += OPS_POR_LOTE) {
+      int fin = i + OPS_POR_LOTE < n ? i + OPS_POR_LOTE : n;
+      uint64_t t0 = instr_reloj_ns();
+      for (int k = i; k < fin; k++) trie_insertar(trie, adn + (size_t)k * ancho, k);
+      medicion_lote(&insertar, instr_reloj_ns() - t0, fin - i);
+    }
+    long long suma = 0;
+    for (int i = 0; i < n; i += OPS_POR_LOTE) {
+      int fin = i + OPS_POR_LOTE < n ? i + OPS_POR_LOTE : n;
+      uint64_t t0 = instr_reloj_ns();
+      for (int k = i; k < fin; k++) suma += trie_buscar(trie, adn + (size_t)orden[k] * ancho);
+      medicion_lote(&buscar, instr_reloj_ns() - t0, fin - i);
+    }
+    // Prefijos de secuencias existentes (resultado truncado a 50 cepas)
+    int consultas = n < 100000 ? n : 100000;
+    for (int i = 0; i < consultas; i += OPS_POR_LOTE) {
+      int fin = i + OPS_POR_LOTE < consultas ? i + OPS_POR_LOTE : consultas;
+      uint64_t t0 = instr_reloj_ns();
+      for (int k = i; k < fin; k++) {
+        memcpy(consulta, adn + (size_t)orden[k] * ancho, LARGO_PREFIJO_BENCH);
+        consulta[LARGO_PREFIJO_BENCH] = '\0';
+        int cantidad = 0;
+        int *ids = trie_buscar_por_prefijo(trie, consulta, &cantidad);
+        suma += cantidad;
+        bio_free(ids);
+      }
+      medicion_lote(&prefijo, instr_reloj_ns() - t0, fin - i);
+    }
+    sumidero += suma;
+    trie_liberar(trie);
+  }
+
+  reportar("Trie", "insertar", n, &insertar);
+  reportar("Trie", "buscar", n, &buscar);
+  reportar("Trie", "prefijo (10)", n, &prefijo);
+  medicion_liberar(&insertar);
+  medicion_liberar(&buscar);
+  medicion_liberar(&prefijo);
+  bio_free(adn);
+  bio_free(orden);
+  return true;
+}
+
+// ===== ORDENAMIENTOS =====
+// Una muestra por repetición: ns por elemento ordenado
+
+static bool bench_orden(int n) {
+  Poblacion *poblacion = poblacion_crear_sintetica(n);
+  int *original = permutacion(n, 9);
+  int *indices = (int *)bio_malloc((size_t)n * sizeof(int));
+  Arena *arena = arena_crear((size_t)n * sizeof(int) / 2 + 2 * ARENA_ALINEACION);
+  if (!poblacion || !original || !indices || !arena) {
+    if (poblacion) poblacion_liberar(poblacion);
+    bio_free(original);
+    bio_free(indices);
+    if (arena) arena_liberar(arena);
+    return false;
+  }
+  RngFlujo rng = rng_flujo_crear(opciones.semilla, 10);
+  for (int i = 0; i < n; i++) {
+    poblacion->riesgo[i] = rng_entero(&rng, 100);
+    poblacion->tiempo_infeccion[i] = rng_entero(&rng, 1 << 30);
+  }
+
+  static const char *NOMBRES[3] = { "merge_sort", "quick_sort", "heap_sort" };
+  static const CriterioOrdenamiento CRITERIOS[2] = { ORDENAR_POR_RIESGO, ORDENAR_POR_TIEMPO };
+  static const char *NOMBRES_CRITERIO[2] = { "riesgo", "tiempo" };
+
+  for (int c = 0; c < 2; c++) {
+    for (int algoritmo = 0; algoritmo < 3; algoritmo++) {
+      Medicion m;
+      medicion_iniciar(&m);
+      for (int r = 0; r < opciones.repeticiones; r++) {
+        memcpy(indices, original, (size_t)n * sizeof(int));
+        uint64_t t0 = instr_reloj_ns();
+        if (algoritmo == 0) {
+          merge_sort(poblacion, indices, 0, n - 1, CRITERIOS[c], arena);
+        } else if (algoritmo == 1) {
+          quick_sort(poblacion, indices, 0, n - 1, CRITERIOS[c]);
+        } else {
+          heap_sort(poblacion, indices, n, CRITERIOS[c]);
+        }
+        medicion_lote(&m, instr_reloj_ns() - t0, n);
+        arena_reiniciar(arena);
+        sumidero += indices[n / 2];
+      }
+      char operacion[32];
+      snprintf(operacion, sizeof(operacion), "%s %s", NOMBRES[algoritmo], NOMBRES_CRITERIO[c]);
+      reportar("Orden", operacion, n, &m);
+      medicion_liberar(&m);
+    }
+  }
+
+  poblacion_liberar(poblacion);
+  bio_free(original);
+  bio_free(indices);
+  arena_liberar(arena);
+  return true;
+}
+
+// ===== INGESTA =====
+// Población CSV y aristas TSV de n registros (~38 y ~18 bytes por línea:
+// 10^6 son ~40 MB, 10^8 aristas ~2 GB) escritas en un temporal. Se miden
+// con el archivo recién escrito, en la caché de páginas: el parser, no el
+// disco. Una muestra por repetición, ns/op por registro
+
+static FILE* crear_temporal(char *ruta, size_t largo) {
+  const char *directorio = getenv("TMPDIR");
+  snprintf(ruta, largo, "%s/bench_ingesta_XXXXXX", directorio ? directorio : "/tmp");
+  int descriptor = mkstemp(ruta);
+  if (descriptor < 0) return NULL;
+  FILE *archivo = fdopen(descriptor, "w");
+  if (!archivo) {
+    close(descriptor);
+    unlink(ruta);
+    return NULL;
+  }
+  return archivo;
+}
+
+static bool escribir_poblacion_csv(FILE *archivo, int n) {
+  RngFlujo rng = rng_flujo_crear(opciones.semilla, 30);
+  int territorios = n / 1000 + 1;
+  fprintf(archivo, "id,nombre,territorio,riesgo,estado,tiempo_infeccion\n");
+  for (int i = 0; i < n; i++) {
+    int estado = rng_entero(&rng, 3);
+    fprintf(archivo, "%d,Individuo_%d,%d,%d,%d,%d\n", i, i, rng_entero(&rng, territorios),
+            rng_entero(&rng, 101), estado, estado == SANO ? 0 : rng_entero(&rng, 60));
+  }
+  return fflush(archivo) == 0 && !ferror(archivo);
+}
+
+static bool escribir_aristas_tsv(FILE *archivo, int n) {
+  RngFlujo rng = rng_flujo_crear(opciones.semilla, 31);
+  int nodos = n / 8 + 1;
+  fprintf(archivo, "origen\tdestino\tpeso\n");
+  for (int i = 0; i < n; i++) {
+    fprintf(archivo, "%d\t%d\t0.%03d\n", rng_entero(&rng, nodos), rng_entero(&rng, nodos),
+            rng_entero(&rng, 1000));
+  }
+  return fflush(archivo) == 0 && !ferror(archivo);
+}
+
+// Retorna: false si no se pudo escribir o leer el archivo
+static bool medir_ingesta(int n, bool poblacion) {
+  char ruta[256];
+  FILE *archivo = crear_temporal(ruta, sizeof(ruta));
+  if (!archivo) return false;
+  bool escrito = poblacion ? escribir_poblacion_csv(archivo, n) : escribir_aristas_tsv(archivo, n);
+  if (fclose(archivo) != 0) escrito = false;
+
+  Medicion m;
+  medicion_iniciar(&m);
+  bool ok = escrito;
+  for (int r = 0; r < opciones.repeticiones && ok; r++) {
+    EstadisticasIngesta e;
+    if (poblacion) {
+      int num_territorios = 0;
+      Poblacion *leida = ingesta_poblacion(ruta, 0, &num_territorios, &e);
+      ok = leida != NULL;
+      if (leida) poblacion_liberar(leida);
+    } else {
+      GrafoCSR *leido = ingesta_grafo(ruta, 0, 1, &e);
+      ok = leido != NULL;
+      if (leido) grafo_csr_liberar(leido);
+    }
+    if (ok) {
+      medicion_lote(&m, (uint64_t)(e.segundos * 1e9), (int)e.lineas);
+      m.bytes += (uint64_t)e.bytes;
+    }
+  }
+  unlink(ruta);
+
+  if (ok) reportar("Ingesta", poblacion ? "poblacion csv" : "aristas tsv", n, &m);
+  medicion_liberar(&m);
+  return ok;
+}
+
+static bool bench_ingesta(int n) {
+  // Las aristas ocupan menos memoria por registro: siguen aunque la
+  // población ya no quepa
+  bool poblacion = medir_ingesta(n, true);
+  if (!poblacion) fprintf(stderr, "ingesta: poblacion de n=%d omitida (memoria o disco)\n", n);
+  bool aristas = medir_ingesta(n, false);
+  return poblacion || aristas;
+}
+
+// ===== PROGRAMA =====
+
+typedef struct {
+  const char *nombre;
+  bool (*ejecutar)(int n);
+} Benchmark;
+
+static const Benchmark BENCHMARKS[] = {
+  { "hash", bench_hash },
+  { "hash_concurrente", bench_hash_concurrente },
+  { "mapa_ids", bench_mapa_ids },
+  { "heap", bench_heap },
+  { "union_find", bench_union_find },
+  { "trie", bench_trie },
+  { "orden", bench_orden },
+  { "ingesta", bench_ingesta }
+};
+
+static bool leer_argumentos(int argc, char *argv[]) {
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--csv") == 0) {
+      opciones.csv = true;
+      continue;
+    }
+    if (i + 1 >= argc) return false;
+    const char *valor = argv[++i];
+    if (strcmp(argv[i - 1], "--min") == 0) {
+      opciones.min_exponente = atoi(valor);
+    } else if (strcmp(argv[i - 1], "--max") == 0) {
+      opciones.max_exponente = atoi(valor);
+    } else if (strcmp(argv[i - 1], "--repeticiones") == 0) {
+      opciones.repeticiones = atoi(valor);
+    } else if (strcmp(argv[i - 1], "--presupuesto") == 0) {
+      opciones.presupuesto_seg = atof(valor);
+    } else if (strcmp(argv[i - 1], "--solo") == 0) {
+      opciones.solo = valor;
+    } else if (strcmp(argv[i - 1], "--hilos-max") == 0) {
+      opciones.hilos_max = atoi(valor);
+    } else if (strcmp(argv[i - 1], "--semilla") == 0) {
+      opciones.semilla = strtoull(valor, NULL, 10);
+    } else {
+      return false;
+    }
+  }
+  return opciones.min_exponente >= 1 && opciones.max_exponente <= 8 &&
+         opciones.min_exponente <= opciones.max_exponente && opciones.repeticiones >= 1 &&
+         opciones.hilos_max >= 1;
+}
+
+int main(int argc, char *argv[]) {
+  if (!leer_argumentos(argc, argv)) {
+    fprintf(stderr, "Uso: %s [--min N] [--max N] [--repeticiones R] [--presupuesto seg]\n"
+                    "       [--solo hash|hash_concurrente|mapa_ids|heap|union_find|trie|orden|ingesta]\n"
+                    "       [--hilos-max N] [--semilla N] [--csv]\n"
+                    "Tamanos: 10^min .. 10^max (1 <= min <= max <= 8)\n",
+            argv[0]);
+    return 1;
+  }
+
+  if (!opciones.csv) {
+    printf("=== BioSim - Microbenchmarks ===\n");
+    printf("Tamanos: 10^%d .. 10^%d, %d repeticiones, presupuesto %.1f s por tamano\n",
+           opciones.min_exponente, opciones.max_exponente, opciones.repeticiones,
+           opciones.presupuesto_seg);
+#ifdef BIOSIM_INSTRUMENTACION
+    printf("AVISO: compilado con BIOSIM_INSTRUMENTACION; los contadores suman coste "
+           "(make bench INSTRUMENTACION=0)\n");
+#endif
+    printf("\n");
+  }
+  imprimir_cabecera();
+
+  int num_benchmarks = (int)(sizeof(BENCHMARKS) / sizeof(BENCHMARKS[0]));
+  for (int b = 0; b < num_benchmarks; b++) {
+    if (opciones.solo && strcmp(opciones.solo, BENCHMARKS[b].nombre) != 0) continue;
+
+    int n = 1;
+    for (int e = 0; e < opciones.min_exponente; e++) n *= 10;
+    for (int e = opciones.min_exponente; e <= opciones.max_exponente; e++, n *= 10) {
+      uint64_t t0 = instr_reloj_ns();
+      if (!BENCHMARKS[b].ejecutar(n)) {
+        fprintf(stderr, "%s: memoria insuficiente para n=%d\n", BENCHMARKS[b].nombre, n);
+        break;
+      }
+      // Estimación lineal del siguiente tamaño (10x): si excede, parar aquí
+      double segundos = (double)(instr_reloj_ns() - t0) * 1e-9;
+      if (e < opciones.max_exponente && segundos * 10.0 > opciones.presupuesto_seg) {
+        fprintf(stderr, "%s: n=%d tardaria ~%.0f s; tamanos mayores omitidos\n",
+                BENCHMARKS[b].nombre, n * 10, segundos * 10.0);
+        break;
+      }
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,462 @@
+#define _POSIX_C_SOURCE 200809L
+#include "biosim.h"
+#include "memoria.h"
+#include "mundo.h"
+#include "instrumentacion.h"
+#include "pool_tareas.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#define RUTA_NULA "NUL"
+#else
+#include <sys/wait.h>
+#include <unistd.h>
+#define RUTA_NULA "/dev/null"
+#endif
+
+// ============================================================
+// BENCH ESCALADO - Benchmark de extremo a extremo
+// Ejecuta el pipeline completo de generador (biosim_generar +
+// biosim_ejecutar_etapas) sobre un barrido de individuos x territorios x
+// cepas x hilos y escribe un JSON (una línea por punto) con tiempo total,
+// tiempo por etapa, pico de RSS y eventos/s. Con --base compara contra un JSON
+// anterior y termina con código 2 si alguna métrica empeora más que la
+// tolerancia.
+//
+// En POSIX cada punto corre en un proceso hijo (fork) para que el pico de
+// RSS sea el del punto; en Windows corre en el mismo proceso y el pico es
+// acumulado.
+//
+// Uso: bench_escalado [--individuos 1000,10000] [--territorios 20,200]
+//        [--cepas 50] [--hilos 1,0] [--dias N] [--repeticiones R]
+//        [--semilla N] [--json ruta] [--base ruta] [--tolerancia 0.10]
+//        [--umbral-ms 5]
+// ============================================================
+
+#define MAX_VALORES_LISTA 16
+#define MAX_PUNTOS 256
+#define LARGO_LINEA_JSON 4096
+
+typedef enum {
+  ETAPA_GENERACION,
+  ETAPA_ANALISIS_DATOS,
+  ETAPA_DETECCION_BROTES,
+  ETAPA_PROPAGACION_TEMPORAL,
+  ETAPA_EXPOSICION,
+  ETAPA_MINIMIZACION_RIESGO,
+  ETAPA_RUTAS_CRITICAS,
+  ETAPA_CONTENCION_VACUNACION,
+  ETAPA_CLUSTERING_CEPAS,
+  ETAPA_CONSULTAS_RAPIDAS,
+  NUM_ETAPAS
+} Etapa;
+
+static const char *NOMBRES_ETAPAS[NUM_ETAPAS] = {
+  "generacion",
+  "analisis_datos",
+  "deteccion_brotes",
+  "propagacion_temporal",
+  "exposicion",
+  "minimizacion_riesgo",
+  "rutas_criticas",
+  "contencion_vacunacion",
+  "clustering_cepas",
+  "consultas_rapidas"
+};
+
+typedef struct {
+  int individuos;
+  int territorios;
+  int cepas;
+  int hilos;
+} PuntoEscalado;
+
+typedef struct {
+  PuntoEscalado punto;     // hilos ya resuelto (0 -> núcleos disponibles)
+  bool ok;
+  double total_ms;
+  double etapa_ms[NUM_ETAPAS];
+  long long pico_rss_kb;   // -1 = no disponible
+  long long eventos;
+  double eventos_por_seg;
+} ResultadoEscalado;
+
+typedef struct {
+  int valores[MAX_VALORES_LISTA];
+  int cantidad;
+} ListaEnteros;
+
+typedef struct {
+  ListaEnteros individuos;
+  ListaEnteros territorios;
+  ListaEnteros cepas;
+  ListaEnteros hilos;
+  int dias;
+  int repeticiones;
+  uint64_t semilla;
+  const char *ruta_json;
+  const char *ruta_base;
+  double tolerancia;       // Fracción permitida de empeoramiento
+  double umbral_ms;        // Diferencias menores se consideran ruido
+} OpcionesEscalado;
+
+static OpcionesEscalado opciones = {
+  { { 1000, 5000, 10000 }, 3 },
+  { { MUNDO_TERRITORIOS_DEFECTO }, 1 },
+  { { MUNDO_CEPAS_DEFECTO }, 1 },
+  { { 1, 0 }, 2 },
+  60, 3, 12345, "bench_escalado.json", NULL, 0.10, 5.0
+};
+
+// ===== UTILIDADES =====
+
+static double ms_desde(uint64_t inicio_ns) {
+  return (double)(instr_reloj_ns() - inicio_ns) / 1e6;
+}
+
+static bool leer_lista(const char *texto, ListaEnteros *lista) {
+  lista->cantidad = 0;
+  while (*texto) {
+    char *fin;
+    long valor = strtol(texto, &fin, 10);
+    if (fin == texto || valor < 0 || lista->cantidad == MAX_VALORES_LISTA) return false;
+    lista->valores[lista->cantidad++] = (int)valor;
+    texto = *fin == ',' ? fin + 1 : fin;
+    if (*fin != ',' && *fin != '\0') return false;
+  }
+  return lista->cantidad > 0;
+}
+
+// ===== PIPELINE =====
+
+static void ejecutar_pipeline(const PuntoEscalado *punto, ResultadoEscalado *resultado) {
+  memset(resultado, 0, sizeof(ResultadoEscalado));
+  resultado->punto = *punto;
+
+  ConfiguracionMundo config = mundo_configuracion_defecto(opciones.semilla);
+  config.num_individuos = punto->individuos;
+  config.num_territorios = punto->territorios;
+  config.num_cepas = punto->cepas;
+  config.num_conexiones = punto->territorios * MUNDO_CONEXIONES_DEFECTO / MUNDO_TERRITORIOS_DEFECTO;
+  config.num_hilos = punto->hilos;
+  BioSimContexto *ctx = biosim_crear(&config);
+  // Las etapas escriben sus tablas: se descartan durante la medición
+  FILE *nula = fopen(RUTA_NULA, "w");
+  if (!ctx || !nula) {
+    if (nula) fclose(nula);
+    biosim_liberar(ctx);
+    return;
+  }
+  ctx->salida = NULL;
+  ctx->propagacion.dias = opciones.dias;
+  resultado->punto.hilos = ctx->config.num_hilos;
+  // En Windows los puntos comparten proceso: cada uno rehace el pool
+  pool_tareas_global_cerrar();
+  pool_tareas_global_configurar(ctx->config.num_hilos);
+
+  uint64_t inicio_total = instr_reloj_ns();
+  bool generado = biosim_generar(ctx);
+  resultado->etapa_ms[ETAPA_GENERACION] = ms_desde(inicio_total);
+  if (generado) {
+    biosim_ejecutar_etapas(ctx, nula);
+    resultado->total_ms = ms_desde(inicio_total);
+  }
+  fclose(nula);
+  if (!generado) {
+    biosim_liberar(ctx);
+    pool_tareas_global_cerrar();
+    return;
+  }
+
+  for (int i = 0; i < ctx->plan.num_etapas; i++) {
+    for (int e = 0; e < NUM_ETAPAS; e++) {
+      if (strcmp(ctx->plan.etapas[i].nombre, NOMBRES_ETAPAS[e]) == 0) {
+        resultado->etapa_ms[e] = ctx->plan.etapas[i].ms;
+      }
+    }
+  }
+  resultado->eventos = ctx->eventos_propagacion;
+  double segundos_propagacion = resultado->etapa_ms[ETAPA_PROPAGACION_TEMPORAL] / 1e3;
+  resultado->eventos_por_seg = segundos_propagacion > 0 ? resultado->eventos / segundos_propagacion : 0.0;
+  resultado->pico_rss_kb = memoria_pico_rss_kb();
+  resultado->ok = true;
+
+  biosim_liberar(ctx);
+  pool_tareas_global_cerrar();
+}
+
+// Un punto aislado en su propio proceso (POSIX) o en este (Windows)
+static void medir_punto(const PuntoEscalado *punto, ResultadoEscalado *resultado) {
+#ifdef _WIN32
+  ejecutar_pipeline(punto, resultado);
+#else
+  int tubo[2];
+  memset(resultado, 0, sizeof(ResultadoEscalado));
+  resultado->punto = *punto;
+  if (pipe(tubo) != 0) return;
+  fflush(stdout);
+
+  pid_t hijo = fork();
+  if (hijo == 0) {
+    ResultadoEscalado propio;
+    ejecutar_pipeline(punto, &propio);
+    ssize_t escritos = write(tubo[1], &propio, sizeof(propio));
+    _exit(escritos == (ssize_t)sizeof(propio) ? 0 : 1);
+  }
+  close(tubo[1]);
+  if (hijo > 0) {
+    ResultadoEscalado recibido;
+    if (read(tubo[0], &recibido, sizeof(recibido)) == (ssize_t)sizeof(recibido)) {
+      *resultado = recibido;
+    }
+    waitpid(hijo, NULL, 0);
+  }
+  close(tubo[0]);
+#endif
+}
+
+// ===== JSON =====
+// Un punto por línea: la base se lee con un analizador mínimo por línea
+
+static void escribir_punto_json(FILE *archivo, const ResultadoEscalado *r, bool ultimo) {
+  fprintf(archivo, "    {\"individuos\": %d, \"territorios\": %d, \"cepas\": %d, \"hilos\": %d, "
+                   "\"total_ms\": %.3f, \"pico_rss_kb\": %lld, \"eventos\": %lld, "
+                   "\"eventos_por_seg\": %.1f, \"etapas_ms\": {",
+          r->punto.individuos, r->punto.territorios, r->punto.cepas, r->punto.hilos,
+          r->total_ms, r->pico_rss_kb, r->eventos, r->eventos_por_seg);
+  for (int e = 0; e < NUM_ETAPAS; e++) {
+    fprintf(archivo, "%s\"%s\": %.3f", e ? ", " : "", NOMBRES_ETAPAS[e], r->etapa_ms[e]);
+  }
+  fprintf(archivo, "}}%s\n", ultimo ? "" : ",");
+}
+
+static bool escribir_json(const char *ruta, const ResultadoEscalado *resultados, int cantidad) {
+  FILE *archivo = fopen(ruta, "w");
+  if (!archivo) return false;
+  fprintf(archivo, "{\n  \"formato\": \"biosim-escalado\",\n  \"version\": 1,\n");
+  fprintf(archivo, "  \"semilla\": %llu,\n  \"dias\": %d,\n  \"puntos\": [\n",
+          (unsigned long long)opciones.semilla, opciones.dias);
+  int escritos = 0, validos = 0;
+  for (int i = 0; i < cantidad; i++) validos += resultados[i].ok;
+  for (int i = 0; i < cantidad; i++) {
+    if (!resultados[i].ok) continue;
+    escribir_punto_json(archivo, &resultados[i], ++escritos == validos);
+  }
+  fprintf(archivo, "  ]\n}\n");
+  return fclose(archivo) == 0;
+}
+
+static bool leer_campo(const char *linea, const char *clave, double *valor) {
+  char patron[64];
+  snprintf(patron, sizeof(patron), "\"%s\":", clave);
+  const char *p = strstr(linea, patron);
+  if (!p) return false;
+  char *fin;
+  *valor = strtod(p + strlen(patron), &fin);
+  return fin != p + strlen(patron);
+}
+
+static int leer_base(const char *ruta, ResultadoEscalado *base, int capacidad) {
+  FILE *archivo = fopen(ruta, "r");
+  if (!archivo) return -1;
+  char linea[LARGO_LINEA_JSON];
+  int cantidad = 0;
+  while (cantidad < capacidad && fgets(linea, sizeof(linea), archivo)) {
+    double individuos, territorios, cepas, hilos, total, rss = -1, eventos = 0, eps = 0;
+    if (!leer_campo(linea, "individuos", &individuos) ||
+        !leer_campo(linea, "territorios", &territorios) ||
+        !leer_campo(linea, "cepas", &cepas) || !leer_campo(linea, "hilos", &hilos) ||
+        !leer_campo(linea, "total_ms", &total)) {
+      continue;
+    }
+    leer_campo(linea, "pico_rss_kb", &rss);
+    leer_campo(linea, "eventos", &eventos);
+    leer_campo(linea, "eventos_por_seg", &eps);
+
+    ResultadoEscalado *r = &base[cantidad++];
+    memset(r, 0, sizeof(ResultadoEscalado));
+    r->punto.individuos = (int)individuos;
+    r->punto.territorios = (int)territorios;
+    r->punto.cepas = (int)cepas;
+    r->punto.hilos = (int)hilos;
+    r->ok = true;
+    r->total_ms = total;
+    r->pico_rss_kb = (long long)rss;
+    r->eventos = (long long)eventos;
+    r->eventos_por_seg = eps;
+    for (int e = 0; e < NUM_ETAPAS; e++) {
+      leer_campo(linea, NOMBRES_ETAPAS[e], &r->etapa_ms[e]);
+    }
+  }
+  fclose(archivo);
+  return cantidad;
+}
+
+// ===== COMPARACION =====
+
+static bool mismo_punto(const PuntoEscalado *a, const PuntoEscalado *b) {
+  return a->individuos == b->individuos && a->territorios == b->territorios &&
+         a->cepas == b->cepas && a->hilos == b->hilos;
+}
+
+// Mayor es peor; umbral absoluto para no reportar ruido en etapas cortas
+static bool comparar_metrica(const char *nombre, double base, double actual, double umbral) {
+  if (base <= 0) return true;
+  double cambio = (actual - base) / base;
+  bool regresion = cambio > opciones.tolerancia && actual - base > umbral;
+  if (regresion || cambio > opciones.tolerancia) {
+    printf("    %-24s %12.3f %12.3f %+8.1f%%  %s\n", nombre, base, actual, 100.0 * cambio,
+           regresion ? "REGRESION" : "ruido");
+  }
+  return !regresion;
+}
+
+// Retorna el número de puntos con regresión
+static int comparar_con_base(const ResultadoEscalado *resultados, int cantidad,
+                             const ResultadoEscalado *base, int cantidad_base) {
+  int regresiones = 0;
+  printf("\n--- COMPARACION CON BASE %s (tolerancia %.0f%%, umbral %.1f ms) ---\n",
+         opciones.ruta_base, 100.0 * opciones.tolerancia, opciones.umbral_ms);
+  for (int i = 0; i < cantidad; i++) {
+    const ResultadoEscalado *r = &resultados[i];
+    if (!r->ok) continue;
+    const ResultadoEscalado *b = NULL;
+    for (int j = 0; j < cantidad_base && !b; j++) {
+      if (mismo_punto(&r->punto, &base[j].punto)) b = &base[j];
+    }
+    printf("  n=%d T=%d C=%d hilos=%d: ", r->punto.individuos, r->punto.territorios,
+           r->punto.cepas, r->punto.hilos);
+    if (!b) {
+      printf("sin base\n");
+      continue;
+    }
+    printf("total %.3f ms (base %.3f ms)\n", r->total_ms, b->total_ms);
+
+    bool ok = comparar_metrica("total_ms", b->total_ms, r->total_ms, opciones.umbral_ms);
+    for (int e = 0; e < NUM_ETAPAS; e++) {
+      ok = comparar_metrica(NOMBRES_ETAPAS[e], b->etapa_ms[e], r->etapa_ms[e],
+                            opciones.umbral_ms) && ok;
+    }
+    if (b->pico_rss_kb > 0 && r->pico_rss_kb > 0) {
+      ok = comparar_metrica("pico_rss_kb", (double)b->pico_rss_kb, (double)r->pico_rss_kb,
+                            1024.0) && ok;
+    }
+    if (!ok) regresiones++;
+  }
+  return regresiones;
+}
+
+// ===== PROGRAMA =====
+
+static bool leer_argumentos(int argc, char *argv[]) {
+  for (int i = 1; i + 1 < argc; i += 2) {
+    const char *opcion = argv[i];
+    const char *valor = argv[i + 1];
+    bool ok = true;
+    if (strcmp(opcion, "--individuos") == 0) {
+      ok = leer_lista(valor, &opciones.individuos);
+    } else if (strcmp(opcion, "--territorios") == 0) {
+      ok = leer_lista(valor, &opciones.territorios);
+    } else if (strcmp(opcion, "--cepas") == 0) {
+      ok = leer_lista(valor, &opciones.cepas);
+    } else if (strcmp(opcion, "--hilos") == 0) {
+      ok = leer_lista(valor, &opciones.hilos);
+    } else if (strcmp(opcion, "--dias") == 0) {
+      opciones.dias = atoi(valor);
+      ok = opciones.dias > 0;
+    } else if (strcmp(opcion, "--repeticiones") == 0) {
+      opciones.repeticiones = atoi(valor);
+      ok = opciones.repeticiones > 0;
+    } else if (strcmp(opcion, "--semilla") == 0) {
+      opciones.semilla = strtoull(valor, NULL, 10);
+    } else if (strcmp(opcion, "--json") == 0) {
+      opciones.ruta_json = valor;
+    } else if (strcmp(opcion, "--base") == 0) {
+      opciones.ruta_base = valor;
+    } else if (strcmp(opcion, "--tolerancia") == 0) {
+      opciones.tolerancia = atof(valor);
+      ok = opciones.tolerancia >= 0;
+    } else if (strcmp(opcion, "--umbral-ms") == 0) {
+      opciones.umbral_ms = atof(valor);
+    } else {
+      ok = false;
+    }
+    if (!ok) return false;
+  }
+  return argc % 2 == 1;
+}
+
+int main(int argc, char *argv[]) {
+  if (!leer_argumentos(argc, argv)) {
+    fprintf(stderr, "Uso: %s [--individuos 1000,10000] [--territorios 20,200] [--cepas 50]\n"
+                    "       [--hilos 1,0] [--dias N] [--repeticiones R] [--semilla N]\n"
+                    "       [--json ruta] [--base ruta] [--tolerancia 0.10] [--umbral-ms 5]\n"
+                    "Listas separadas por comas; hilos 0 = todos los nucleos\n",
+            argv[0]);
+    return 1;
+  }
+
+  static ResultadoEscalado resultados[MAX_PUNTOS];
+  int cantidad = 0;
+
+  printf("=== BioSim - Benchmark de escalado ===\n");
+  printf("%10s %6s %6s %6s %12s %12s %12s %14s\n",
+         "Individuos", "Terr.", "Cepas", "Hilos", "Total ms", "Pico RSS KB", "Eventos", "Eventos/s");
+  for (int a = 0; a < opciones.individuos.cantidad; a++) {
+    for (int b = 0; b < opciones.territorios.cantidad; b++) {
+      for (int c = 0; c < opciones.cepas.cantidad; c++) {
+        for (int d = 0; d < opciones.hilos.cantidad && cantidad < MAX_PUNTOS; d++) {
+          PuntoEscalado punto = { opciones.individuos.valores[a], opciones.territorios.valores[b],
+                                  opciones.cepas.valores[c], opciones.hilos.valores[d] };
+
+          // Mejor de R repeticiones (menor tiempo total)
+          ResultadoEscalado *mejor = &resultados[cantidad];
+          mejor->ok = false;
+          for (int r = 0; r < opciones.repeticiones; r++) {
+            ResultadoEscalado intento;
+            medir_punto(&punto, &intento);
+            if (intento.ok && (!mejor->ok || intento.total_ms < mejor->total_ms)) *mejor = intento;
+          }
+          if (!mejor->ok) {
+            fprintf(stderr, "ERROR: fallo el punto n=%d T=%d C=%d hilos=%d\n",
+                    punto.individuos, punto.territorios, punto.cepas, punto.hilos);
+            mejor->punto = punto;
+          } else {
+            printf("%10d %6d %6d %6d %12.3f %12lld %12lld %14.1f\n",
+                   mejor->punto.individuos, mejor->punto.territorios, mejor->punto.cepas,
+                   mejor->punto.hilos, mejor->total_ms, mejor->pico_rss_kb, mejor->eventos,
+                   mejor->eventos_por_seg);
+            fflush(stdout);
+          }
+          cantidad++;
+        }
+      }
+    }
+  }
+
+  if (opciones.ruta_json) {
+    if (escribir_json(opciones.ruta_json, resultados, cantidad)) {
+      printf("\nResultados en %s\n", opciones.ruta_json);
+    } else {
+      fprintf(stderr, "ERROR: no se pudo escribir %s\n", opciones.ruta_json);
+    }
+  }
+
+  if (opciones.ruta_base) {
+    static ResultadoEscalado base[MAX_PUNTOS];
+    int cantidad_base = leer_base(opciones.ruta_base, base, MAX_PUNTOS);
+    if (cantidad_base < 0) {
+      fprintf(stderr, "ERROR: no se pudo leer la base %s\n", opciones.ruta_base);
+      return 1;
+    }
+    int regresiones = comparar_con_base(resultados, cantidad, base, cantidad_base);
+    if (regresiones > 0) {
+      printf("\n%d punto(s) con regresion\n", regresiones);
+      return 2;
+    }
+    printf("\nSin regresiones\n");
+  }
+  return 0;
+}
@@ -0,0 +1,321 @@
+#include "biosim.h"
+#include "memoria.h"
+#include "poblacion.h"
+#include "indice_territorios.h"
+#include "grafo_csr.h"
+#include "ingesta.h"
+#include "rng.h"
+#include "instrumentacion.h"
+#include "planificador.h"
+#include "analisis_datos.h"
+#include "deteccion_brotes.h"
+#include "minimizacion_riesgo.h"
+#include "rutas_criticas.h"
+#include "contencion_vacunacion.h"
+#include "clustering_cepas.h"
+#include "consultas_rapidas.h"
+#include <stdarg.h>
+
+// ============================================================
+// IMPLEMENTACION BIOSIM
+// Las etapas del pipeline reciben el contexto como argumento del
+// planificador: nada de estado global entre escenarios
+// ============================================================
+
+// Mensaje de carga en la salida del contexto (si tiene)
+static void informar(const BioSimContexto *ctx, const char *formato, ...) {
+  if (!ctx->salida) return;
+  va_list argumentos;
+  va_start(argumentos, formato);
+  vfprintf(ctx->salida, formato, argumentos);
+  va_end(argumentos);
+}
+
+BioSimContexto* biosim_crear(const ConfiguracionMundo *config) {
+  BioSimContexto *ctx = (BioSimContexto *)bio_calloc(1, sizeof(BioSimContexto));
+  if (!ctx) return NULL;
+  ctx->config = *config;
+  if (!mundo_configuracion_validar(&ctx->config)) {
+    bio_free(ctx);
+    return NULL;
+  }
+  ctx->propagacion.dias = 60;
+  ctx->salida = stdout;
+  return ctx;
+}
+
+// ===== CARGA DEL MUNDO =====
+
+static void reportar_ingesta(const BioSimContexto *ctx, const char *que, const char *ruta,
+                             const EstadisticasIngesta *e) {
+  if (e->linea_error > 0) {
+    fprintf(stderr, "ERROR: %s: linea %lld invalida en %s\n", que, e->linea_error, ruta);
+    return;
+  }
+  informar(ctx, "Ingesta de %s: %lld registros, %.1f MB en %.3f s (%.2f GB/s)\n", que, e->lineas,
+           e->bytes / 1e6, e->segundos, ingesta_gb_por_segundo(e));
+}
+
+bool biosim_ingestar(BioSimContexto *ctx, const char *ruta_poblacion, const char *ruta_grafo) {
+  ConfiguracionMundo *config = &ctx->config;
+  EstadisticasIngesta estadisticas;
+
+  if (ruta_poblacion) {
+    int num_territorios = 0;
+    ctx->poblacion = ingesta_poblacion(ruta_poblacion, config->num_hilos,
+                                       &num_territorios, &estadisticas);
+    reportar_ingesta(ctx, "poblacion", ruta_poblacion, &estadisticas);
+    if (!ctx->poblacion || ctx->poblacion->num_individuos == 0) return false;
+    config->num_individuos = ctx->poblacion->num_individuos;
+    config->num_territorios = num_territorios;
+  }
+
+  if (ruta_grafo) {
+    int minimo = ruta_poblacion ? config->num_territorios : 1;
+    ctx->grafo = ingesta_grafo(ruta_grafo, config->num_hilos, minimo, &estadisticas);
+    reportar_ingesta(ctx, "aristas", ruta_grafo, &estadisticas);
+    if (!ctx->grafo) return false;
+    config->num_territorios = ctx->grafo->num_nodos;
+    config->num_conexiones = ctx->grafo->num_aristas;
+  }
+
+  return mundo_configuracion_validar(config);
+}
+
+bool biosim_generar(BioSimContexto *ctx) {
+  const ConfiguracionMundo *config = &ctx->config;
+
+  ctx->cepas = (Cepa *)bio_malloc((size_t)config->num_cepas * sizeof(Cepa));
+  if (!ctx->cepas) return false;
+  mundo_generar_cepas(config, ctx->cepas);
+  informar(ctx, "Generadas %d cepas.\n", config->num_cepas);
+
+  ctx->territorios = (Territorio *)bio_malloc((size_t)config->num_territorios * sizeof(Territorio));
+  if (!ctx->territorios) return false;
+  mundo_generar_territorios(config, ctx->territorios);
+  informar(ctx, "Generados %d territorios.\n", config->num_territorios);
+
+  if (!ctx->grafo) {
+    INSTR_AMBITO_INICIO(ambito, "generar_grafo");
+    ctx->grafo = mundo_generar_grafo(config);
+    INSTR_AMBITO_FIN(ambito);
+    if (!ctx->grafo) return false;
+    informar(ctx, "Generadas %d conexiones entre territorios.\n", ctx->grafo->num_aristas);
+  }
+
+  // Primero, crear todos los individuos como sanos (bloques en paralelo)
+  bool sintetica = ctx->poblacion == NULL;
+  if (sintetica) {
+    INSTR_AMBITO_INICIO(ambito, "generar_poblacion");
+    ctx->poblacion = mundo_generar_poblacion(config);
+    INSTR_AMBITO_FIN(ambito);
+    if (!ctx->poblacion) return false;
+  }
+
+  // Índice de miembros por territorio: conteo por tramos, sin malloc por individuo
+  ctx->indice = indice_territorios_construir_paralelo(ctx->poblacion, config->num_territorios,
+                                                      config->num_hilos);
+  if (!ctx->indice) return false;
+  for (int t = 0; t < config->num_territorios; t++) {
+    ctx->territorios[t].num_individuos = indice_territorios_tamano(ctx->indice, t);
+  }
+
+  // Los datos ingestados ya traen sus estados
+  if (!sintetica) return true;
+
+  // Infectar Pacientes Cero con RIESGO ALTO (sin repetir)
+  mundo_infectar_pacientes_cero(config, ctx->poblacion);
+  informar(ctx, "Generada poblacion de %d individuos con %d infectados iniciales.\n",
+           config->num_individuos, config->num_pacientes_cero);
+  return true;
+}
+
+bool biosim_cargar_snapshot(BioSimContexto *ctx, const char *ruta) {
+  Snapshot *snapshot = snapshot_cargar(ruta);
+  if (!snapshot) return false;
+
+  ConfiguracionMundo *config = &ctx->config;
+  config->semilla = snapshot->semilla;
+  config->num_individuos = snapshot->poblacion.num_individuos;
+  config->num_territorios = snapshot->num_territorios;
+  config->num_cepas = snapshot->num_cepas;
+  config->num_conexiones = snapshot->grafo.num_aristas;
+
+  ctx->snapshot = snapshot;
+  ctx->cepas = snapshot->cepas;
+  ctx->territorios = snapshot->territorios;
+  ctx->poblacion = &snapshot->poblacion;
+  ctx->indice = &snapshot->indice;
+  ctx->grafo = &snapshot->grafo;
+  informar(ctx, "Snapshot cargado: %d individuos, %d territorios, %d cepas, %d conexiones.\n",
+           config->num_individuos, config->num_territorios, config->num_cepas,
+           config->num_conexiones);
+  return true;
+}
+
+bool biosim_guardar_snapshot(const BioSimContexto *ctx, const char *ruta) {
+  const ConfiguracionMundo *config = &ctx->config;
+  return snapshot_guardar(ruta, config->semilla, ctx->cepas, config->num_cepas,
+                          ctx->territorios, config->num_territorios, ctx->poblacion,
+                          ctx->indice, ctx->grafo);
+}
+
+void biosim_liberar(BioSimContexto *ctx) {
+  if (!ctx) return;
+
+  // Un snapshot es dueño de todas las estructuras: se desmapea completo
+  if (ctx->snapshot) {
+    snapshot_cerrar(ctx->snapshot);
+  } else {
+    grafo_csr_liberar(ctx->grafo);
+    indice_territorios_liberar(ctx->indice);
+    poblacion_liberar(ctx->poblacion);
+    bio_free(ctx->territorios);
+    bio_free(ctx->cepas);
+  }
+  informar(ctx, "Memoria liberada correctamente.\n");
+  bio_free(ctx);
+}
+
+// ===== ETAPAS DEL PIPELINE =====
+// Recursos que cada etapa lee o escribe (ver planificador.h)
+enum {
+  RECURSO_POBLACION = 1 << 0,
+  RECURSO_INDICE = 1 << 1,
+  RECURSO_GRAFO = 1 << 2,
+  RECURSO_CEPAS = 1 << 3,
+  RECURSO_TERRITORIOS = 1 << 4
+};
+
+// ============================================================
+// SUBPROBLEMA 1: ANALISIS DE DATOS
+// ============================================================
+// Demostración de los tres algoritmos de ordenamiento
+// MergeSort O(n log n), QuickSort O(n log n) promedio, HeapSort O(n log n)
+static void etapa_analisis_datos(void *contexto, FILE *salida) {
+  BioSimContexto *ctx = (BioSimContexto *)contexto;
+  test_analisis_datos(ctx->poblacion, salida);
+}
+
+// ============================================================
+// SUBPROBLEMA 2: DETECCION DE BROTES
+// ============================================================
+// Determinar los primeros focos y zonas conectadas
+// BFS O(V+E) vs DFS O(V+E)
+// Usa población INICIAL (10 infectados) para detectar primeros focos
+static void etapa_deteccion_brotes(void *contexto, FILE *salida) {
+  BioSimContexto *ctx = (BioSimContexto *)contexto;
+  test_deteccion_brotes(ctx->indice, ctx->poblacion, ctx->config.semilla, salida);
+}
+
+// ============================================================
+// SUBPROBLEMA 3: PROPAGACION TEMPORAL
+// ============================================================
+// Simulacion temporal de propagacion de infecciones
+// Min-Heap para procesar eventos cronologicamente O(n log n)
+static void etapa_propagacion_temporal(void *contexto, FILE *salida) {
+  BioSimContexto *ctx = (BioSimContexto *)contexto;
+  ctx->eventos_propagacion =
+      test_propagacion_temporal(ctx->indice, ctx->poblacion, ctx->cepas, ctx->config.num_cepas,
+                                &ctx->propagacion, ctx->config.semilla, salida);
+}
+
+// Actualizar poblacion con nuevos infectados generados por propagacion
+// (simulando el resultado real despues de 60 dias)
+static void etapa_exposicion(void *contexto, FILE *salida) {
+  BioSimContexto *ctx = (BioSimContexto *)contexto;
+  Poblacion *poblacion = ctx->poblacion;
+  (void)salida;
+  for (int i = 0; i < ctx->config.num_individuos; i++) {
+    RngFlujo rng = rng_flujo_crear(ctx->config.semilla, RNG_FLUJO(RNG_FLUJO_EXPOSICION, i));
+    // Incrementar riesgo de individuos basado en contacto con infectados
+    if (poblacion->estado[i] == SANO && rng_entero(&rng, 100) < 15) {
+      poblacion->riesgo[i] = 50 + rng_entero(&rng, 50);  // Aumentar riesgo de sanos expuestos
+      poblacion->estado[i] = INFECTADO;  // Simular propagacion
+      poblacion->tiempo_infeccion[i] = 1;
+    }
+  }
+}
+
+// ============================================================
+// SUBPROBLEMA 4: MINIMIZACION DE RIESGO
+// ============================================================
+// Seleccionar individuos a aislar usando enfoque Greedy
+// O(n log n) por ordenamiento
+// Usa población ACTUALIZADA (después de propagación simulada)
+static void etapa_minimizacion_riesgo(void *contexto, FILE *salida) {
+  BioSimContexto *ctx = (BioSimContexto *)contexto;
+  test_minimizacion_riesgo(ctx->poblacion, salida);
+}
+
+// ============================================================
+// SUBPROBLEMA 5: RUTAS CRITICAS
+// ============================================================
+// Encontrar rutas de máxima probabilidad de infección
+// Dijkstra modificado con Max-Heap O((n+m) log n)
+static void etapa_rutas_criticas(void *contexto, FILE *salida) {
+  BioSimContexto *ctx = (BioSimContexto *)contexto;
+  test_rutas_criticas(ctx->grafo, ctx->config.num_territorios, ctx->cepas, ctx->config.num_cepas,
+                      salida);
+}
+
+// ============================================================
+// SUBPROBLEMA 6: CONTENCION (VACUNACION)
+// ============================================================
+// Encontrar árbol de expansión mínima para cobertura de vacunación
+// MST con Kruskal O(m log m) y Prim O(n^2)
+static void etapa_contencion_vacunacion(void *contexto, FILE *salida) {
+  BioSimContexto *ctx = (BioSimContexto *)contexto;
+  test_contencion_vacunacion(ctx->grafo, ctx->config.num_territorios, salida);
+}
+
+// ============================================================
+// SUBPROBLEMA 7: CLUSTERING DE CEPAS
+// ============================================================
+// Agrupar cepas por similitud de nombre usando Trie O(k*L)
+static void etapa_clustering_cepas(void *contexto, FILE *salida) {
+  BioSimContexto *ctx = (BioSimContexto *)contexto;
+  test_clustering_cepas(ctx->cepas, ctx->config.num_cepas, salida);
+}
+
+// ============================================================
+// SUBPROBLEMA 8: CONSULTAS RAPIDAS
+// ============================================================
+// Busquedas eficientes usando Tabla Hash O(1) promedio
+// Registra cambios de estado: escribe la población
+static void etapa_consultas_rapidas(void *contexto, FILE *salida) {
+  BioSimContexto *ctx = (BioSimContexto *)contexto;
+  test_consultas_rapidas(ctx->poblacion, ctx->territorios, ctx->config.num_territorios, salida);
+}
+
+// Plan de los subproblemas: rutas, contención y clustering solo leen el
+// grafo y las cepas, así que corren junto a los que leen la población
+static void planificar_etapas(BioSimContexto *ctx, Planificador *plan) {
+  long long individuos = ctx->config.num_individuos;
+  long long aristas = ctx->grafo->num_aristas;
+
+  planificador_iniciar(plan);
+  planificador_agregar(plan, "analisis_datos", etapa_analisis_datos, ctx,
+                       RECURSO_POBLACION, 0, individuos);
+  planificador_agregar(plan, "deteccion_brotes", etapa_deteccion_brotes, ctx,
+                       RECURSO_POBLACION | RECURSO_INDICE, 0, individuos);
+  planificador_agregar(plan, "propagacion_temporal", etapa_propagacion_temporal, ctx,
+                       RECURSO_POBLACION | RECURSO_INDICE | RECURSO_CEPAS, 0, individuos);
+  planificador_agregar(plan, "exposicion", etapa_exposicion, ctx,
+                       0, RECURSO_POBLACION, individuos);
+  planificador_agregar(plan, "minimizacion_riesgo", etapa_minimizacion_riesgo, ctx,
+                       RECURSO_POBLACION, 0, individuos);
+  planificador_agregar(plan, "rutas_criticas", etapa_rutas_criticas, ctx,
+                       RECURSO_GRAFO | RECURSO_CEPAS, 0, aristas);
+  planificador_agregar(plan, "contencion_vacunacion", etapa_contencion_vacunacion, ctx,
+                       RECURSO_GRAFO, 0, aristas);
+  planificador_agregar(plan, "clustering_cepas", etapa_clustering_cepas, ctx,
+                       RECURSO_CEPAS, 0, ctx->config.num_cepas);
+  planificador_agregar(plan, "consultas_rapidas", etapa_consultas_rapidas, ctx,
+                       RECURSO_TERRITORIOS, RECURSO_POBLACION, individuos);
+}
+
+void biosim_ejecutar_etapas(BioSimContexto *ctx, FILE *salida) {
+  planificar_etapas(ctx, &ctx->plan);
+  planificador_ejecutar(&ctx->plan, ctx->config.num_hilos, salida);
+}
@@ -0,0 +1,101 @@
+#ifndef BIOSIM_H
+#define BIOSIM_H
+
+#include "estructuras.h"
+#include "mundo.h"
+#include "snapshot.h"
+#include "propagacion_temporal.h"
+#include "planificador.h"
+
+// ============================================================
+// BIOSIM - Contexto de un escenario
+// Todo el estado de una simulación (configuración, cepas, territorios,
+// población, índice, grafo y opciones de las etapas) vive en un
+// BioSimContexto: varios escenarios pueden convivir en un mismo proceso
+// y avanzar en hilos distintos sin compartir datos.
+//
+// Uso:
+//   BioSimContexto *ctx = biosim_crear(&config);
+//   biosim_ingestar(ctx, NULL, NULL) && biosim_generar(ctx);   // o biosim_cargar_snapshot
+//   biosim_ejecutar_etapas(ctx, salida);
+//   biosim_liberar(ctx);
+//
+// Son del proceso (y seguros entre hilos) el pool de tareas global, la
+// traza y los contadores de hardware. La instrumentación solo mide los
+// ámbitos del primer hilo que la usa.
+// ============================================================
+
+typedef struct {
+  ConfiguracionMundo config;
+  OpcionesPropagacion propagacion;   // Duración y checkpoints de la simulación temporal
+  FILE *salida;                      // Mensajes de carga (stdout por defecto, NULL = ninguno)
+
+  Cepa *cepas;
+  Territorio *territorios;
+  Poblacion *poblacion;              // Almacén columnar
+  IndiceTerritorios *indice;         // Territorio -> miembros (CSR)
+  GrafoCSR *grafo;                   // Grafo de territorios (CSR)
+  Snapshot *snapshot;                // No NULL si el mundo se cargó desde un snapshot
+
+  // De la última biosim_ejecutar_etapas
+  Planificador plan;                 // Etapas con su duración (EtapaPlan.ms)
+  long long eventos_propagacion;     // Eventos de la simulación temporal
+} BioSimContexto;
+
+/**
+ * Crea un contexto vacío con una copia de la configuración
+ * (propagación: 60 días sin checkpoints)
+ * Complejidad: O(1)
+ * Retorna: BioSimContexto o NULL si la configuración no es válida
+ */
+BioSimContexto* biosim_crear(const ConfiguracionMundo *config);
+
+/**
+ * Carga población y/o aristas reales desde CSV/TSV (rutas NULL = no
+ * ingestar); los tamaños del escenario pasan a ser los de los datos
+ * (territorios = mayor id de territorio o nodo + 1)
+ * Complejidad: O(bytes / hilos)
+ * Retorna: false si un archivo no es válido o la configuración resultante tampoco
+ */
+bool biosim_ingestar(BioSimContexto *ctx, const char *ruta_poblacion, const char *ruta_grafo);
+
+/**
+ * Genera lo que falte del mundo (cepas, territorios y, si no se
+ * ingestaron, grafo y población con sus pacientes cero) y construye el
+ * índice de territorios
+ * Complejidad: O(n + T + C + m) repartido entre config.num_hilos
+ * Retorna: false si no hay memoria para el escenario
+ */
+bool biosim_generar(BioSimContexto *ctx);
+
+/**
+ * Mapea el mundo desde un snapshot: las estructuras apuntan a las
+ * secciones del archivo y la semilla pasa a ser la del snapshot
+ * Complejidad: O(secciones)
+ * Retorna: false si el archivo no es válido
+ */
+bool biosim_cargar_snapshot(BioSimContexto *ctx, const char *ruta);
+
+/**
+ * Escribe el mundo actual en un snapshot
+ * Complejidad: O(tamaño del mundo)
+ * Retorna: true si el archivo quedó completo
+ */
+bool biosim_guardar_snapshot(const BioSimContexto *ctx, const char *ruta);
+
+/**
+ * Ejecuta los subproblemas sobre el mundo del contexto; las etapas
+ * independientes corren a la vez (config.num_hilos == 1: en orden).
+ * Deja en ctx->plan la duración de cada etapa
+ * Complejidad: la de los subproblemas
+ * El reporte se escribe en salida
+ */
+void biosim_ejecutar_etapas(BioSimContexto *ctx, FILE *salida);
+
+/**
+ * Libera el mundo (o cierra el snapshot) y el contexto
+ * Complejidad: O(1) con snapshot, O(T + C) en otro caso
+ */
+void biosim_liberar(BioSimContexto *ctx);
+
+#endif // BIOSIM_H
@@ -1,4 +1,5 @@
 #include "clustering_cepas.h"
+#include "memoria.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -41,11 +42,11 @@ GrupoVariantes* clustering_completo(Cepa *cepas, int num_cepas, int *num_grupos)
     return NULL;
   }
   
-  GrupoVariantes *grupos = (GrupoVariantes *)malloc(num_cepas * sizeof(GrupoVariantes));
+  GrupoVariantes *grupos = (GrupoVariantes *)bio_malloc(num_cepas * sizeof(GrupoVariantes));
   int grupos_idx = 0;
   
   // Array auxiliar para rastrear cepas ya agrupadas
-  bool *procesada = (bool *)malloc(num_cepas * sizeof(bool));
+  bool *procesada = (bool *)bio_malloc(num_cepas * sizeof(bool));
   memset(procesada, false, num_cepas * sizeof(bool));
   
   // Construir trie de todas las cepas - O(k * L)
@@ -57,7 +58,7 @@ GrupoVariantes* clustering_completo(Cepa *cepas, int num_cepas, int *num_grupos)
     
     // Crear un grupo con la cepa actual
     GrupoVariantes grupo;
-    grupo.cepas_grupo = (int *)malloc(num_cepas * sizeof(int));
+    grupo.cepas_grupo = (int *)bio_malloc(num_cepas * sizeof(int));
     grupo.cantidad = 0;
     
     // Buscar todas las cepas con el mismo prefijo de longitud 2
@@ -78,7 +79,7 @@ GrupoVariantes* clustering_completo(Cepa *cepas, int num_cepas, int *num_grupos)
           procesada[cepa_id] = true;
         }
       }
-      free(cepas_prefijo);
+      bio_free(cepas_prefijo);
     }
     
     // Si este grupo no tiene cepas (caso borde), agregar la cepa actual
@@ -95,7 +96,7 @@ GrupoVariantes* clustering_completo(Cepa *cepas, int num_cepas, int *num_grupos)
   
   // Liberar trie y array auxiliar
   trie_liberar(trie);
-  free(procesada);
+  bio_free(procesada);
   
   *num_grupos = grupos_idx;
   return grupos;
@@ -106,28 +107,28 @@ void clustering_liberar(GrupoVariantes *grupos, int num_grupos) {
   
   for (int i = 0; i < num_grupos; i++) {
     if (grupos[i].cepas_grupo) {
-      free(grupos[i].cepas_grupo);
+      bio_free(grupos[i].cepas_grupo);
     }
   }
-  free(grupos);
+  bio_free(grupos);
 }
 
 // ============================================================
 // FUNCION DE PRUEBA: Test del algoritmo de Clustering
 // ============================================================
 
-void test_clustering_cepas(Cepa *cepas, int num_cepas) {
+void test_clustering_cepas(Cepa *cepas, int num_cepas, FILE *salida) {
   if (!cepas || num_cepas <= 0) {
-    printf("ERROR: Cepas invalidas\n");
+    fprintf(salida, "ERROR: Cepas invalidas\n");
     return;
   }
   
-  printf("\n========== SUBPROBLEMA 7: CLUSTERING DE CEPAS ==========\n");
-  printf("Cepas disponibles: %d\n", num_cepas);
-  printf("Algoritmo: Trie para busqueda de prefijos comunes\n\n");
+  fprintf(salida, "\n========== SUBPROBLEMA 7: CLUSTERING DE CEPAS ==========\n");
+  fprintf(salida, "Cepas disponibles: %d\n", num_cepas);
+  fprintf(salida, "Algoritmo: Trie para busqueda de prefijos comunes\n\n");
   
   // Prueba 1: Clustering por prefijo especifico
-  printf("--- PRUEBA 1: Clustering por prefijos especificos ---\n");
+  fprintf(salida, "--- PRUEBA 1: Clustering por prefijos especificos ---\n");
   
   Trie *trie = construir_trie_cepas(cepas, num_cepas);
   
@@ -137,58 +138,58 @@ void test_clustering_cepas(Cepa *cepas, int num_cepas) {
   for (int i = 0; i < num_prefijos; i++) {
     GrupoVariantes grupo = clustering_por_prefijo(trie, prefijos_prueba[i], cepas);
     
-    printf("Prefijo '%s': %d cepas encontradas\n", prefijos_prueba[i], grupo.cantidad);
+    fprintf(salida, "Prefijo '%s': %d cepas encontradas\n", prefijos_prueba[i], grupo.cantidad);
     if (grupo.cantidad > 0 && grupo.cantidad <= 5) {
-      printf("  Cepas: ");
+      fprintf(salida, "  Cepas: ");
       for (int j = 0; j < grupo.cantidad; j++) {
-        printf("%s ", cepas[grupo.cepas_grupo[j]].nombre_adn);
+        fprintf(salida, "%s ", cepas[grupo.cepas_grupo[j]].nombre_adn);
       }
-      printf("\n");
+      fprintf(salida, "\n");
     } else if (grupo.cantidad > 5) {
-      printf("  (primeras 5) ");
+      fprintf(salida, "  (primeras 5) ");
       for (int j = 0; j < 5; j++) {
-        printf("%s ", cepas[grupo.cepas_grupo[j]].nombre_adn);
+        fprintf(salida, "%s ", cepas[grupo.cepas_grupo[j]].nombre_adn);
       }
-      printf("...\n");
+      fprintf(salida, "...\n");
     }
     
-    if (grupo.cepas_grupo) free(grupo.cepas_grupo);
+    if (grupo.cepas_grupo) bio_free(grupo.cepas_grupo);
   }
   
   // Prueba 2: Clustering completo
-  printf("\n--- PRUEBA 2: Clustering completo por prefijos de 2 caracteres ---\n");
+  fprintf(salida, "\n--- PRUEBA 2: Clustering completo por prefijos de 2 caracteres ---\n");
   
   int num_grupos = 0;
   GrupoVariantes *grupos = clustering_completo(cepas, num_cepas, &num_grupos);
   
-  printf("Grupos identificados: %d\n\n", num_grupos);
+  fprintf(salida, "Grupos identificados: %d\n\n", num_grupos);
   
   // Mostrar estadisticas de grupos
-  printf("Grupo | Prefijo | Cantidad | Cepas en grupo\n");
-  printf("------+---------+----------+----------------\n");
+  fprintf(salida, "Grupo | Prefijo | Cantidad | Cepas en grupo\n");
+  fprintf(salida, "------+---------+----------+----------------\n");
   
   for (int i = 0; i < num_grupos && i < 10; i++) {
-    printf("%3d   | %6s  | %8d | ", i, grupos[i].prefijo_comun, grupos[i].cantidad);
+    fprintf(salida, "%3d   | %6s  | %8d | ", i, grupos[i].prefijo_comun, grupos[i].cantidad);
     
     if (grupos[i].cantidad <= 3) {
       for (int j = 0; j < grupos[i].cantidad; j++) {
-        printf("%s ", cepas[grupos[i].cepas_grupo[j]].nombre_adn);
+        fprintf(salida, "%s ", cepas[grupos[i].cepas_grupo[j]].nombre_adn);
       }
     } else {
       for (int j = 0; j < 2; j++) {
-        printf("%s ", cepas[grupos[i].cepas_grupo[j]].nombre_adn);
+        fprintf(salida, "%s ", cepas[grupos[i].cepas_grupo[j]].nombre_adn);
       }
-      printf("...");
+      fprintf(salida, "...");
     }
-    printf("\n");
+    fprintf(salida, "\n");
   }
   
   if (num_grupos > 10) {
-    printf("... y %d grupos mas\n", num_grupos - 10);
+    fprintf(salida, "... y %d grupos mas\n", num_grupos - 10);
   }
   
   // Estadisticas generales
-  printf("\n--- ESTADISTICAS DE CLUSTERING ---\n");
+  fprintf(salida, "\n--- ESTADISTICAS DE CLUSTERING ---\n");
   
   int cepas_agrupadas = 0;
   int grupo_mas_grande = 0;
@@ -207,18 +208,18 @@ void test_clustering_cepas(Cepa *cepas, int num_cepas) {
   
   promedio_grupo = (float)cepas_agrupadas / num_grupos;
   
-  printf("Total cepas procesadas: %d\n", cepas_agrupadas);
-  printf("Grupo mas grande: %d cepas\n", grupo_mas_grande);
-  printf("Grupo mas pequeno: %d cepas\n", grupo_mas_pequeno);
-  printf("Promedio por grupo: %.2f cepas\n", promedio_grupo);
-  printf("Fragmentacion: %.1f%% (1 - grupos/cepas)\n", 
-         (1.0 - (float)num_grupos / num_cepas) * 100);
+  fprintf(salida, "Total cepas procesadas: %d\n", cepas_agrupadas);
+  fprintf(salida, "Grupo mas grande: %d cepas\n", grupo_mas_grande);
+  fprintf(salida, "Grupo mas pequeno: %d cepas\n", grupo_mas_pequeno);
+  fprintf(salida, "Promedio por grupo: %.2f cepas\n", promedio_grupo);
+  fprintf(salida, "Fragmentacion: %.1f%% (1 - grupos/cepas)\n", 
+          (1.0 - (float)num_grupos / num_cepas) * 100);
   
-  printf("\nComplejidad Trie-insertar: O(k * L) = O(%d * 20)\n", num_cepas);
-  printf("Complejidad busqueda-prefijo: O(L + M) = O(2 + M)\n");
-  printf("Complejidad clustering-completo: O(k * L * log k)\n\n");
+  fprintf(salida, "\nComplejidad Trie-insertar: O(k * L) = O(%d * 20)\n", num_cepas);
+  fprintf(salida, "Complejidad busqueda-prefijo: O(L + M) = O(2 + M)\n");
+  fprintf(salida, "Complejidad clustering-completo: O(k * L * log k)\n\n");
   
-  printf("===== FIN PRUEBAS SUBPROBLEMA 7 =====\n\n");
+  fprintf(salida, "===== FIN PRUEBAS SUBPROBLEMA 7 =====\n\n");
   
   // Liberar memoria
   trie_liberar(trie);
@@ -46,7 +46,8 @@ void clustering_liberar(GrupoVariantes *grupos, int num_grupos);
 /**
  * Funcion de prueba para Subproblema 7
  * Demuestra clustering por prefijos y estadisticas
+ * El reporte se escribe en salida (stdout o el buffer de la etapa)
  */
-void test_clustering_cepas(Cepa *cepas, int num_cepas);
+void test_clustering_cepas(Cepa *cepas, int num_cepas, FILE *salida);
 
 #endif // CLUSTERING_CEPAS_H
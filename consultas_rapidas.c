@@ -1,4 +1,7 @@
 #include "consultas_rapidas.h"
+#include "memoria.h"
+#include "poblacion.h"
+#include "instrumentacion.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -9,115 +12,100 @@
 // Busquedas con Tabla Hash - O(1) promedio
 // ============================================================
 
-// Estructura auxiliar para rastrear historial de cambios
-typedef struct {
-  time_t timestamp;
-  EstadoSalud estado_anterior;
-  EstadoSalud estado_nuevo;
-} CambioEstado;
-
-// Array global para rastrear historial (simplificado para la demostración)
-typedef struct {
-  int individuo_id;
-  CambioEstado *cambios;
-  int num_cambios;
-  int capacidad;
-} HistorialIndividuo;
-
-// Tabla auxiliar de historiales (en producción, sería persistente)
-HistorialIndividuo *historiales_globales = NULL;
-int num_historiales = 0;
-
-TablaHash* construir_hash_individuos(Individuo *poblacion, int num_individuos) {
-  TablaHash *tabla = hash_table_crear();
-  
-  // Inicializar tabla de historiales
-  historiales_globales = (HistorialIndividuo *)malloc(num_individuos * sizeof(HistorialIndividuo));
-  num_historiales = num_individuos;
-  
-  for (int i = 0; i < num_individuos; i++) {
-    hash_table_insertar(tabla, poblacion[i].id, &poblacion[i]);
-    
-    // Inicializar historial para cada individuo
-    historiales_globales[i].individuo_id = poblacion[i].id;
-    historiales_globales[i].cambios = (CambioEstado *)malloc(100 * sizeof(CambioEstado));
-    historiales_globales[i].num_cambios = 0;
-    historiales_globales[i].capacidad = 100;
+BaseConsultas* construir_base_consultas(Poblacion *poblacion) {
+  int num_individuos = poblacion->num_individuos;
+  BaseConsultas *base = (BaseConsultas *)bio_malloc(sizeof(BaseConsultas));
+  if (!base) return NULL;
+  // Arreglo directo para el tramo denso de IDs, hash para el resto
+  base->ids = mapa_ids_construir(poblacion->id, num_individuos);
+  base->indices = indices_poblacion_construir(poblacion);
+  // Historial: un registro de eventos global, vacío hasta el primer cambio
+  base->eventos = registro_eventos_crear(num_individuos);
+  if (!base->ids || !base->indices || !base->eventos) {
+    mapa_ids_liberar(base->ids);
+    indices_poblacion_liberar(base->indices);
+    registro_eventos_liberar(base->eventos);
+    bio_free(base);
+    return NULL;
   }
+  for (int c = 0; c < CONSULTAS_CERROJOS; c++) pthread_mutex_init(&base->cerrojos[c], NULL);
   
-  return tabla;
+  return base;
 }
 
-Individuo* consulta_rapida_por_id(TablaHash *tabla, int individuo_id) {
-  return hash_table_buscar(tabla, individuo_id);
+int consulta_rapida_por_id(BaseConsultas *base, int individuo_id) {
+  return mapa_ids_buscar(base->ids, individuo_id);
 }
 
-void registrar_cambio_estado(TablaHash *tabla, int individuo_id, EstadoSalud nuevo_estado) {
-  Individuo *ind = hash_table_buscar(tabla, individuo_id);
-  if (!ind) return;
-  
-  // Registrar cambio en historial
-  for (int i = 0; i < num_historiales; i++) {
-    if (historiales_globales[i].individuo_id == individuo_id) {
-      if (historiales_globales[i].num_cambios < historiales_globales[i].capacidad) {
-        CambioEstado cambio;
-        cambio.timestamp = time(NULL);
-        cambio.estado_anterior = ind->estado;
-        cambio.estado_nuevo = nuevo_estado;
-        
-        historiales_globales[i].cambios[historiales_globales[i].num_cambios++] = cambio;
-      }
-      break;
-    }
-  }
+void consulta_rapida_lote(BaseConsultas *base, const int *individuo_ids, int n, int *filas) {
+  mapa_ids_buscar_lote(base->ids, individuo_ids, n, filas);
+}
+
+int consulta_filtrada(BaseConsultas *base, const Poblacion *poblacion, const FiltroPoblacion *filtro,
+                      int *filas, int max_filas) {
+  return indices_poblacion_consultar(base->indices, poblacion, filtro, filas, max_filas);
+}
+
+void registrar_cambio_estado(BaseConsultas *base, Poblacion *poblacion, int individuo_id, EstadoSalud nuevo_estado) {
+  int fila = mapa_ids_buscar(base->ids, individuo_id);
+  if (fila < 0) return;
+  pthread_mutex_t *cerrojo = &base->cerrojos[fila % CONSULTAS_CERROJOS];
+  pthread_mutex_lock(cerrojo);
   
-  // Actualizar estado
-  ind->estado = nuevo_estado;
-  if (nuevo_estado == INFECTADO && ind->tiempo_infeccion == 0) {
-    ind->tiempo_infeccion = 1;
+  // Actualizar estado (columnas e índices secundarios juntos)
+  EstadoSalud estado_anterior = poblacion->estado[fila];
+  int tiempo = poblacion->tiempo_infeccion[fila];
+  if (nuevo_estado == INFECTADO && tiempo == 0) {
+    tiempo = 1;
   } else if (nuevo_estado == RECUPERADO) {
-    ind->tiempo_infeccion = 0;
+    tiempo = 0;
+  }
+  if (!indices_poblacion_fijar(base->indices, poblacion, fila, nuevo_estado, tiempo)) {
+    pthread_mutex_unlock(cerrojo);
+    return;
   }
+  
+  // Registrar cambio al final del registro de eventos
+  registro_eventos_agregar(base->eventos, fila, individuo_id, time(NULL), estado_anterior, nuevo_estado);
+  pthread_mutex_unlock(cerrojo);
 }
 
-RegistroHistorial obtener_historial_paciente(TablaHash *tabla, int individuo_id) {
+RegistroHistorial obtener_historial_paciente(BaseConsultas *base, int individuo_id) {
   RegistroHistorial historial;
   historial.individuo_id = individuo_id;
   historial.cambios_registrados = 0;
   memset(historial.historial, 0, sizeof(historial.historial));
   
-  // Buscar en la tabla de historiales globales
-  for (int i = 0; i < num_historiales; i++) {
-    if (historiales_globales[i].individuo_id == individuo_id) {
-      historial.cambios_registrados = historiales_globales[i].num_cambios;
-      
-      // Construir string de historial
-      char *ptr = historial.historial;
-      int espacio_restante = sizeof(historial.historial);
-      
-      for (int j = 0; j < historiales_globales[i].num_cambios && j < 10; j++) {
-        const char *estado_ant = "";
-        const char *estado_nuevo = "";
-        
-        switch (historiales_globales[i].cambios[j].estado_anterior) {
-          case SANO: estado_ant = "SANO"; break;
-          case INFECTADO: estado_ant = "INFECTADO"; break;
-          case RECUPERADO: estado_ant = "RECUPERADO"; break;
-        }
-        
-        switch (historiales_globales[i].cambios[j].estado_nuevo) {
-          case SANO: estado_nuevo = "SANO"; break;
-          case INFECTADO: estado_nuevo = "INFECTADO"; break;
-          case RECUPERADO: estado_nuevo = "RECUPERADO"; break;
-        }
-        
-        int len = snprintf(ptr, espacio_restante, "%s -> %s | ", estado_ant, estado_nuevo);
-        if (len > 0 && len < espacio_restante) {
-          ptr += len;
-          espacio_restante -= len;
-        }
-      }
-      break;
+  // Los eventos de la fila están encadenados en el registro: O(k)
+  int fila = mapa_ids_buscar(base->ids, individuo_id);
+  if (fila < 0) return historial;
+  CambioEstado cambios[10];
+  historial.cambios_registrados = registro_eventos_historial(base->eventos, fila, cambios, 10);
+  
+  // Construir string de historial
+  char *ptr = historial.historial;
+  int espacio_restante = sizeof(historial.historial);
+  
+  for (int j = 0; j < historial.cambios_registrados && j < 10; j++) {
+    const char *estado_ant = "";
+    const char *estado_nuevo = "";
+    
+    switch (cambios[j].estado_anterior) {
+      case SANO: estado_ant = "SANO"; break;
+      case INFECTADO: estado_ant = "INFECTADO"; break;
+      case RECUPERADO: estado_ant = "RECUPERADO"; break;
+    }
+    
+    switch (cambios[j].estado_nuevo) {
+      case SANO: estado_nuevo = "SANO"; break;
+      case INFECTADO: estado_nuevo = "INFECTADO"; break;
+      case RECUPERADO: estado_nuevo = "RECUPERADO"; break;
+    }
+    
+    int len = snprintf(ptr, espacio_restante, "%s -> %s | ", estado_ant, estado_nuevo);
+    if (len > 0 && len < espacio_restante) {
+      ptr += len;
+      espacio_restante -= len;
     }
   }
   
@@ -132,88 +120,96 @@ void historial_liberar(RegistroHistorial *historial) {
 // FUNCIONES AUXILIARES PARA LIMPIAR MEMORIA
 // ============================================================
 
-void liberar_historiales() {
-  if (historiales_globales) {
-    for (int i = 0; i < num_historiales; i++) {
-      if (historiales_globales[i].cambios) {
-        free(historiales_globales[i].cambios);
-      }
-    }
-    free(historiales_globales);
-    historiales_globales = NULL;
-  }
+void base_consultas_liberar(BaseConsultas *base) {
+  if (!base) return;
+  registro_eventos_liberar(base->eventos);
+  for (int c = 0; c < CONSULTAS_CERROJOS; c++) pthread_mutex_destroy(&base->cerrojos[c]);
+  mapa_ids_liberar(base->ids);
+  indices_poblacion_liberar(base->indices);
+  bio_free(base);
 }
 
 // ============================================================
 // FUNCION DE PRUEBA: Test de Consultas Rapidas
 // ============================================================
 
-void test_consultas_rapidas(Individuo *poblacion, int num_individuos, 
-                            Territorio *territorios, int num_territorios) {
-  if (!poblacion || num_individuos <= 0) {
-    printf("ERROR: Poblacion invalida\n");
+void test_consultas_rapidas(Poblacion *poblacion,
+                            Territorio *territorios, int num_territorios,
+                            FILE *salida) {
+  if (!poblacion || poblacion->num_individuos <= 0) {
+    fprintf(salida, "ERROR: Poblacion invalida\n");
     return;
   }
   
-  printf("\n========== SUBPROBLEMA 8: CONSULTAS RAPIDAS ==========\n");
-  printf("Individuos en base de datos: %d\n", num_individuos);
-  printf("Territorios: %d\n", num_territorios);
-  printf("Algoritmo: Tabla Hash - O(1) promedio\n\n");
+  int num_individuos = poblacion->num_individuos;
+  char nombre[MAX_NOMBRE]; // Buffer para nombres sintéticos
   
-  // Construir tabla hash de individuos
-  printf("--- CONSTRUCCION DE TABLA HASH ---\n");
-  clock_t inicio = clock();
-  TablaHash *tabla = construir_hash_individuos(poblacion, num_individuos);
-  clock_t fin = clock();
+  fprintf(salida, "\n========== SUBPROBLEMA 8: CONSULTAS RAPIDAS ==========\n");
+  fprintf(salida, "Individuos en base de datos: %d\n", num_individuos);
+  fprintf(salida, "Territorios: %d\n", num_territorios);
+  fprintf(salida, "Algoritmo: Tabla Hash - O(1) promedio\n\n");
   
-  double tiempo_construccion = (double)(fin - inicio) / CLOCKS_PER_SEC * 1000;
-  printf("Tabla hash creada y poblada\n");
-  printf("Tiempo de construccion: %.3f ms\n", tiempo_construccion);
-  printf("Tamanio esperado: %d elementos\n\n", num_individuos);
+  // Construir indice de individuos
+  fprintf(salida, "--- CONSTRUCCION DE TABLA HASH ---\n");
+  uint64_t inicio = instr_reloj_ns();
+  BaseConsultas *base = construir_base_consultas(poblacion);
+  uint64_t fin = instr_reloj_ns();
+  if (!base) {
+    fprintf(salida, "ERROR: No se pudo asignar memoria para la base de consultas\n");
+    return;
+  }
+
+  double tiempo_construccion = (double)(fin - inicio) / 1e6;
+  fprintf(salida, "Tabla hash creada y poblada\n");
+  fprintf(salida, "Tiempo de construccion: %.3f ms\n", tiempo_construccion);
+  fprintf(salida, "Tamanio esperado: %d elementos\n\n", num_individuos);
   
   // Prueba 1: Consultas rapidas por ID
-  printf("--- PRUEBA 1: Consultas rapidas por ID ---\n");
+  fprintf(salida, "--- PRUEBA 1: Consultas rapidas por ID ---\n");
   
   int ids_consultar[] = {5, 42, 100, 250, 500, 750, 999};
   int num_consultas = 7;
+  int filas_consultar[7];
   
-  printf("Consultando %d individuos aleatorios:\n", num_consultas);
-  inicio = clock();
+  fprintf(salida, "Consultando %d individuos aleatorios:\n", num_consultas);
+  inicio = instr_reloj_ns();
   
+  // Todas las filas de una vez: las búsquedas se solapan
+  consulta_rapida_lote(base, ids_consultar, num_consultas, filas_consultar);
   for (int i = 0; i < num_consultas; i++) {
-    int id = ids_consultar[i];
-    Individuo *ind = consulta_rapida_por_id(tabla, id);
+    int fila = filas_consultar[i];
     
-    if (ind) {
-      printf("  ID %d: %s (T%d, Estado: ", ind->id, ind->nombre, ind->territorio_id);
-      switch (ind->estado) {
-        case SANO: printf("SANO"); break;
-        case INFECTADO: printf("INFECTADO"); break;
-        case RECUPERADO: printf("RECUPERADO"); break;
+    if (fila >= 0) {
+      fprintf(salida, "  ID %d: %s (T%d, Estado: ", poblacion->id[fila],
+              poblacion_nombre(poblacion, fila, nombre), poblacion->territorio_id[fila]);
+      switch (poblacion->estado[fila]) {
+        case SANO: fprintf(salida, "SANO"); break;
+        case INFECTADO: fprintf(salida, "INFECTADO"); break;
+        case RECUPERADO: fprintf(salida, "RECUPERADO"); break;
       }
-      printf(", Riesgo: %d)\n", ind->riesgo);
+      fprintf(salida, ", Riesgo: %d)\n", poblacion->riesgo[fila]);
     }
   }
   
-  fin = clock();
-  double tiempo_consultas = (double)(fin - inicio) / CLOCKS_PER_SEC * 1000;
-  printf("Tiempo de %d consultas: %.3f ms\n", num_consultas, tiempo_consultas);
-  printf("Tiempo promedio por consulta: %.6f ms\n\n", tiempo_consultas / num_consultas);
+  fin = instr_reloj_ns();
+  double tiempo_consultas = (double)(fin - inicio) / 1e6;
+  fprintf(salida, "Tiempo de %d consultas: %.3f ms\n", num_consultas, tiempo_consultas);
+  fprintf(salida, "Tiempo promedio por consulta: %.6f ms\n\n", tiempo_consultas / num_consultas);
   
   // Prueba 2: Registrar cambios de estado
-  printf("--- PRUEBA 2: Registrar cambios de estado ---\n");
+  fprintf(salida, "--- PRUEBA 2: Registrar cambios de estado ---\n");
   
   int ids_cambio[] = {10, 50, 150, 300};
   EstadoSalud estados_nuevo[] = {INFECTADO, RECUPERADO, INFECTADO, RECUPERADO};
   
-  printf("Registrando cambios de estado para %d individuos:\n", 4);
-  inicio = clock();
+  fprintf(salida, "Registrando cambios de estado para %d individuos:\n", 4);
+  inicio = instr_reloj_ns();
   
   for (int i = 0; i < 4; i++) {
-    Individuo *ind = consulta_rapida_por_id(tabla, ids_cambio[i]);
-    if (ind) {
-      EstadoSalud estado_ant = ind->estado;
-      registrar_cambio_estado(tabla, ids_cambio[i], estados_nuevo[i]);
+    int fila = consulta_rapida_por_id(base, ids_cambio[i]);
+    if (fila >= 0) {
+      EstadoSalud estado_ant = poblacion->estado[fila];
+      registrar_cambio_estado(base, poblacion, ids_cambio[i], estados_nuevo[i]);
       
       const char *estado_ant_str = "";
       const char *estado_nuevo_str = "";
@@ -230,58 +226,108 @@ void test_consultas_rapidas(Individuo *poblacion, int num_individuos,
         case RECUPERADO: estado_nuevo_str = "RECUPERADO"; break;
       }
       
-      printf("  ID %d: %s -> %s\n", ids_cambio[i], estado_ant_str, estado_nuevo_str);
+      fprintf(salida, "  ID %d: %s -> %s\n", ids_cambio[i], estado_ant_str, estado_nuevo_str);
     }
   }
   
-  fin = clock();
-  double tiempo_cambios = (double)(fin - inicio) / CLOCKS_PER_SEC * 1000;
-  printf("Tiempo de %d cambios: %.3f ms\n\n", 4, tiempo_cambios);
+  fin = instr_reloj_ns();
+  double tiempo_cambios = (double)(fin - inicio) / 1e6;
+  fprintf(salida, "Tiempo de %d cambios: %.3f ms\n\n", 4, tiempo_cambios);
   
   // Prueba 3: Obtener historial de cambios
-  printf("--- PRUEBA 3: Obtener historial de cambios ---\n");
+  fprintf(salida, "--- PRUEBA 3: Obtener historial de cambios ---\n");
   
   for (int i = 0; i < 4; i++) {
-    RegistroHistorial hist = obtener_historial_paciente(tabla, ids_cambio[i]);
-    printf("ID %d: %d cambios registrados\n", hist.individuo_id, hist.cambios_registrados);
+    RegistroHistorial hist = obtener_historial_paciente(base, ids_cambio[i]);
+    fprintf(salida, "ID %d: %d cambios registrados\n", hist.individuo_id, hist.cambios_registrados);
     if (hist.cambios_registrados > 0) {
-      printf("  Historial: %s\n", hist.historial);
+      fprintf(salida, "  Historial: %s\n", hist.historial);
+    }
+  }
+  
+  // Prueba 4: Consultas filtradas con los índices secundarios
+  fprintf(salida, "\n--- PRUEBA 4: Consultas filtradas (indices secundarios) ---\n");
+  
+  int territorio_consulta = num_territorios > 7 ? 7 : 0;
+  FiltroPoblacion filtros[3];
+  const char *descripciones[3];
+  filtros[0] = filtro_poblacion_todos();
+  filtros[0].territorio = territorio_consulta;
+  filtros[0].estado = INFECTADO;
+  filtros[0].riesgo_minimo = 81;
+  descripciones[0] = "Infectados del territorio con riesgo > 80";
+  filtros[1] = filtro_poblacion_todos();
+  filtros[1].estado = SANO;
+  filtros[1].riesgo_minimo = 40;
+  descripciones[1] = "Sanos con riesgo >= 40";
+  filtros[2] = filtro_poblacion_todos();
+  filtros[2].territorio = territorio_consulta;
+  filtros[2].tiempo_minimo = 1;
+  filtros[2].tiempo_maximo = 3;
+  descripciones[2] = "Del territorio con 1 a 3 dias de infeccion";
+  
+  fprintf(salida, "Territorio consultado: T%d\n", territorio_consulta);
+  for (int q = 0; q < 3; q++) {
+    int filas_filtro[5];
+    inicio = instr_reloj_ns();
+    int encontrados = consulta_filtrada(base, poblacion, &filtros[q], filas_filtro, 5);
+    fin = instr_reloj_ns();
+    
+    // Verificacion contra un recorrido completo
+    int esperados = 0;
+    for (int i = 0; i < num_individuos; i++) {
+      if (filtro_poblacion_cumple(&filtros[q], poblacion, i)) esperados++;
+    }
+    fprintf(salida, "  %s: %d (recorrido completo: %d, %.3f ms)\n", descripciones[q], encontrados,
+            esperados, (double)(fin - inicio) / 1e6);
+    if (encontrados > 0) {
+      fprintf(salida, "    IDs:");
+      for (int k = 0; k < encontrados && k < 5; k++) fprintf(salida, " %d", poblacion->id[filas_filtro[k]]);
+      fprintf(salida, encontrados > 5 ? " ...\n" : "\n");
     }
   }
   
   // Estadisticas generales
-  printf("\n--- ESTADISTICAS DE HASH TABLE ---\n");
+  fprintf(salida, "\n--- ESTADISTICAS DE HASH TABLE ---\n");
   
   // Contar estados actuales
   int sanos = 0, infectados = 0, recuperados = 0;
   for (int i = 0; i < num_individuos; i++) {
-    switch (poblacion[i].estado) {
+    switch (poblacion->estado[i]) {
       case SANO: sanos++; break;
       case INFECTADO: infectados++; break;
       case RECUPERADO: recuperados++; break;
     }
   }
   
-  printf("Estados actuales:\n");
-  printf("  Sanos: %d (%.1f%%)\n", sanos, (float)sanos / num_individuos * 100);
-  printf("  Infectados: %d (%.1f%%)\n", infectados, (float)infectados / num_individuos * 100);
-  printf("  Recuperados: %d (%.1f%%)\n", recuperados, (float)recuperados / num_individuos * 100);
+  fprintf(salida, "Estados actuales:\n");
+  fprintf(salida, "  Sanos: %d (%.1f%%)\n", sanos, (float)sanos / num_individuos * 100);
+  fprintf(salida, "  Infectados: %d (%.1f%%)\n", infectados, (float)infectados / num_individuos * 100);
+  fprintf(salida, "  Recuperados: %d (%.1f%%)\n", recuperados, (float)recuperados / num_individuos * 100);
   
-  printf("\nPerformance:\n");
-  printf("  Tamanio tabla hash: %d\n", HASH_TABLE_SIZE);
-  printf("  Factor de carga: %.2f%%\n", (float)num_individuos / HASH_TABLE_SIZE * 100);
-  printf("  Tiempo construccion: %.3f ms (O(n))\n", tiempo_construccion);
-  printf("  Tiempo consultas: %.6f ms promedio (O(1))\n", tiempo_consultas / num_consultas);
+  fprintf(salida, "\nPerformance:\n");
+  const MapaIds *ids = base->ids;
+  if (ids->rango > 0) {
+    fprintf(salida, "  Indice directo: IDs %d..%d, %d individuos en %d posiciones\n",
+            ids->id_minimo, ids->id_minimo + ids->rango - 1, ids->num_directos, ids->rango);
+  }
+  int capacidad = hash_concurrente_capacidad(ids->dispersos);
+  fprintf(salida, "  Tabla hash (IDs fuera del indice): %d en %d posiciones\n",
+          hash_concurrente_elementos(ids->dispersos), capacidad);
+  fprintf(salida, "  Registro de eventos: %d cambios, %zu bytes\n",
+          base->eventos->num_eventos, registro_eventos_bytes(base->eventos));
+  fprintf(salida, "  Tiempo construccion: %.3f ms (O(n))\n", tiempo_construccion);
+  fprintf(salida, "  Tiempo consultas: %.6f ms promedio (O(1))\n", tiempo_consultas / num_consultas);
   
-  printf("\nComplejidad analizada:\n");
-  printf("  Construccion: O(n) = O(%d)\n", num_individuos);
-  printf("  Consulta: O(1) promedio\n");
-  printf("  Cambio estado: O(1) promedio\n");
-  printf("  Historial: O(1) busqueda + O(k) copia donde k=cambios\n");
+  fprintf(salida, "\nComplejidad analizada:\n");
+  fprintf(salida, "  Construccion: O(n) = O(%d)\n", num_individuos);
+  fprintf(salida, "  Consulta: O(1) promedio\n");
+  fprintf(salida, "  Cambio estado: O(1) promedio\n");
+  fprintf(salida, "  Historial: O(1) busqueda + O(k) recorrido donde k=cambios\n");
+  fprintf(salida, "  Consulta filtrada: O(C) donde C=filas del predicado mas selectivo\n");
   
-  printf("\n===== FIN PRUEBAS SUBPROBLEMA 8 =====\n\n");
+  fprintf(salida, "\n===== FIN PRUEBAS SUBPROBLEMA 8 =====\n\n");
   
   // Liberar
-  hash_table_liberar(tabla);
-  liberar_historiales();
+  base_consultas_liberar(base);
 }
\ No newline at end of file
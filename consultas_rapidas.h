@@ -2,7 +2,11 @@
 #define CONSULTAS_RAPIDAS_H
 
 #include "estructuras.h"
-#include "hash_table.h"
+#include "mapa_ids.h"
+#include "indices_poblacion.h"
+#include "registro_eventos.h"
+#include <pthread.h>
+#include <time.h>
 
 // ============================================================
 // SUBPROBLEMA 8: Consultas Rápidas
@@ -17,29 +21,74 @@ typedef struct {
   int cambios_registrados;
 } RegistroHistorial;
 
+// Cerrojos de cambio de estado: la fila f usa cerrojos[f % CONSULTAS_CERROJOS]
+#define CONSULTAS_CERROJOS 64
+
+// Base de consultas de un escenario: índice id -> fila, índices por
+// territorio / estado / riesgo / tiempo_infeccion y el registro de
+// eventos con el historial de todas las filas
+// Consultas y registros pueden venir de varios hilos a la vez: el mapa
+// de IDs no cambia tras construirse, índices y eventos tienen su propio
+// cerrojo y cada cambio de estado toma el cerrojo de su fila (el estado
+// anterior y el nuevo quedan en orden en el historial)
+typedef struct {
+  MapaIds *ids;
+  IndicesPoblacion *indices;
+  RegistroEventos *eventos;
+  pthread_mutex_t cerrojos[CONSULTAS_CERROJOS];
+} BaseConsultas;
+
 /**
- * Crea una tabla hash poblada con todos los individuos
+ * Crea la base de consultas: mapa de IDs de todos los individuos
+ * (índice directo si los IDs son densos), índices secundarios y un
+ * registro de eventos vacío (sin reservar nada por individuo)
  * Complejidad: O(n) donde n = número de individuos
+ * Retorna: BaseConsultas o NULL si no hay memoria
+ */
+BaseConsultas* construir_base_consultas(Poblacion *poblacion);
+
+/**
+ * Libera el mapa de IDs, los índices y el registro de eventos
+ * Complejidad: O(n)
  */
-TablaHash* construir_hash_individuos(Individuo *poblacion, int num_individuos);
+void base_consultas_liberar(BaseConsultas *base);
 
 /**
- * Busca un individuo por ID en O(1) promedio
+ * Busca un individuo por ID (una lectura si cae en el índice directo)
  * Complejidad: O(1) promedio
+ * Retorna: Fila del individuo en la Poblacion o -1 si no existe
+ */
+int consulta_rapida_por_id(BaseConsultas *base, int individuo_id);
+
+/**
+ * Busca n individuos de una vez (ver mapa_ids_buscar_lote)
+ * filas[i] recibe la fila de individuo_ids[i] o -1
+ * Complejidad: O(n) promedio
+ */
+void consulta_rapida_lote(BaseConsultas *base, const int *individuo_ids, int n, int *filas);
+
+/**
+ * Filas que cumplen el filtro (ver indices_poblacion_consultar): copia
+ * hasta max_filas y devuelve el total. No recorre toda la Poblacion
+ * Complejidad: O(C) con C = filas del predicado más selectivo
  */
-Individuo* consulta_rapida_por_id(TablaHash *tabla, int individuo_id);
+int consulta_filtrada(BaseConsultas *base, const Poblacion *poblacion, const FiltroPoblacion *filtro,
+                      int *filas, int max_filas);
 
 /**
  * Registra un cambio de estado en el historial de un individuo
+ * y actualiza las columnas de la Poblacion y los índices secundarios
+ * (bajo el cerrojo de su fila)
  * Complejidad: O(1) promedio para consulta + O(1) para registro
  */
-void registrar_cambio_estado(TablaHash *tabla, int individuo_id, EstadoSalud nuevo_estado);
+void registrar_cambio_estado(BaseConsultas *base, Poblacion *poblacion, int individuo_id, EstadoSalud nuevo_estado);
 
 /**
  * Obtiene el historial de cambios de un individuo
- * Complejidad: O(1) promedio para búsqueda + O(k) para copiar k cambios
+ * Complejidad: O(1) promedio para búsqueda + O(k) para recorrer sus k
+ * eventos en el registro
  */
-RegistroHistorial obtener_historial_paciente(TablaHash *tabla, int individuo_id);
+RegistroHistorial obtener_historial_paciente(BaseConsultas *base, int individuo_id);
 
 /**
  * Libera los registros de historial
@@ -50,8 +99,10 @@ void historial_liberar(RegistroHistorial *historial);
 /**
  * Funcion de prueba para Subproblema 8
  * Demuestra consultas hash y estadisticas
+ * El reporte se escribe en salida (stdout o el buffer de la etapa)
  */
-void test_consultas_rapidas(Individuo *poblacion, int num_individuos,
-                            Territorio *territorios, int num_territorios);
+void test_consultas_rapidas(Poblacion *poblacion,
+                            Territorio *territorios, int num_territorios,
+                            FILE *salida);
 
 #endif // CONSULTAS_RAPIDAS_H
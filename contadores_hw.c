@@ -0,0 +1,262 @@
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
+#include "contadores_hw.h"
+#include "instrumentacion.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <errno.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// ============================================================
+// IMPLEMENTACION CONTADORES DE HARDWARE
+// Un descriptor por contador (inherit no admite lectura en grupo); cada
+// lectura se escala por tiempo_habilitado / tiempo_corriendo por si el
+// kernel multiplexa los contadores. Los contadores por hilo (sin
+// herencia) se abren en la primera lectura de cada hilo y se cierran
+// cuando el hilo termina
+// ============================================================
+
+typedef struct {
+  const char *nombre;
+  long long elementos;
+  double ms;
+  uint64_t valores[NUM_CONTADORES_HW];
+} EtapaHw;
+
+static const char *NOMBRES_HW[NUM_CONTADORES_HW] = {
+  "ciclos", "instrucciones", "fallos L1d", "fallos LLC", "saltos fallidos"
+};
+
+static int descriptores[NUM_CONTADORES_HW] = { -1, -1, -1, -1, -1 };
+static bool activos = false;
+
+static EtapaHw etapas[CONTADORES_HW_MAX_ETAPAS];
+static int num_etapas = 0;
+static bool etapa_abierta = false;
+static uint64_t inicio_valores[NUM_CONTADORES_HW];
+static uint64_t inicio_ns;
+
+static pthread_key_t clave_hilo;
+static pthread_once_t clave_creada = PTHREAD_ONCE_INIT;
+
+#ifdef __linux__
+
+// heredar: contador del proceso que pasa a los hilos creados después; si
+// no, solo cuenta el hilo que lo abre (y empieza habilitado)
+static int abrir_contador(uint32_t tipo, uint64_t configuracion, bool heredar) {
+  struct perf_event_attr atributos;
+  memset(&atributos, 0, sizeof(atributos));
+  atributos.size = sizeof(atributos);
+  atributos.type = tipo;
+  atributos.config = configuracion;
+  atributos.disabled = heredar;
+  atributos.inherit = heredar;
+  atributos.exclude_kernel = 1;
+  atributos.exclude_hv = 1;
+  atributos.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  return (int)syscall(SYS_perf_event_open, &atributos, 0, -1, -1, 0);
+}
+
+// Abre un descriptor por contador (-1 = no disponible)
+// Retorna: errno del contador de ciclos (0 si se abrió)
+static int abrir_todos(int *destino, bool heredar) {
+  const uint64_t l1d_lectura_fallo = PERF_COUNT_HW_CACHE_L1D |
+                                     (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                     (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+  destino[HW_CICLOS] = abrir_contador(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, heredar);
+  int error = destino[HW_CICLOS] < 0 ? errno : 0;
+  destino[HW_INSTRUCCIONES] = abrir_contador(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, heredar);
+  destino[HW_L1D_FALLOS] = abrir_contador(PERF_TYPE_HW_CACHE, l1d_lectura_fallo, heredar);
+  destino[HW_LLC_FALLOS] = abrir_contador(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, heredar);
+  destino[HW_SALTOS_FALLIDOS] = abrir_contador(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, heredar);
+  return error;
+}
+
+static void cerrar_todos(int *destino) {
+  for (int c = 0; c < NUM_CONTADORES_HW; c++) {
+    if (destino[c] >= 0) close(destino[c]);
+    destino[c] = -1;
+  }
+}
+
+static uint64_t leer_contador(int descriptor) {
+  uint64_t datos[3];  // valor, tiempo habilitado, tiempo corriendo
+  if (descriptor < 0 || read(descriptor, datos, sizeof(datos)) != (ssize_t)sizeof(datos)) {
+    return 0;
+  }
+  if (datos[2] == 0) return 0;
+  if (datos[2] < datos[1]) {
+    return (uint64_t)((double)datos[0] * (double)datos[1] / (double)datos[2]);
+  }
+  return datos[0];
+}
+
+bool contadores_hw_abrir(void) {
+  if (activos) return true;
+
+  int error = abrir_todos(descriptores, true);
+  for (int c = 0; c < NUM_CONTADORES_HW; c++) {
+    if (descriptores[c] >= 0) {
+      ioctl(descriptores[c], PERF_EVENT_IOC_RESET, 0);
+      ioctl(descriptores[c], PERF_EVENT_IOC_ENABLE, 0);
+      activos = true;
+    }
+  }
+  if (!activos) {
+    fprintf(stderr, "AVISO: contadores de hardware no disponibles (%s)\n",
+            strerror(error ? error : errno));
+  }
+  return activos;
+}
+
+#else
+
+static void cerrar_todos(int *destino) {
+  for (int c = 0; c < NUM_CONTADORES_HW; c++) destino[c] = -1;
+}
+
+static uint64_t leer_contador(int descriptor) {
+  (void)descriptor;
+  return 0;
+}
+
+bool contadores_hw_abrir(void) {
+  fprintf(stderr, "AVISO: contadores de hardware solo disponibles en Linux\n");
+  return false;
+}
+
+#endif
+
+static void soltar_descriptores_hilo(void *propios) {
+  cerrar_todos((int *)propios);
+  free(propios);
+}
+
+static void crear_clave(void) {
+  pthread_key_create(&clave_hilo, soltar_descriptores_hilo);
+}
+
+// Descriptores sin herencia del hilo actual (se abren la primera vez)
+static int* descriptores_hilo(void) {
+  pthread_once(&clave_creada, crear_clave);
+  int *propios = (int *)pthread_getspecific(clave_hilo);
+  if (propios) return propios;
+
+  propios = (int *)malloc(NUM_CONTADORES_HW * sizeof(int));
+  if (!propios) return NULL;
+#ifdef __linux__
+  abrir_todos(propios, false);
+#else
+  cerrar_todos(propios);
+#endif
+  pthread_setspecific(clave_hilo, propios);
+  return propios;
+}
+
+void contadores_hw_cerrar(void) {
+  cerrar_todos(descriptores);
+  pthread_once(&clave_creada, crear_clave);
+  int *propios = (int *)pthread_getspecific(clave_hilo);
+  if (propios) {
+    soltar_descriptores_hilo(propios);
+    pthread_setspecific(clave_hilo, NULL);
+  }
+  activos = false;
+}
+
+bool contadores_hw_activos(void) {
+  return activos;
+}
+
+static void leer_todos(uint64_t *valores) {
+  for (int c = 0; c < NUM_CONTADORES_HW; c++) valores[c] = leer_contador(descriptores[c]);
+}
+
+void contadores_hw_hilo_leer(uint64_t *valores) {
+  int *propios = activos ? descriptores_hilo() : NULL;
+  for (int c = 0; c < NUM_CONTADORES_HW; c++) {
+    valores[c] = propios ? leer_contador(propios[c]) : 0;
+  }
+}
+
+void contadores_hw_etapa_inicio(const char *nombre) {
+  if (!activos) return;
+  if (etapa_abierta) contadores_hw_etapa_fin(0);
+  if (num_etapas >= CONTADORES_HW_MAX_ETAPAS) return;
+
+  etapas[num_etapas].nombre = nombre;
+  etapa_abierta = true;
+  inicio_ns = instr_reloj_ns();
+  leer_todos(inicio_valores);
+}
+
+void contadores_hw_etapa_fin(long long elementos) {
+  if (!activos || !etapa_abierta) return;
+  uint64_t fin_valores[NUM_CONTADORES_HW];
+  leer_todos(fin_valores);
+
+  EtapaHw *etapa = &etapas[num_etapas++];
+  etapa->ms = (double)(instr_reloj_ns() - inicio_ns) / 1e6;
+  etapa->elementos = elementos;
+  for (int c = 0; c < NUM_CONTADORES_HW; c++) {
+    etapa->valores[c] = fin_valores[c] - inicio_valores[c];
+  }
+  etapa_abierta = false;
+}
+
+void contadores_hw_etapa_agregar(const char *nombre, long long elementos, double ms,
+                                  const uint64_t *valores) {
+  if (!activos || num_etapas >= CONTADORES_HW_MAX_ETAPAS) return;
+  EtapaHw *etapa = &etapas[num_etapas++];
+  etapa->nombre = nombre;
+  etapa->elementos = elementos;
+  etapa->ms = ms;
+  memcpy(etapa->valores, valores, sizeof(etapa->valores));
+}
+
+void contadores_hw_reporte(FILE *salida) {
+  if (!activos) return;
+  fprintf(salida, "\n========== CONTADORES DE HARDWARE ==========\n");
+  fprintf(salida, "Contadores:");
+  for (int c = 0; c < NUM_CONTADORES_HW; c++) {
+    fprintf(salida, " %s%s", NOMBRES_HW[c], descriptores[c] >= 0 ? "" : " (n/d)");
+  }
+  fprintf(salida, "\n\n%-24s %10s %10s %14s %14s %6s %12s %12s %12s\n",
+          "Etapa", "Elementos", "ms", "Ciclos", "Instrucciones", "IPC",
+          "L1d/elem", "LLC/elem", "Saltos/elem");
+  fprintf(salida, "------------------------+----------+----------+--------------+"
+                  "--------------+------+------------+------------+------------\n");
+
+  for (int i = 0; i < num_etapas; i++) {
+    const EtapaHw *e = &etapas[i];
+    double ipc = e->valores[HW_CICLOS] > 0
+                     ? (double)e->valores[HW_INSTRUCCIONES] / (double)e->valores[HW_CICLOS]
+                     : 0.0;
+    double por_elemento = e->elementos > 0 ? 1.0 / (double)e->elementos : 0.0;
+    fprintf(salida, "%-24s %10lld %10.3f %14llu %14llu %6.2f %12.3f %12.3f %12.3f\n",
+            e->nombre, e->elementos, e->ms,
+            (unsigned long long)e->valores[HW_CICLOS],
+            (unsigned long long)e->valores[HW_INSTRUCCIONES], ipc,
+            e->valores[HW_L1D_FALLOS] * por_elemento,
+            e->valores[HW_LLC_FALLOS] * por_elemento,
+            e->valores[HW_SALTOS_FALLIDOS] * por_elemento);
+  }
+
+  fprintf(salida, "\nTotales de fallos por etapa:\n");
+  for (int i = 0; i < num_etapas; i++) {
+    const EtapaHw *e = &etapas[i];
+    fprintf(salida, "  %-24s L1d %llu, LLC %llu, saltos %llu\n", e->nombre,
+            (unsigned long long)e->valores[HW_L1D_FALLOS],
+            (unsigned long long)e->valores[HW_LLC_FALLOS],
+            (unsigned long long)e->valores[HW_SALTOS_FALLIDOS]);
+  }
+  fprintf(salida, "============================================\n");
+}
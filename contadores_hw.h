@@ -0,0 +1,89 @@
+#ifndef CONTADORES_HW_H
+#define CONTADORES_HW_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// ============================================================
+// CONTADORES DE HARDWARE - perf_event_open por etapa
+// Modo opcional (generador --perf): ciclos, instrucciones, fallos de L1d
+// y de último nivel de caché y saltos mal predichos alrededor de cada
+// etapa, con IPC y fallos por elemento. Solo Linux; en otros sistemas (o
+// sin permisos, ver /proc/sys/kernel/perf_event_paranoid) el modo se
+// desactiva con un aviso y las funciones no hacen nada.
+// Los contadores heredan a los hilos creados después de abrirlos, así que
+// las etapas paralelas se miden completas. Para etapas que corren a la
+// vez, cada hilo lee además sus propios contadores
+// (contadores_hw_hilo_leer) y la etapa se agrega al terminar.
+// ============================================================
+
+// Máximo de etapas registradas en el reporte
+#define CONTADORES_HW_MAX_ETAPAS 64
+
+typedef enum {
+  HW_CICLOS,
+  HW_INSTRUCCIONES,
+  HW_L1D_FALLOS,
+  HW_LLC_FALLOS,
+  HW_SALTOS_FALLIDOS,
+  NUM_CONTADORES_HW
+} ContadorHw;
+
+/**
+ * Abre los contadores para este proceso (y sus hilos futuros)
+ * Complejidad: O(1)
+ * Retorna: true si al menos un contador quedó disponible
+ */
+bool contadores_hw_abrir(void);
+
+/**
+ * true si contadores_hw_abrir tuvo éxito
+ * Complejidad: O(1)
+ */
+bool contadores_hw_activos(void);
+
+/**
+ * Marca el inicio de una etapa (nombre: cadena estática)
+ * Las etapas no se anidan: iniciar otra cierra la anterior sin elementos
+ * Complejidad: O(NUM_CONTADORES_HW)
+ */
+void contadores_hw_etapa_inicio(const char *nombre);
+
+/**
+ * Cierra la etapa actual; elementos = tamaño de la entrada procesada
+ * (se usa para fallos por elemento)
+ * Complejidad: O(NUM_CONTADORES_HW)
+ */
+void contadores_hw_etapa_fin(long long elementos);
+
+/**
+ * Lee los contadores del hilo actual: solo lo que ejecutó este hilo,
+ * desde su primera lectura (ceros si el modo no está activo)
+ * Complejidad: O(NUM_CONTADORES_HW)
+ */
+void contadores_hw_hilo_leer(uint64_t *valores);
+
+/**
+ * Agrega al reporte una etapa medida aparte (valores: un total por
+ * contador), p.ej. sumando contadores_hw_hilo_leer de los hilos que la
+ * ejecutaron. No toca la etapa abierta
+ * Complejidad: O(NUM_CONTADORES_HW)
+ */
+void contadores_hw_etapa_agregar(const char *nombre, long long elementos, double ms,
+                                  const uint64_t *valores);
+
+/**
+ * Imprime por etapa: ciclos, instrucciones, IPC, fallos L1d/LLC y saltos
+ * mal predichos (totales y por elemento)
+ * Complejidad: O(etapas)
+ */
+void contadores_hw_reporte(FILE *salida);
+
+/**
+ * Cierra los descriptores de los contadores
+ * Complejidad: O(1)
+ */
+void contadores_hw_cerrar(void);
+
+#endif // CONTADORES_HW_H
@@ -1,4 +1,6 @@
 #include "contencion_vacunacion.h"
+#include "memoria.h"
+#include "instrumentacion.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
@@ -38,9 +40,9 @@ static int comparar_aristas(const void *a, const void *b) {
 //   4. Unir los conjuntos de u y v
 //   5. Repetir hasta n-1 aristas en MST
 // ============================================================
-ResultadoMST kruskal_mst(Grafo *grafo_territorios, int num_territorios) {
+ResultadoMST kruskal_mst(GrafoCSR *grafo_territorios, int num_territorios, Arena *arena) {
   ResultadoMST resultado;
-  resultado.aristas_mst = (AristaTerritorios *)malloc((num_territorios - 1) * sizeof(AristaTerritorios));
+  resultado.aristas_mst = (AristaTerritorios *)bio_malloc((num_territorios - 1) * sizeof(AristaTerritorios));
   resultado.num_aristas = 0;
   resultado.peso_total = 0.0;
   
@@ -48,18 +50,23 @@ ResultadoMST kruskal_mst(Grafo *grafo_territorios, int num_territorios) {
     return resultado;
   }
   
+  // Buffers temporales de la etapa: se devuelven a la arena al terminar
+  Arena *temporal = arena ? arena : arena_crear(0);
+  MarcaArena marca = arena_marca(temporal);
+  
   // Paso 1: Extraer todas las aristas del grafo - O(m)
-  AristaOrdenada *todas_aristas = (AristaOrdenada *)malloc(grafo_territorios->num_nodos * 100 * sizeof(AristaOrdenada));
+  // El CSR conoce el número exacto de aristas: sin sobredimensionar el buffer
+  AristaOrdenada *todas_aristas = (AristaOrdenada *)arena_reservar(temporal,
+      (grafo_territorios->num_aristas > 0 ? grafo_territorios->num_aristas : 1) * sizeof(AristaOrdenada));
   int num_total_aristas = 0;
   
   for (int i = 0; i < num_territorios; i++) {
-    NodoAdyacencia *actual = grafo_territorios->listas[i];
-    while (actual != NULL) {
+    int fin = grafo_territorios->inicio[i + 1];
+    for (int e = grafo_territorios->inicio[i]; e < fin; e++) {
       todas_aristas[num_total_aristas].u = i;
-      todas_aristas[num_total_aristas].v = actual->destino_id;
-      todas_aristas[num_total_aristas].peso = actual->peso;
+      todas_aristas[num_total_aristas].v = grafo_territorios->destino_id[e];
+      todas_aristas[num_total_aristas].peso = grafo_territorios->peso[e];
       num_total_aristas++;
-      actual = actual->siguiente;
     }
   }
   
@@ -67,7 +74,12 @@ ResultadoMST kruskal_mst(Grafo *grafo_territorios, int num_territorios) {
   qsort(todas_aristas, num_total_aristas, sizeof(AristaOrdenada), comparar_aristas);
   
   // Paso 3: Crear Union-Find para detectar ciclos - O(n)
-  UnionFind *uf = union_find_crear(num_territorios);
+  UnionFind conjuntos;
+  union_find_inicializar(&conjuntos,
+                         (int *)arena_reservar(temporal, num_territorios * sizeof(int)),
+                         (int *)arena_reservar(temporal, num_territorios * sizeof(int)),
+                         num_territorios);
+  UnionFind *uf = &conjuntos;
   
   // Paso 4: Algoritmo de Kruskal - O(m * alpha(n))
   for (int i = 0; i < num_total_aristas && resultado.num_aristas < num_territorios - 1; i++) {
@@ -94,9 +106,9 @@ ResultadoMST kruskal_mst(Grafo *grafo_territorios, int num_territorios) {
     }
   }
   
-  // Liberar memoria
-  free(todas_aristas);
-  union_find_liberar(uf);
+  // Liberar memoria temporal (aristas_mst es del llamador)
+  arena_restaurar(temporal, marca);
+  if (!arena) arena_liberar(temporal);
   
   return resultado;
 }
@@ -105,9 +117,10 @@ ResultadoMST kruskal_mst(Grafo *grafo_territorios, int num_territorios) {
 // Algoritmo de Prim para MST (versión simple sin Heap)
 // Complejidad: O(n^2) versión simple, O((n+m) log n) con Heap
 // ============================================================
-ResultadoMST prim_mst(Grafo *grafo_territorios, int num_territorios, int territorio_inicio) {
+ResultadoMST prim_mst(GrafoCSR *grafo_territorios, int num_territorios, int territorio_inicio,
+                      Arena *arena) {
   ResultadoMST resultado;
-  resultado.aristas_mst = (AristaTerritorios *)malloc((num_territorios - 1) * sizeof(AristaTerritorios));
+  resultado.aristas_mst = (AristaTerritorios *)bio_malloc((num_territorios - 1) * sizeof(AristaTerritorios));
   resultado.num_aristas = 0;
   resultado.peso_total = 0.0;
   
@@ -117,9 +130,11 @@ ResultadoMST prim_mst(Grafo *grafo_territorios, int num_territorios, int territo
   }
   
   // Arrays para rastrear nodos visitados y distancias minimas
-  bool *visitado = (bool *)malloc(num_territorios * sizeof(bool));
-  float *distancia_minima = (float *)malloc(num_territorios * sizeof(float));
-  int *padre = (int *)malloc(num_territorios * sizeof(int));
+  Arena *temporal = arena ? arena : arena_crear(0);
+  MarcaArena marca = arena_marca(temporal);
+  bool *visitado = (bool *)arena_reservar(temporal, num_territorios * sizeof(bool));
+  float *distancia_minima = (float *)arena_reservar(temporal, num_territorios * sizeof(float));
+  int *padre = (int *)arena_reservar(temporal, num_territorios * sizeof(int));
   
   // Inicializar
   for (int i = 0; i < num_territorios; i++) {
@@ -158,31 +173,29 @@ ResultadoMST prim_mst(Grafo *grafo_territorios, int num_territorios, int territo
     }
     
     // Actualizar distancias a los vecinos de u
-    NodoAdyacencia *vecino = grafo_territorios->listas[u];
-    while (vecino != NULL) {
-      int v = vecino->destino_id;
-      float peso = vecino->peso;
+    int fin = grafo_territorios->inicio[u + 1];
+    INSTR_CONTAR(CONTADOR_ARISTAS_RELAJADAS, fin - grafo_territorios->inicio[u]);
+    for (int e = grafo_territorios->inicio[u]; e < fin; e++) {
+      int v = grafo_territorios->destino_id[e];
+      float peso = grafo_territorios->peso[e];
       
       if (!visitado[v] && peso < distancia_minima[v]) {
         distancia_minima[v] = peso;
         padre[v] = u;
       }
-      
-      vecino = vecino->siguiente;
     }
   }
   
-  // Liberar memoria
-  free(visitado);
-  free(distancia_minima);
-  free(padre);
+  // Liberar memoria temporal
+  arena_restaurar(temporal, marca);
+  if (!arena) arena_liberar(temporal);
   
   return resultado;
 }
 
 void mst_liberar(ResultadoMST *resultado) {
   if (resultado && resultado->aristas_mst) {
-    free(resultado->aristas_mst);
+    bio_free(resultado->aristas_mst);
     resultado->aristas_mst = NULL;
     resultado->num_aristas = 0;
   }
@@ -192,86 +205,90 @@ void mst_liberar(ResultadoMST *resultado) {
 // FUNCION DE PRUEBA: Test del algoritmo Kruskal y Prim
 // ============================================================
 
-void test_contencion_vacunacion(Grafo *grafo_territorios, int num_territorios) {
+void test_contencion_vacunacion(GrafoCSR *grafo_territorios, int num_territorios, FILE *salida) {
   if (!grafo_territorios || num_territorios <= 0) {
-    printf("ERROR: Grafo o territorios invalidos\n");
+    fprintf(salida, "ERROR: Grafo o territorios invalidos\n");
     return;
   }
   
-  printf("\n========== SUBPROBLEMA 6: CONTENCION (VACUNACION) ==========\n");
-  printf("Territorios: %d\n", num_territorios);
-  printf("Algoritmo: MST (Minimum Spanning Tree) con Kruskal y Prim\n\n");
+  fprintf(salida, "\n========== SUBPROBLEMA 6: CONTENCION (VACUNACION) ==========\n");
+  fprintf(salida, "Territorios: %d\n", num_territorios);
+  fprintf(salida, "Algoritmo: MST (Minimum Spanning Tree) con Kruskal y Prim\n\n");
+  
+  // Arena de la etapa: Kruskal y Prim reutilizan los mismos bloques
+  Arena *arena = arena_crear(0);
   
   // Prueba 1: Kruskal MST
-  printf("--- PRUEBA 1: MST usando Kruskal ---\n");
-  ResultadoMST mst_kruskal = kruskal_mst(grafo_territorios, num_territorios);
+  fprintf(salida, "--- PRUEBA 1: MST usando Kruskal ---\n");
+  ResultadoMST mst_kruskal = kruskal_mst(grafo_territorios, num_territorios, arena);
   
-  printf("Aristas en MST: %d\n", mst_kruskal.num_aristas);
-  printf("Peso total (distancia): %.2f\n", mst_kruskal.peso_total);
-  printf("Territorios conectados en cobertura minima: %d de %d\n\n",
-         mst_kruskal.num_aristas + 1, num_territorios);
+  fprintf(salida, "Aristas en MST: %d\n", mst_kruskal.num_aristas);
+  fprintf(salida, "Peso total (distancia): %.2f\n", mst_kruskal.peso_total);
+  fprintf(salida, "Territorios conectados en cobertura minima: %d de %d\n\n",
+          mst_kruskal.num_aristas + 1, num_territorios);
   
-  printf("Conexiones de la red minima (primeras 10):\n");
+  fprintf(salida, "Conexiones de la red minima (primeras 10):\n");
   for (int i = 0; i < 10 && i < mst_kruskal.num_aristas; i++) {
-    printf("  T%d -- T%d (distancia: %.2f)\n",
-           mst_kruskal.aristas_mst[i].territorio_1,
-           mst_kruskal.aristas_mst[i].territorio_2,
-           mst_kruskal.aristas_mst[i].peso);
+    fprintf(salida, "  T%d -- T%d (distancia: %.2f)\n",
+            mst_kruskal.aristas_mst[i].territorio_1,
+            mst_kruskal.aristas_mst[i].territorio_2,
+            mst_kruskal.aristas_mst[i].peso);
   }
   if (mst_kruskal.num_aristas > 10) {
-    printf("  ... y %d conexiones mas\n", mst_kruskal.num_aristas - 10);
+    fprintf(salida, "  ... y %d conexiones mas\n", mst_kruskal.num_aristas - 10);
   }
   
   // Prueba 2: Prim MST desde territorio 0
-  printf("\n--- PRUEBA 2: MST usando Prim (inicio en Territorio 0) ---\n");
-  ResultadoMST mst_prim = prim_mst(grafo_territorios, num_territorios, 0);
+  fprintf(salida, "\n--- PRUEBA 2: MST usando Prim (inicio en Territorio 0) ---\n");
+  ResultadoMST mst_prim = prim_mst(grafo_territorios, num_territorios, 0, arena);
   
-  printf("Aristas en MST: %d\n", mst_prim.num_aristas);
-  printf("Peso total (distancia): %.2f\n", mst_prim.peso_total);
-  printf("Territorios conectados: %d de %d\n\n",
-         mst_prim.num_aristas + 1, num_territorios);
+  fprintf(salida, "Aristas en MST: %d\n", mst_prim.num_aristas);
+  fprintf(salida, "Peso total (distancia): %.2f\n", mst_prim.peso_total);
+  fprintf(salida, "Territorios conectados: %d de %d\n\n",
+          mst_prim.num_aristas + 1, num_territorios);
   
-  printf("Conexiones de la red minima (primeras 10):\n");
+  fprintf(salida, "Conexiones de la red minima (primeras 10):\n");
   for (int i = 0; i < 10 && i < mst_prim.num_aristas; i++) {
-    printf("  T%d -- T%d (distancia: %.2f)\n",
-           mst_prim.aristas_mst[i].territorio_1,
-           mst_prim.aristas_mst[i].territorio_2,
-           mst_prim.aristas_mst[i].peso);
+    fprintf(salida, "  T%d -- T%d (distancia: %.2f)\n",
+            mst_prim.aristas_mst[i].territorio_1,
+            mst_prim.aristas_mst[i].territorio_2,
+            mst_prim.aristas_mst[i].peso);
   }
   if (mst_prim.num_aristas > 10) {
-    printf("  ... y %d conexiones mas\n", mst_prim.num_aristas - 10);
+    fprintf(salida, "  ... y %d conexiones mas\n", mst_prim.num_aristas - 10);
   }
   
   // Comparacion
-  printf("\n--- COMPARACION KRUSKAL vs PRIM ---\n");
-  printf("Algoritmo | Aristas | Peso Total | Diferencia\n");
-  printf("-----------+---------+------------+-----------\n");
-  printf("Kruskal   |   %3d   |   %.2f    |    0.00\n",
-         mst_kruskal.num_aristas, mst_kruskal.peso_total);
-  printf("Prim      |   %3d   |   %.2f    |   %.2f\n",
-         mst_prim.num_aristas, mst_prim.peso_total,
-         mst_prim.peso_total - mst_kruskal.peso_total);
+  fprintf(salida, "\n--- COMPARACION KRUSKAL vs PRIM ---\n");
+  fprintf(salida, "Algoritmo | Aristas | Peso Total | Diferencia\n");
+  fprintf(salida, "-----------+---------+------------+-----------\n");
+  fprintf(salida, "Kruskal   |   %3d   |   %.2f    |    0.00\n",
+          mst_kruskal.num_aristas, mst_kruskal.peso_total);
+  fprintf(salida, "Prim      |   %3d   |   %.2f    |   %.2f\n",
+          mst_prim.num_aristas, mst_prim.peso_total,
+          mst_prim.peso_total - mst_kruskal.peso_total);
   
   // Estadisticas
-  printf("\n--- ESTADISTICAS DE COBERTURA ---\n");
+  fprintf(salida, "\n--- ESTADISTICAS DE COBERTURA ---\n");
   float costo_por_territorio = mst_kruskal.peso_total / num_territorios;
   float eficiencia = (float)mst_kruskal.num_aristas / num_territorios;
   
-  printf("Costo promedio por territorio: %.2f\n", costo_por_territorio);
-  printf("Eficiencia de cobertura: %.2f%% (aristas/territorios)\n",
-         eficiencia * 100);
-  printf("Territorios con vacunacion: %d (%.1f%%)\n",
-         mst_kruskal.num_aristas + 1,
-         (float)(mst_kruskal.num_aristas + 1) / num_territorios * 100);
+  fprintf(salida, "Costo promedio por territorio: %.2f\n", costo_por_territorio);
+  fprintf(salida, "Eficiencia de cobertura: %.2f%% (aristas/territorios)\n",
+          eficiencia * 100);
+  fprintf(salida, "Territorios con vacunacion: %d (%.1f%%)\n",
+          mst_kruskal.num_aristas + 1,
+          (float)(mst_kruskal.num_aristas + 1) / num_territorios * 100);
   
-  printf("\nComplejidad Kruskal: O(m log m) donde m=%d aristas\n", 
-         mst_kruskal.num_aristas * 3);  // Aproximacion
-  printf("Complejidad Prim: O(n^2) = O(%d)\n", num_territorios * num_territorios);
-  printf("Estructura auxiliar: Union-Find con O(alpha(n)) amortizado\n");
+  fprintf(salida, "\nComplejidad Kruskal: O(m log m) donde m=%d aristas\n", 
+          mst_kruskal.num_aristas * 3);  // Aproximacion
+  fprintf(salida, "Complejidad Prim: O(n^2) = O(%d)\n", num_territorios * num_territorios);
+  fprintf(salida, "Estructura auxiliar: Union-Find con O(alpha(n)) amortizado\n");
   
-  printf("\n===== FIN PRUEBAS SUBPROBLEMA 6 =====\n\n");
+  fprintf(salida, "\n===== FIN PRUEBAS SUBPROBLEMA 6 =====\n\n");
   
   // Liberar
   mst_liberar(&mst_kruskal);
   mst_liberar(&mst_prim);
+  arena_liberar(arena);
 }
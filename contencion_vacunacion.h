@@ -3,6 +3,7 @@
 
 #include "estructuras.h"
 #include "union_find.h"
+#include "arena.h"
 
 // ============================================================
 // SUBPROBLEMA 6: Contención (Vacunación)
@@ -27,16 +28,19 @@ typedef struct {
  * Encuentra el Árbol de Expansión Mínima usando Kruskal
  * Complejidad: O((m + n) log n) = O(m log n) donde m es el número de aristas
  * El MST minimiza los territorios que necesitan vacunación para contener brotes
+ * arena: buffers temporales (aristas ordenadas, Union-Find); NULL = arena propia
  * Retorna: Aristas que forman el MST
  */
-ResultadoMST kruskal_mst(Grafo *grafo_territorios, int num_territorios);
+ResultadoMST kruskal_mst(GrafoCSR *grafo_territorios, int num_territorios, Arena *arena);
 
 /**
  * Encuentra el Árbol de Expansión Mínima usando Prim
  * Complejidad: O((n + m) log n) con Heap
  * territorio_inicio: territorio desde el cual comenzar
+ * arena: buffers temporales; NULL = arena propia
  */
-ResultadoMST prim_mst(Grafo *grafo_territorios, int num_territorios, int territorio_inicio);
+ResultadoMST prim_mst(GrafoCSR *grafo_territorios, int num_territorios, int territorio_inicio,
+                      Arena *arena);
 
 /**
  * Libera los resultados del MST
@@ -44,4 +48,11 @@ ResultadoMST prim_mst(Grafo *grafo_territorios, int num_territorios, int territo
  */
 void mst_liberar(ResultadoMST *resultado);
 
+/**
+ * Función de prueba para Kruskal y Prim
+ * Compara ambos MST sobre el grafo de territorios
+ * El reporte se escribe en salida (stdout o el buffer de la etapa)
+ */
+void test_contencion_vacunacion(GrafoCSR *grafo_territorios, int num_territorios, FILE *salida);
+
 #endif // CONTENCION_VACUNACION_H
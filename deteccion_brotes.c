@@ -1,4 +1,9 @@
 #include "deteccion_brotes.h"
+#include "memoria.h"
+#include "poblacion.h"
+#include "indice_territorios.h"
+#include "rng.h"
+#include "traza.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -12,7 +17,7 @@
 // ===== ESTRUCTURAS AUXILIARES PARA COLA FIFO (BFS) =====
 
 Cola* cola_crear() {
-  Cola *cola = (Cola *)malloc(sizeof(Cola));
+  Cola *cola = (Cola *)bio_malloc(sizeof(Cola));
   cola->frente = NULL;
   cola->cola = NULL;
   cola->tamano = 0;
@@ -22,7 +27,7 @@ Cola* cola_crear() {
 void cola_encolar(Cola *cola, int individuo_id) {
   if (!cola) return;
   
-  NodoFila *nuevo = (NodoFila *)malloc(sizeof(NodoFila));
+  NodoFila *nuevo = (NodoFila *)bio_malloc(sizeof(NodoFila));
   nuevo->individuo_id = individuo_id;
   nuevo->siguiente = NULL;
   
@@ -47,7 +52,7 @@ int cola_desencolar(Cola *cola) {
     cola->cola = NULL;
   }
   
-  free(temp);
+  bio_free(temp);
   return id;
 }
 
@@ -61,49 +66,53 @@ void cola_liberar(Cola *cola) {
   while (!cola_vacia(cola)) {
     cola_desencolar(cola);
   }
-  free(cola);
+  bio_free(cola);
 }
 
 // ===== CONSTRUCCION DE GRAFO DE CONTACTOS =====
-// Complejidad: O(T) donde T es número total de individuos en territorios
+// Complejidad: O(sum T_t^2) donde T_t es el número de individuos del territorio t
+// Los miembros de cada territorio se recorren como un rango contiguo del índice CSR
+// La probabilidad de cada arista dirigida es un sorteo sin estado de
+// (semilla, origen, destino): BFS y DFS ven exactamente el mismo grafo
 
-GrafoContactos* construir_grafo_contactos(Territorio *territorios, int num_territorios, int num_individuos) {
-  GrafoContactos *grafo = (GrafoContactos *)malloc(sizeof(GrafoContactos));
+static float probabilidad_contacto(uint64_t semilla, int origen, int destino) {
+  float u = rng_uniforme_contador(semilla, RNG_FLUJO(RNG_FLUJO_CONTACTOS, origen), (uint64_t)destino);
+  return 0.5f + (int)(u * 50) / 100.0f; // 0.5 a 0.99
+}
+
+GrafoContactos* construir_grafo_contactos(const IndiceTerritorios *indice, int num_individuos,
+                                          uint64_t semilla) {
+  GrafoContactos *grafo = (GrafoContactos *)bio_malloc(sizeof(GrafoContactos));
   grafo->num_individuos = num_individuos;
-  grafo->listas = (NodoContacto **)calloc(num_individuos, sizeof(NodoContacto *));
+  grafo->listas = (NodoContacto **)bio_calloc(num_individuos, sizeof(NodoContacto *));
   
   // Crear contactos entre individuos del mismo territorio
-  // Complejidad: O(T) donde T es número total de individuos
-  for (int t = 0; t < num_territorios; t++) {
+  for (int t = 0; t < indice->num_territorios; t++) {
     // Para cada territorio, conectar individuos (simulando contacto territorial)
-    NodoIndividuo *nodo1 = territorios[t].individuos;
+    const int *miembros = indice_territorios_miembros(indice, t);
+    int num_miembros = indice_territorios_tamano(indice, t);
     
-    while (nodo1 != NULL) {
-      int id1 = nodo1->data->id;
+    for (int a = 0; a < num_miembros; a++) {
+      int id1 = miembros[a];
       
       // Conectar con otros individuos del mismo territorio (crear contactos)
-      NodoIndividuo *nodo2 = nodo1->siguiente;
-      while (nodo2 != NULL) {
-        int id2 = nodo2->data->id;
+      for (int b = a + 1; b < num_miembros; b++) {
+        int id2 = miembros[b];
         
         // Agregar arista de id1 a id2
-        NodoContacto *nuevo = (NodoContacto *)malloc(sizeof(NodoContacto));
+        NodoContacto *nuevo = (NodoContacto *)bio_malloc(sizeof(NodoContacto));
         nuevo->individuo_id = id2;
-        nuevo->probabilidad_contacto = 0.5f + (rand() % 50) / 100.0f; // 0.5 a 0.99
+        nuevo->probabilidad_contacto = probabilidad_contacto(semilla, id1, id2);
         nuevo->siguiente = grafo->listas[id1];
         grafo->listas[id1] = nuevo;
         
         // Agregar arista de id2 a id1 (grafo no dirigido)
-        nuevo = (NodoContacto *)malloc(sizeof(NodoContacto));
+        nuevo = (NodoContacto *)bio_malloc(sizeof(NodoContacto));
         nuevo->individuo_id = id1;
-        nuevo->probabilidad_contacto = 0.5f + (rand() % 50) / 100.0f;
+        nuevo->probabilidad_contacto = probabilidad_contacto(semilla, id2, id1);
         nuevo->siguiente = grafo->listas[id2];
         grafo->listas[id2] = nuevo;
-        
-        nodo2 = nodo2->siguiente;
       }
-      
-      nodo1 = nodo1->siguiente;
     }
   }
   
@@ -118,27 +127,30 @@ void grafo_contactos_liberar(GrafoContactos *grafo) {
     while (actual != NULL) {
       NodoContacto *temp = actual;
       actual = actual->siguiente;
-      free(temp);
+      bio_free(temp);
     }
   }
   
-  free(grafo->listas);
-  free(grafo);
+  bio_free(grafo->listas);
+  bio_free(grafo);
 }
 
 // ===== IMPLEMENTACION BFS =====
 // Complejidad: O(V + E) donde V = infectados, E = contactos entre infectados
 // BFS es iterativo usando Cola FIFO
 
-ResultadoDeteccionBrotes detectar_brotes_bfs(Territorio *territorios, int num_territorios, Individuo *poblacion, int num_individuos) {
+ResultadoDeteccionBrotes detectar_brotes_bfs(const IndiceTerritorios *indice, Poblacion *poblacion,
+                                             uint64_t semilla) {
+  int num_individuos = poblacion->num_individuos;
+  const EstadoSalud *estado = poblacion->estado;
   ResultadoDeteccionBrotes resultado;
-  resultado.componentes = (int *)malloc(num_individuos * sizeof(int));
+  resultado.componentes = (int *)bio_malloc(num_individuos * sizeof(int));
   resultado.num_componentes = 0;
   memset(resultado.componentes, -1, num_individuos * sizeof(int));
   memset(resultado.num_infectados_por_componente, 0, sizeof(resultado.num_infectados_por_componente));
   
   // Construir grafo de contactos
-  GrafoContactos *grafo = construir_grafo_contactos(territorios, num_territorios, num_individuos);
+  GrafoContactos *grafo = construir_grafo_contactos(indice, num_individuos, semilla);
   
   // Crear cola para BFS
   Cola *cola = cola_crear();
@@ -146,9 +158,10 @@ ResultadoDeteccionBrotes detectar_brotes_bfs(Territorio *territorios, int num_te
   // Iterar sobre todos los individuos
   for (int i = 0; i < num_individuos; i++) {
     // Solo procesar infectados no visitados
-    if (poblacion[i].estado == INFECTADO && resultado.componentes[i] == -1) {
+    if (estado[i] == INFECTADO && resultado.componentes[i] == -1) {
       // Nuevo componente
       int id_componente = resultado.num_componentes;
+      uint64_t traza = traza_inicio();
       
       // Encolar el individuo inicial
       cola_encolar(cola, i);
@@ -165,7 +178,7 @@ ResultadoDeteccionBrotes detectar_brotes_bfs(Territorio *territorios, int num_te
           int id_vecino = contacto->individuo_id;
           
           // Si el vecino está infectado y no ha sido visitado
-          if (poblacion[id_vecino].estado == INFECTADO && resultado.componentes[id_vecino] == -1) {
+          if (estado[id_vecino] == INFECTADO && resultado.componentes[id_vecino] == -1) {
             resultado.componentes[id_vecino] = id_componente;
             resultado.num_infectados_por_componente[id_componente]++;
             cola_encolar(cola, id_vecino);
@@ -175,6 +188,7 @@ ResultadoDeteccionBrotes detectar_brotes_bfs(Territorio *territorios, int num_te
         }
       }
       
+      traza_fin("componente_bfs", "brotes", traza, id_componente);
       resultado.num_componentes++;
     }
   }
@@ -190,7 +204,7 @@ ResultadoDeteccionBrotes detectar_brotes_bfs(Territorio *territorios, int num_te
 // Complejidad: O(V + E)
 // DFS es recursivo (stack implícito)
 
-void dfs_recurivo(int id_individuo, int id_componente, Individuo *poblacion,
+void dfs_recurivo(int id_individuo, int id_componente, const EstadoSalud *estado,
                   GrafoContactos *grafo, ResultadoDeteccionBrotes *resultado) {
   // Marcar como visitado
   resultado->componentes[id_individuo] = id_componente;
@@ -201,33 +215,38 @@ void dfs_recurivo(int id_individuo, int id_componente, Individuo *poblacion,
   while (contacto != NULL) {
     int id_vecino = contacto->individuo_id;
     
-    if (poblacion[id_vecino].estado == INFECTADO && resultado->componentes[id_vecino] == -1) {
-      dfs_recurivo(id_vecino, id_componente, poblacion, grafo, resultado);
+    if (estado[id_vecino] == INFECTADO && resultado->componentes[id_vecino] == -1) {
+      dfs_recurivo(id_vecino, id_componente, estado, grafo, resultado);
     }
     
     contacto = contacto->siguiente;
   }
 }
 
-ResultadoDeteccionBrotes detectar_brotes_dfs(Territorio *territorios, int num_territorios, Individuo *poblacion, int num_individuos) {
+ResultadoDeteccionBrotes detectar_brotes_dfs(const IndiceTerritorios *indice, Poblacion *poblacion,
+                                             uint64_t semilla) {
+  int num_individuos = poblacion->num_individuos;
+  const EstadoSalud *estado = poblacion->estado;
   ResultadoDeteccionBrotes resultado;
-  resultado.componentes = (int *)malloc(num_individuos * sizeof(int));
+  resultado.componentes = (int *)bio_malloc(num_individuos * sizeof(int));
   resultado.num_componentes = 0;
   memset(resultado.componentes, -1, num_individuos * sizeof(int));
   memset(resultado.num_infectados_por_componente, 0, sizeof(resultado.num_infectados_por_componente));
   
   // Construir grafo de contactos
-  GrafoContactos *grafo = construir_grafo_contactos(territorios, num_territorios, num_individuos);
+  GrafoContactos *grafo = construir_grafo_contactos(indice, num_individuos, semilla);
   
   // Iterar sobre todos los individuos
   for (int i = 0; i < num_individuos; i++) {
     // Solo procesar infectados no visitados
-    if (poblacion[i].estado == INFECTADO && resultado.componentes[i] == -1) {
+    if (estado[i] == INFECTADO && resultado.componentes[i] == -1) {
       // Nuevo componente
       int id_componente = resultado.num_componentes;
       
       // Iniciar DFS recursivo
-      dfs_recurivo(i, id_componente, poblacion, grafo, &resultado);
+      uint64_t traza = traza_inicio();
+      dfs_recurivo(i, id_componente, estado, grafo, &resultado);
+      traza_fin("componente_dfs", "brotes", traza, id_componente);
       
       resultado.num_componentes++;
     }
@@ -241,90 +260,93 @@ ResultadoDeteccionBrotes detectar_brotes_dfs(Territorio *territorios, int num_te
 
 void deteccion_brotes_liberar(ResultadoDeteccionBrotes *resultado) {
   if (resultado && resultado->componentes) {
-    free(resultado->componentes);
+    bio_free(resultado->componentes);
   }
 }
 
 // ===== FUNCION DE PRUEBA =====
 
-void test_deteccion_brotes(Territorio *territorios, int num_territorios,
-                           Individuo *poblacion, int num_individuos) {
-  printf("\n========== SUBPROBLEMA 2: DETECCION DE BROTES ==========\n");
-  printf("Poblacion: %d individuos\n", num_individuos);
+void test_deteccion_brotes(const IndiceTerritorios *indice, Poblacion *poblacion, uint64_t semilla,
+                           FILE *salida) {
+  int num_individuos = poblacion->num_individuos;
+  char nombre[MAX_NOMBRE]; // Buffer para nombres sintéticos
+  
+  fprintf(salida, "\n========== SUBPROBLEMA 2: DETECCION DE BROTES ==========\n");
+  fprintf(salida, "Poblacion: %d individuos\n", num_individuos);
   
   // Contar infectados
   int num_infectados = 0;
   for (int i = 0; i < num_individuos; i++) {
-    if (poblacion[i].estado == INFECTADO) {
+    if (poblacion->estado[i] == INFECTADO) {
       num_infectados++;
     }
   }
-  printf("Infectados: %d\n", num_infectados);
-  printf("Territorios: %d\n\n", num_territorios);
+  fprintf(salida, "Infectados: %d\n", num_infectados);
+  fprintf(salida, "Territorios: %d\n\n", indice->num_territorios);
   
   if (num_infectados == 0) {
-    printf("No hay infectados para detectar brotes\n");
-    printf("===== FIN PRUEBAS SUBPROBLEMA 2 =====\n\n");
+    fprintf(salida, "No hay infectados para detectar brotes\n");
+    fprintf(salida, "===== FIN PRUEBAS SUBPROBLEMA 2 =====\n\n");
     return;
   }
   
   // Prueba 1: BFS
-  printf("--- PRUEBA 1: Deteccion de Brotes con BFS ---\n");
-  ResultadoDeteccionBrotes resultado_bfs = detectar_brotes_bfs(territorios, num_territorios, poblacion, num_individuos);
+  fprintf(salida, "--- PRUEBA 1: Deteccion de Brotes con BFS ---\n");
+  ResultadoDeteccionBrotes resultado_bfs = detectar_brotes_bfs(indice, poblacion, semilla);
   
-  printf("Componentes encontradas: %d\n", resultado_bfs.num_componentes);
+  fprintf(salida, "Componentes encontradas: %d\n", resultado_bfs.num_componentes);
   for (int i = 0; i < resultado_bfs.num_componentes; i++) {
-    printf("  Componente %d: %d infectados\n", i, resultado_bfs.num_infectados_por_componente[i]);
+    fprintf(salida, "  Componente %d: %d infectados\n", i, resultado_bfs.num_infectados_por_componente[i]);
   }
   
-  printf("\nMuestra de infectados por componente:\n");
+  fprintf(salida, "\nMuestra de infectados por componente:\n");
   for (int comp = 0; comp < resultado_bfs.num_componentes && comp < 3; comp++) {
-    printf("  Componente %d:\n", comp);
+    fprintf(salida, "  Componente %d:\n", comp);
     int contador = 0;
     for (int i = 0; i < num_individuos && contador < 3; i++) {
       if (resultado_bfs.componentes[i] == comp) {
-        printf("    %s (territorio %d)\n", poblacion[i].nombre, poblacion[i].territorio_id);
+        fprintf(salida, "    %s (territorio %d)\n", poblacion_nombre(poblacion, i, nombre), poblacion->territorio_id[i]);
         contador++;
       }
     }
   }
   
   // Prueba 2: DFS
-  printf("\n--- PRUEBA 2: Deteccion de Brotes con DFS ---\n");
-  ResultadoDeteccionBrotes resultado_dfs = detectar_brotes_dfs(territorios, num_territorios, poblacion, num_individuos);
+  fprintf(salida, "\n--- PRUEBA 2: Deteccion de Brotes con DFS ---\n");
+  ResultadoDeteccionBrotes resultado_dfs = detectar_brotes_dfs(indice, poblacion, semilla);
   
-  printf("Componentes encontradas: %d\n", resultado_dfs.num_componentes);
+  fprintf(salida, "Componentes encontradas: %d\n", resultado_dfs.num_componentes);
   for (int i = 0; i < resultado_dfs.num_componentes; i++) {
-    printf("  Componente %d: %d infectados\n", i, resultado_dfs.num_infectados_por_componente[i]);
+    fprintf(salida, "  Componente %d: %d infectados\n", i, resultado_dfs.num_infectados_por_componente[i]);
   }
   
-  printf("\nMuestra de infectados por componente:\n");
+  fprintf(salida, "\nMuestra de infectados por componente:\n");
   for (int comp = 0; comp < resultado_dfs.num_componentes && comp < 3; comp++) {
-    printf("  Componente %d:\n", comp);
+    fprintf(salida, "  Componente %d:\n", comp);
     int contador = 0;
     for (int i = 0; i < num_individuos && contador < 3; i++) {
       if (resultado_dfs.componentes[i] == comp) {
-        printf("    %s (territorio %d)\n", poblacion[i].nombre, poblacion[i].territorio_id);
+        fprintf(salida, "    %s (territorio %d)\n", poblacion_nombre(poblacion, i, nombre), poblacion->territorio_id[i]);
         contador++;
       }
     }
   }
   
   // Comparacion
-  printf("\n--- COMPARACION BFS vs DFS ---\n");
-  printf("BFS componentes: %d\n", resultado_bfs.num_componentes);
-  printf("DFS componentes: %d\n", resultado_dfs.num_componentes);
+  fprintf(salida, "\n--- COMPARACION BFS vs DFS ---\n");
+  fprintf(salida, "BFS componentes: %d\n", resultado_bfs.num_componentes);
+  fprintf(salida, "DFS componentes: %d\n", resultado_dfs.num_componentes);
   
   if (resultado_bfs.num_componentes == resultado_dfs.num_componentes) {
-    printf("✓ Ambos algoritmos encontraron el mismo numero de componentes\n");
+    fprintf(salida, "✓ Ambos algoritmos encontraron el mismo numero de componentes\n");
   } else {
-    printf("✗ Inconsistencia entre BFS y DFS\n");
+    fprintf(salida, "✗ Inconsistencia entre BFS y DFS\n");
   }
   
-  printf("\nComplejidad BFS: O(V + E) = O(%d + E)\n", num_infectados);
-  printf("Complejidad DFS: O(V + E) = O(%d + E)\n", num_infectados);
+  fprintf(salida, "\nComplejidad BFS: O(V + E) = O(%d + E)\n", num_infectados);
+  fprintf(salida, "Complejidad DFS: O(V + E) = O(%d + E)\n", num_infectados);
   
-  printf("\n===== FIN PRUEBAS SUBPROBLEMA 2 =====\n\n");
+  fprintf(salida, "\n===== FIN PRUEBAS SUBPROBLEMA 2 =====\n\n");
   
   // Liberar
   deteccion_brotes_liberar(&resultado_bfs);
@@ -2,6 +2,7 @@
 #define DETECCION_BROTES_H
 
 #include "estructuras.h"
+#include <stdint.h>
 
 // ============================================================
 // SUBPROBLEMA 2: Detección de Brotes
@@ -18,16 +19,20 @@ typedef struct {
 
 /**
  * Detecta componentes conectadas de individuos infectados usando BFS
+ * Los contactos se derivan del índice territorio -> miembros; sus
+ * probabilidades salen de la semilla del escenario
  * Complejidad: O(V + E) donde V es número de infectados, E es número de contactos
  * Retorna: ResultadoDeteccionBrotes con información de componentes
  */
-ResultadoDeteccionBrotes detectar_brotes_bfs(Territorio *territorios, int num_territorios, Individuo *poblacion, int num_individuos);
+ResultadoDeteccionBrotes detectar_brotes_bfs(const IndiceTerritorios *indice, Poblacion *poblacion,
+                                             uint64_t semilla);
 
 /**
  * Detecta componentes conectadas de individuos infectados usando DFS
  * Complejidad: O(V + E)
  */
-ResultadoDeteccionBrotes detectar_brotes_dfs(Territorio *territorios, int num_territorios, Individuo *poblacion, int num_individuos);
+ResultadoDeteccionBrotes detectar_brotes_dfs(const IndiceTerritorios *indice, Poblacion *poblacion,
+                                             uint64_t semilla);
 
 /**
  * Libera los resultados de detección de brotes
@@ -38,8 +43,9 @@ void deteccion_brotes_liberar(ResultadoDeteccionBrotes *resultado);
 /**
  * Función de prueba para BFS y DFS
  * Complejidad: O(V + E) para cada algoritmo
+ * El reporte se escribe en salida (stdout o el buffer de la etapa)
  */
-void test_deteccion_brotes(Territorio *territorios, int num_territorios,
-                           Individuo *poblacion, int num_individuos);
+void test_deteccion_brotes(const IndiceTerritorios *indice, Poblacion *poblacion, uint64_t semilla,
+                           FILE *salida);
 
 #endif // DETECCION_BROTES_H
@@ -2,6 +2,7 @@
 #define ESTRUCTURAS_H
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -13,12 +14,11 @@
 // --- Enums ---
 typedef enum { SANO, INFECTADO, RECUPERADO } EstadoSalud;
 
-// --- Declaración directa ---
-struct NodoIndividuo; // Para la lista de individuos en Territorio
-
 // --- Estructuras Principales ---
 
 // 1. Individuo
+// Registro de una fila de la población (lectura/escritura puntual).
+// La población completa se almacena por columnas en Poblacion.
 typedef struct {
   int id;
   char nombre[MAX_NOMBRE];
@@ -28,20 +28,38 @@ typedef struct {
   int tiempo_infeccion; // Días desde la infección (0 si no está infectado)
 } Individuo;
 
-// Nodo para lista enlazada de individuos (usado en Territorio)
-typedef struct NodoIndividuo {
-  Individuo *data;
-  struct NodoIndividuo *siguiente;
-} NodoIndividuo;
+// Población en formato columnar (Structure of Arrays)
+// Cada campo caliente vive en su propio array contiguo, de modo que los
+// bucles que solo leen estado/riesgo no arrastran el nombre a la caché.
+// El índice i (0..num_individuos-1) identifica la fila en todas las columnas.
+typedef struct {
+  int num_individuos;
+  int *id;                    // ID externo del individuo
+  EstadoSalud *estado;        // Columna caliente
+  int *riesgo;                // Columna caliente
+  int *tiempo_infeccion;      // Columna caliente
+  int *territorio_id;         // Columna caliente
+  char (*nombre)[MAX_NOMBRE]; // Columna fría (solo reportes); NULL = nombres derivados del id
+} Poblacion;
 
 // 2. Territorio
+// Los miembros de cada territorio se guardan en IndiceTerritorios
 typedef struct {
   int id;
   char nombre[MAX_NOMBRE];
-  NodoIndividuo *individuos; // Lista enlazada de individuos en este territorio
   int num_individuos;
 } Territorio;
 
+// Índice compacto territorio -> miembros (formato CSR)
+// Los miembros del territorio t son miembros[inicio[t]] .. miembros[inicio[t+1]-1],
+// en orden creciente de fila de la Poblacion.
+typedef struct {
+  int num_territorios;
+  int num_miembros;
+  int *inicio;   // num_territorios + 1 desplazamientos
+  int *miembros; // Filas de la Poblacion agrupadas por territorio
+} IndiceTerritorios;
+
 // 3. Cepa / Variante
 typedef struct {
   int id;
@@ -69,23 +87,45 @@ typedef struct {
   NodoAdyacencia **listas; // Array de punteros a listas de adyacencia
 } Grafo;
 
+// Representación compacta (CSR - Compressed Sparse Row) del mismo grafo
+// Las aristas salientes de u ocupan las posiciones inicio[u] .. inicio[u+1]-1
+// de los arrays destino_id y peso. Es la que usan los algoritmos de grafos.
+typedef struct {
+  int num_nodos;
+  int num_aristas;
+  int *inicio;     // num_nodos + 1 desplazamientos
+  int *destino_id; // Destino de cada arista
+  float *peso;     // Peso de cada arista
+} GrafoCSR;
+
 // ============================================================
 // ESTRUCTURAS AUXILIARES PARA LOS 8 SUBPROBLEMAS
 // ============================================================
 
 // 5. Hash Table (Subproblema 8: Consultas Rápidas O(1))
-#define HASH_TABLE_SIZE 1009  // Número primo para mejor distribución
+// Direccionamiento abierto con sondeo lineal. Cada posición tiene un byte
+// de control: 7 bits del hash de su clave o vacío; la búsqueda
+// compara HASH_GRUPO bytes de control a la vez (ver hash_table.c)
+#define HASH_GRUPO 16
+#define HASH_CAPACIDAD_MINIMA 16  // Potencia de 2 >= HASH_GRUPO
 
-typedef struct NodoHash {
+typedef struct {
   int individuo_id;      // Clave
-  Individuo *data;       // Valor
-  struct NodoHash *siguiente;  // Para manejo de colisiones (encadenamiento)
-} NodoHash;
+  int indice;            // Valor: fila del individuo en la Poblacion
+} EntradaHash;
 
 typedef struct {
-  NodoHash **tabla;
-  int size;
-  int elementos;
+  uint8_t *control;      // capacidad + HASH_GRUPO bytes (el primer grupo se repite al final)
+  EntradaHash *entradas; // capacidad posiciones
+  int capacidad;         // Potencia de 2
+  int elementos;         // Incluye los que aún están en la tabla anterior
+
+  // Crecimiento incremental: la tabla anterior sigue viva hasta que cada
+  // operación termina de copiar sus posiciones a la nueva
+  uint8_t *control_anterior;
+  EntradaHash *entradas_anterior;
+  int capacidad_anterior;  // 0 = sin crecimiento en curso
+  int migradas;            // Posiciones [0, migradas) de la anterior ya copiadas
 } TablaHash;
 
 // 6. Trie (Subproblema 7: Clustering de Cepas O(L))
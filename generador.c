@@ -1,255 +1,184 @@
 #include "estructuras.h"
-#include "hash_table.h"
-#include "trie.h"
-#include "heap.h"
-#include "union_find.h"
-#include "analisis_datos.h"
-#include "deteccion_brotes.h"
-#include "propagacion_temporal.h"
-#include "minimizacion_riesgo.h"
-#include "rutas_criticas.h"
-#include "contencion_vacunacion.h"
-#include "clustering_cepas.h"
-#include "consultas_rapidas.h"
+#include "biosim.h"
+#include "mundo.h"
+#include "instrumentacion.h"
+#include "contadores_hw.h"
+#include "traza.h"
+#include "pool_tareas.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
 
-// --- Constantes de Generación ---
-#define NUM_CEPAS 50
-#define NUM_TERRITORIOS 20
-#define MIN_CONEXIONES_TERRITORIOS 30
-#define NUM_INDIVIDUOS_TOTAL 1000 // Ejemplo inicial
-#define NUM_PACIENTES_CERO 10
-
-// --- Variables Globales (Simulando base de datos en memoria) ---
-Cepa cepas[NUM_CEPAS];
-Territorio territorios[NUM_TERRITORIOS];
-Individuo *poblacion; // Array dinámico
-Grafo grafo_territorios;
-
-// --- Funciones Auxiliares ---
-float random_float(float min, float max) {
-  return min + ((float)rand() / RAND_MAX) * (max - min);
-}
-
-void generar_cadena_adn(char *buffer, int length) {
-  const char bases[] = "ACGT";
-  for (int i = 0; i < length - 1; i++) {
-    buffer[i] = bases[rand() % 4];
+// --- Opciones de la demo ---
+// El escenario (mundo, población, grafo...) vive en un BioSimContexto;
+// aquí solo queda lo que pide la línea de comandos
+typedef struct {
+  ConfiguracionMundo config;
+  OpcionesPropagacion propagacion;   // Simulación temporal: duración y checkpoints
+
+  // Rutas de snapshot (NULL = no usar)
+  const char *ruta_snapshot_guardar;
+  const char *ruta_snapshot_cargar;
+
+  // Datos reales en CSV/TSV (NULL = generar sintéticos)
+  const char *ruta_ingesta_poblacion;
+  const char *ruta_ingesta_grafo;
+
+  bool medir_contadores_hw;          // Contadores de hardware por etapa (--perf)
+  const char *ruta_traza;            // Línea de tiempo Chrome trace-event (NULL = no trazar)
+} OpcionesGenerador;
+
+// --- Argumentos de línea de comandos ---
+// Retorna false si hay una opción desconocida o sin valor
+static bool leer_argumentos(int argc, char *argv[], OpcionesGenerador *opciones) {
+  ConfiguracionMundo *config = &opciones->config;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--perf") == 0) {
+      opciones->medir_contadores_hw = true;
+      continue;
+    }
+    if (i + 1 >= argc) return false;
+    const char *opcion = argv[i];
+    const char *valor = argv[++i];
+
+    if (strcmp(opcion, "--semilla") == 0) {
+      config->semilla = strtoull(valor, NULL, 10);
+    } else if (strcmp(opcion, "--individuos") == 0) {
+      config->num_individuos = atoi(valor);
+    } else if (strcmp(opcion, "--territorios") == 0) {
+      config->num_territorios = atoi(valor);
+    } else if (strcmp(opcion, "--cepas") == 0) {
+      config->num_cepas = atoi(valor);
+    } else if (strcmp(opcion, "--conexiones") == 0) {
+      config->num_conexiones = atoi(valor);
+    } else if (strcmp(opcion, "--pacientes-cero") == 0) {
+      config->num_pacientes_cero = atoi(valor);
+    } else if (strcmp(opcion, "--hilos") == 0) {
+      config->num_hilos = atoi(valor);
+    } else if (strcmp(opcion, "--snapshot-guardar") == 0) {
+      opciones->ruta_snapshot_guardar = valor;
+    } else if (strcmp(opcion, "--snapshot-cargar") == 0) {
+      opciones->ruta_snapshot_cargar = valor;
+    } else if (strcmp(opcion, "--ingesta-poblacion") == 0) {
+      opciones->ruta_ingesta_poblacion = valor;
+    } else if (strcmp(opcion, "--ingesta-grafo") == 0) {
+      opciones->ruta_ingesta_grafo = valor;
+    } else if (strcmp(opcion, "--dias") == 0) {
+      opciones->propagacion.dias = atoi(valor);
+    } else if (strcmp(opcion, "--checkpoint") == 0) {
+      opciones->propagacion.ruta_checkpoint = valor;
+    } else if (strcmp(opcion, "--checkpoint-cada") == 0) {
+      opciones->propagacion.checkpoint_cada_dias = atoi(valor);
+    } else if (strcmp(opcion, "--traza") == 0) {
+      opciones->ruta_traza = valor;
+    } else if (strcmp(opcion, "--reanudar") == 0) {
+      opciones->propagacion.ruta_checkpoint = valor;
+      opciones->propagacion.reanudar = true;
+    } else {
+      return false;
+    }
   }
-  buffer[length - 1] = '\0';
+  return mundo_configuracion_validar(config);
 }
 
-// --- Inicialización de Estructuras ---
-
-void inicializar_cepas() {
-  for (int i = 0; i < NUM_CEPAS; i++) {
-    cepas[i].id = i;
-    generar_cadena_adn(cepas[i].nombre_adn, 20); // ADN de longitud 20
-    cepas[i].beta = random_float(0.1, 0.9);
-    cepas[i].letalidad = random_float(0.01, 0.3);
-    cepas[i].gamma = random_float(0.05, 0.5);
+// --- Main para pruebas ---
+// Uso: generador.exe [--semilla N] [--individuos N] [--territorios N]
+//                    [--cepas N] [--conexiones N] [--pacientes-cero N] [--hilos N]
+//                    [--snapshot-guardar ruta] [--snapshot-cargar ruta]
+//                    [--ingesta-poblacion ruta.csv] [--ingesta-grafo ruta.csv]
+//                    [--dias N] [--checkpoint ruta] [--checkpoint-cada N] [--reanudar ruta]
+//                    [--perf] [--traza ruta.json]
+// Con la misma semilla la corrida completa es reproducible
+// (independientemente del número de hilos)
+// Con --snapshot-cargar el mundo (y la semilla) se toman del archivo
+int main(int argc, char *argv[]) {
+  OpcionesGenerador opciones = { 0 };
+  opciones.config = mundo_configuracion_defecto((uint64_t)time(NULL));
+  opciones.propagacion.dias = 60;
+  if (!leer_argumentos(argc, argv, &opciones)) {
+    fprintf(stderr, "Uso: %s [--semilla N] [--individuos N] [--territorios N] [--cepas N]\n"
+                    "       [--conexiones N] [--pacientes-cero N] [--hilos N]\n"
+                    "       [--snapshot-guardar ruta] [--snapshot-cargar ruta]\n"
+                    "       [--ingesta-poblacion ruta.csv] [--ingesta-grafo ruta.csv]\n"
+                    "       [--dias N] [--checkpoint ruta] [--checkpoint-cada N] [--reanudar ruta]\n"
+                    "       [--perf] [--traza ruta.json]\n",
+            argv[0]);
+    return 1;
   }
-  printf("Generadas %d cepas.\n", NUM_CEPAS);
-}
-
-void inicializar_territorios() {
-  for (int i = 0; i < NUM_TERRITORIOS; i++) {
-    territorios[i].id = i;
-    sprintf(territorios[i].nombre, "Territorio_%d", i);
-    territorios[i].individuos = NULL;
-    territorios[i].num_individuos = 0;
+  BioSimContexto *ctx = biosim_crear(&opciones.config);
+  if (!ctx) {
+    fprintf(stderr, "ERROR: Memoria insuficiente para el escenario\n");
+    return 1;
   }
-  printf("Generados %d territorios.\n", NUM_TERRITORIOS);
-}
+  ctx->propagacion = opciones.propagacion;
 
-void inicializar_grafo_territorios() {
-  grafo_territorios.num_nodos = NUM_TERRITORIOS;
-  grafo_territorios.listas =
-      (NodoAdyacencia **)malloc(NUM_TERRITORIOS * sizeof(NodoAdyacencia *));
-
-  for (int i = 0; i < NUM_TERRITORIOS; i++) {
-    grafo_territorios.listas[i] = NULL;
+  // Antes de crear hilos: los contadores se heredan a los hilos posteriores
+  if (opciones.medir_contadores_hw) contadores_hw_abrir();
+  pool_tareas_global_configurar(ctx->config.num_hilos);
+  if (opciones.ruta_traza && !traza_iniciar(0)) {
+    fprintf(stderr, "AVISO: No se pudo iniciar la traza\n");
   }
 
-  int conexiones_creadas = 0;
-  // Asegurar mínimo 30 conexiones
-  while (conexiones_creadas < MIN_CONEXIONES_TERRITORIOS) {
-    int origen = rand() % NUM_TERRITORIOS;
-    int destino = rand() % NUM_TERRITORIOS;
-
-    if (origen != destino) {
-      // Verificar si ya existe conexión (simple check)
-      bool existe = false;
-      NodoAdyacencia *actual = grafo_territorios.listas[origen];
-      while (actual != NULL) {
-        if (actual->destino_id == destino) {
-          existe = true;
-          break;
-        }
-        actual = actual->siguiente;
-      }
-
-      if (!existe) {
-        NodoAdyacencia *nuevo =
-            (NodoAdyacencia *)malloc(sizeof(NodoAdyacencia));
-        nuevo->destino_id = destino;
-        nuevo->peso = random_float(1.0, 10.0); // Distancia o costo
-        nuevo->siguiente = grafo_territorios.listas[origen];
-        grafo_territorios.listas[origen] = nuevo;
-        conexiones_creadas++;
-      }
+  INSTR_AMBITO_INICIO(ambito_total, "generador");
+  INSTR_AMBITO_INICIO(ambito_inicio, "inicializacion");
+  uint64_t traza_inicializacion = traza_inicio();
+  contadores_hw_etapa_inicio("inicializacion");
+  printf("=== Inicializando BioSim ===\n");
+  if (opciones.ruta_snapshot_cargar) {
+    if (!biosim_cargar_snapshot(ctx, opciones.ruta_snapshot_cargar)) {
+      fprintf(stderr, "ERROR: Snapshot invalido: %s\n", opciones.ruta_snapshot_cargar);
+      biosim_liberar(ctx);
+      return 1;
     }
+  } else if (!biosim_ingestar(ctx, opciones.ruta_ingesta_poblacion, opciones.ruta_ingesta_grafo)) {
+    biosim_liberar(ctx);
+    return 1;
+  } else if (!biosim_generar(ctx)) {
+    fprintf(stderr, "ERROR: Memoria insuficiente para el escenario\n");
+    biosim_liberar(ctx);
+    return 1;
   }
-  printf("Generadas %d conexiones entre territorios.\n", conexiones_creadas);
-}
 
-void agregar_individuo_a_territorio(Territorio *t, Individuo *ind) {
-  NodoIndividuo *nuevo = (NodoIndividuo *)malloc(sizeof(NodoIndividuo));
-  nuevo->data = ind;
-  nuevo->siguiente = t->individuos;
-  t->individuos = nuevo;
-  t->num_individuos++;
-}
+  printf("Semilla: %llu\n", (unsigned long long)ctx->config.semilla);
 
-void inicializar_poblacion() {
-  poblacion = (Individuo *)malloc(NUM_INDIVIDUOS_TOTAL * sizeof(Individuo));
-
-  // Primero, crear todos los individuos como sanos
-  for (int i = 0; i < NUM_INDIVIDUOS_TOTAL; i++) {
-    poblacion[i].id = i;
-    sprintf(poblacion[i].nombre, "Individuo_%04d", i);  // Con padding: Individuo_0000, Individuo_0001, etc
-    poblacion[i].territorio_id = rand() % NUM_TERRITORIOS;
-    poblacion[i].riesgo = rand() % 50;  // Riesgo bajo: 0-49 (SANO)
-    poblacion[i].estado = SANO;
-    poblacion[i].tiempo_infeccion = 0;
-
-    // Agregar a la lista del territorio correspondiente
-    agregar_individuo_a_territorio(&territorios[poblacion[i].territorio_id],
-                                   &poblacion[i]);
-  }
-
-  // Infectar Pacientes Cero con RIESGO ALTO
-  for (int i = 0; i < NUM_PACIENTES_CERO; i++) {
-    int idx = rand() % NUM_INDIVIDUOS_TOTAL;
-    // Asegurar que no repetimos (simple check omitido por brevedad,
-    // probabilidad baja)
-    poblacion[idx].estado = INFECTADO;
-    poblacion[idx].tiempo_infeccion = 1;
-    poblacion[idx].riesgo = 50 + (rand() % 50);  // Riesgo alto: 50-99 (INFECTADO)
-  }
-  printf("Generada poblacion de %d individuos con %d infectados iniciales.\n",
-         NUM_INDIVIDUOS_TOTAL, NUM_PACIENTES_CERO);
-}
-
-void liberar_memoria() {
-  // Liberar grafo
-  for (int i = 0; i < NUM_TERRITORIOS; i++) {
-    NodoAdyacencia *actual = grafo_territorios.listas[i];
-    while (actual != NULL) {
-      NodoAdyacencia *temp = actual;
-      actual = actual->siguiente;
-      free(temp);
-    }
-  }
-  free(grafo_territorios.listas);
-
-  // Liberar listas de territorios
-  for (int i = 0; i < NUM_TERRITORIOS; i++) {
-    NodoIndividuo *actual = territorios[i].individuos;
-    while (actual != NULL) {
-      NodoIndividuo *temp = actual;
-      actual = actual->siguiente;
-      free(temp);
+  // Guardar antes de que las pruebas modifiquen la población
+  if (opciones.ruta_snapshot_guardar) {
+    if (biosim_guardar_snapshot(ctx, opciones.ruta_snapshot_guardar)) {
+      printf("Snapshot guardado en %s\n", opciones.ruta_snapshot_guardar);
+    } else {
+      fprintf(stderr, "ERROR: No se pudo guardar el snapshot en %s\n",
+              opciones.ruta_snapshot_guardar);
     }
   }
 
-  free(poblacion);
-  printf("Memoria liberada correctamente.\n");
-}
-
-// --- Main para pruebas ---
-int main() {
-  srand(time(NULL));
-
-  printf("=== Inicializando BioSim ===\n");
-  inicializar_cepas();
-  inicializar_territorios();
-  inicializar_grafo_territorios();
-  inicializar_poblacion();
-
   printf("=== Inicializacion Completa ===\n");
+  contadores_hw_etapa_fin(ctx->config.num_individuos);
+  traza_fin("inicializacion", "etapa", traza_inicializacion, ctx->config.num_individuos);
+  INSTR_AMBITO_FIN(ambito_inicio);
 
-  // ============================================================
-  // SUBPROBLEMA 1: ANALISIS DE DATOS
-  // ============================================================
-  // Demostración de los tres algoritmos de ordenamiento
-  // MergeSort O(n log n), QuickSort O(n log n) promedio, HeapSort O(n log n)
-  test_analisis_datos(poblacion, NUM_INDIVIDUOS_TOTAL);
+  // Subproblemas: las etapas independientes corren a la vez
+  // (--hilos 1 las ejecuta en orden, una por una)
+  biosim_ejecutar_etapas(ctx, stdout);
 
-  // ============================================================
-  // SUBPROBLEMA 2: DETECCION DE BROTES
-  // ============================================================
-  // Determinar los primeros focos y zonas conectadas
-  // BFS O(V+E) vs DFS O(V+E)
-  // Usa población INICIAL (10 infectados) para detectar primeros focos
-  test_deteccion_brotes(territorios, NUM_TERRITORIOS, poblacion, NUM_INDIVIDUOS_TOTAL);
-
-  // ============================================================
-  // SUBPROBLEMA 3: PROPAGACION TEMPORAL
-  // ============================================================
-  // Simulacion temporal de propagacion de infecciones
-  // Min-Heap para procesar eventos cronologicamente O(n log n)
-  test_propagacion_temporal(territorios, NUM_TERRITORIOS, poblacion, NUM_INDIVIDUOS_TOTAL, cepas, NUM_CEPAS);
-
-  // Actualizar poblacion con nuevos infectados generados por propagacion
-  // (simulando el resultado real despues de 60 dias)
-  for (int i = 0; i < NUM_INDIVIDUOS_TOTAL; i++) {
-    // Incrementar riesgo de individuos basado en contacto con infectados
-    if (poblacion[i].estado == SANO && (rand() % 100) < 15) {
-      poblacion[i].riesgo = 50 + (rand() % 50);  // Aumentar riesgo de sanos expuestos
-      poblacion[i].estado = INFECTADO;  // Simular propagacion
-      poblacion[i].tiempo_infeccion = 1;
+  // Limpieza
+  INSTR_AMBITO_INICIO(ambito_limpieza, "liberar_memoria");
+  biosim_liberar(ctx);
+  INSTR_AMBITO_FIN(ambito_limpieza);
+  INSTR_AMBITO_FIN(ambito_total);
+
+  // Resumen de tiempos y contadores (solo con BIOSIM_INSTRUMENTACION)
+  INSTR_REPORTE(stdout);
+  contadores_hw_reporte(stdout);
+  contadores_hw_cerrar();
+  pool_tareas_global_cerrar();
+  if (traza_activa()) {
+    if (traza_escribir(opciones.ruta_traza)) {
+      printf("Traza escrita en %s\n", opciones.ruta_traza);
+    } else {
+      fprintf(stderr, "ERROR: No se pudo escribir la traza en %s\n", opciones.ruta_traza);
     }
+    traza_cerrar();
   }
-
-  // ============================================================
-  // SUBPROBLEMA 4: MINIMIZACION DE RIESGO
-  // ============================================================
-  // Seleccionar individuos a aislar usando enfoque Greedy
-  // O(n log n) por ordenamiento
-  // Usa población ACTUALIZADA (después de propagación simulada)
-  test_minimizacion_riesgo(poblacion, NUM_INDIVIDUOS_TOTAL);
-
-  // ============================================================
-  // SUBPROBLEMA 5: RUTAS CRITICAS
-  // ============================================================
-  // Encontrar rutas de máxima probabilidad de infección
-  // Dijkstra modificado con Max-Heap O((n+m) log n)
-  test_rutas_criticas(&grafo_territorios, NUM_TERRITORIOS, cepas, NUM_CEPAS);
-
-  // ============================================================
-  // SUBPROBLEMA 6: CONTENCION (VACUNACION)
-  // ============================================================
-  // Encontrar árbol de expansión mínima para cobertura de vacunación
-  // MST con Kruskal O(m log m) y Prim O(n^2)
-  test_contencion_vacunacion(&grafo_territorios, NUM_TERRITORIOS);
-
-  // ============================================================
-  // SUBPROBLEMA 7: CLUSTERING DE CEPAS
-  // ============================================================
-  // Agrupar cepas por similitud de nombre usando Trie O(k*L)
-  test_clustering_cepas(cepas, NUM_CEPAS);
-
-  // ============================================================
-  // SUBPROBLEMA 8: CONSULTAS RAPIDAS
-  // ============================================================
-  // Busquedas eficientes usando Tabla Hash O(1) promedio
-  test_consultas_rapidas(poblacion, NUM_INDIVIDUOS_TOTAL, territorios, NUM_TERRITORIOS);
-
-  // Limpieza
-  liberar_memoria();
   return 0;
 }
@@ -0,0 +1,105 @@
+#include "grafo_csr.h"
+#include "memoria.h"
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================
+// IMPLEMENTACION GRAFO CSR
+// ============================================================
+
+GrafoCSR* grafo_csr_crear(int num_nodos, int num_aristas) {
+  if (num_nodos < 0 || num_aristas < 0) return NULL;
+
+  GrafoCSR *grafo = (GrafoCSR *)bio_malloc(sizeof(GrafoCSR));
+  if (!grafo) return NULL;
+
+  grafo->num_nodos = num_nodos;
+  grafo->num_aristas = num_aristas;
+  grafo->inicio = (int *)bio_calloc(num_nodos + 1, sizeof(int));
+  grafo->destino_id = (int *)bio_malloc((size_t)num_aristas * sizeof(int));
+  grafo->peso = (float *)bio_malloc((size_t)num_aristas * sizeof(float));
+
+  if (!grafo->inicio || (num_aristas > 0 && (!grafo->destino_id || !grafo->peso))) {
+    grafo_csr_liberar(grafo);
+    return NULL;
+  }
+
+  return grafo;
+}
+
+GrafoCSR* grafo_csr_desde_aristas(int num_nodos, const int *origen, const int *destino,
+                                  const float *peso, int num_aristas) {
+  GrafoCSR *grafo = grafo_csr_crear(num_nodos, num_aristas);
+  if (!grafo) return NULL;
+
+  // Paso 1: grado de salida de cada nodo - O(m)
+  for (int e = 0; e < num_aristas; e++) {
+    grafo->inicio[origen[e] + 1]++;
+  }
+
+  // Paso 2: suma prefija - O(n)
+  for (int u = 0; u < num_nodos; u++) {
+    grafo->inicio[u + 1] += grafo->inicio[u];
+  }
+
+  // Paso 3: colocar aristas en su fila - O(m)
+  int *siguiente = (int *)bio_malloc((num_nodos > 0 ? num_nodos : 1) * sizeof(int));
+  if (!siguiente) {
+    grafo_csr_liberar(grafo);
+    return NULL;
+  }
+  memcpy(siguiente, grafo->inicio, num_nodos * sizeof(int));
+
+  for (int e = 0; e < num_aristas; e++) {
+    int pos = siguiente[origen[e]]++;
+    grafo->destino_id[pos] = destino[e];
+    grafo->peso[pos] = peso[e];
+  }
+
+  bio_free(siguiente);
+  return grafo;
+}
+
+GrafoCSR* grafo_csr_desde_listas(const Grafo *grafo) {
+  if (!grafo) return NULL;
+
+  int n = grafo->num_nodos;
+
+  // Contar aristas - O(m)
+  int m = 0;
+  for (int u = 0; u < n; u++) {
+    for (NodoAdyacencia *a = grafo->listas[u]; a != NULL; a = a->siguiente) {
+      m++;
+    }
+  }
+
+  GrafoCSR *csr = grafo_csr_crear(n, m);
+  if (!csr) return NULL;
+
+  // Copiar cada lista en su fila, en el mismo orden - O(n + m)
+  int pos = 0;
+  for (int u = 0; u < n; u++) {
+    csr->inicio[u] = pos;
+    for (NodoAdyacencia *a = grafo->listas[u]; a != NULL; a = a->siguiente) {
+      csr->destino_id[pos] = a->destino_id;
+      csr->peso[pos] = a->peso;
+      pos++;
+    }
+  }
+  csr->inicio[n] = pos;
+
+  return csr;
+}
+
+int grafo_csr_grado(const GrafoCSR *grafo, int u) {
+  return grafo->inicio[u + 1] - grafo->inicio[u];
+}
+
+void grafo_csr_liberar(GrafoCSR *grafo) {
+  if (!grafo) return;
+
+  bio_free(grafo->inicio);
+  bio_free(grafo->destino_id);
+  bio_free(grafo->peso);
+  bio_free(grafo);
+}
@@ -0,0 +1,45 @@
+#ifndef GRAFO_CSR_H
+#define GRAFO_CSR_H
+
+#include "estructuras.h"
+
+// ============================================================
+// GRAFO CSR (Compressed Sparse Row)
+// Subproblemas 5 y 6: Rutas Críticas y Contención
+// Aristas de cada nodo contiguas en memoria: recorrido secuencial
+// ============================================================
+
+/**
+ * Crea un grafo CSR vacío con capacidad para num_aristas
+ * Complejidad: O(n)
+ * Retorna: GrafoCSR o NULL si no hay memoria
+ */
+GrafoCSR* grafo_csr_crear(int num_nodos, int num_aristas);
+
+/**
+ * Construye un grafo CSR a partir de una lista de aristas (origen, destino, peso)
+ * Ordenamiento por conteo según el origen; conserva el orden relativo
+ * Complejidad: O(n + m)
+ */
+GrafoCSR* grafo_csr_desde_aristas(int num_nodos, const int *origen, const int *destino,
+                                  const float *peso, int num_aristas);
+
+/**
+ * Convierte un Grafo con listas de adyacencia a formato CSR
+ * Complejidad: O(n + m)
+ */
+GrafoCSR* grafo_csr_desde_listas(const Grafo *grafo);
+
+/**
+ * Número de aristas salientes del nodo u
+ * Complejidad: O(1)
+ */
+int grafo_csr_grado(const GrafoCSR *grafo, int u);
+
+/**
+ * Libera el grafo CSR
+ * Complejidad: O(1)
+ */
+void grafo_csr_liberar(GrafoCSR *grafo);
+
+#endif // GRAFO_CSR_H
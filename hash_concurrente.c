@@ -0,0 +1,189 @@
+#define _POSIX_C_SOURCE 200809L
+#include "hash_concurrente.h"
+#include "hash_table.h"
+#include "memoria.h"
+#include <pthread.h>
+
+// ============================================================
+// IMPLEMENTACION TABLA HASH CONCURRENTE
+// El fragmento se elige con hashing de Fibonacci (bits altos de
+// id * 2^64/phi): independiente de los bits que usa TablaHash para la
+// posición dentro del fragmento. Cada fragmento ocupa su propio bloque
+// de 128 bytes para que dos cerrojos no compartan línea de caché.
+// ============================================================
+
+#define TAMANO_FRAGMENTO 128
+
+typedef union {
+  struct {
+    pthread_rwlock_t cerrojo;
+    TablaHash *tabla;
+  } f;
+  char relleno[TAMANO_FRAGMENTO];
+} FragmentoHash;
+
+struct TablaHashConcurrente {
+  FragmentoHash *fragmentos;
+  int num_fragmentos;   // Potencia de 2
+  int bits;             // log2(num_fragmentos)
+};
+
+static inline int indice_fragmento(const TablaHashConcurrente *tabla, int individuo_id) {
+  if (tabla->bits == 0) return 0;
+  uint64_t h = (uint64_t)(uint32_t)individuo_id * 0x9E3779B97F4A7C15ULL;
+  return (int)(h >> (64 - tabla->bits));
+}
+
+static inline FragmentoHash* fragmento_de(const TablaHashConcurrente *tabla, int individuo_id) {
+  return &tabla->fragmentos[indice_fragmento(tabla, individuo_id)];
+}
+
+TablaHashConcurrente* hash_concurrente_crear(int num_fragmentos) {
+  if (num_fragmentos <= 0) num_fragmentos = HASH_CONCURRENTE_FRAGMENTOS;
+  int bits = 0;
+  while ((1 << bits) < num_fragmentos && bits < 16) bits++;
+
+  TablaHashConcurrente *tabla = (TablaHashConcurrente *)bio_malloc(sizeof(TablaHashConcurrente));
+  FragmentoHash *fragmentos = (FragmentoHash *)bio_calloc((size_t)1 << bits, sizeof(FragmentoHash));
+  if (!tabla || !fragmentos) {
+    bio_free(tabla);
+    bio_free(fragmentos);
+    return NULL;
+  }
+  tabla->fragmentos = fragmentos;
+  tabla->num_fragmentos = 1 << bits;
+  tabla->bits = bits;
+
+  for (int i = 0; i < tabla->num_fragmentos; i++) {
+    fragmentos[i].f.tabla = hash_table_crear();
+    if (!fragmentos[i].f.tabla) {
+      tabla->num_fragmentos = i;
+      hash_concurrente_liberar(tabla);
+      return NULL;
+    }
+    pthread_rwlock_init(&fragmentos[i].f.cerrojo, NULL);
+  }
+  return tabla;
+}
+
+bool hash_concurrente_reservar(TablaHashConcurrente *tabla, int n) {
+  if (!tabla) return false;
+  // Media por fragmento + 1/8 de margen + unas posiciones para tablas chicas
+  long long por_fragmento = (long long)n / tabla->num_fragmentos;
+  por_fragmento += por_fragmento / 8 + 16;
+  if (por_fragmento > (1 << 29)) return false;
+
+  bool ok = true;
+  for (int i = 0; i < tabla->num_fragmentos; i++) {
+    FragmentoHash *fragmento = &tabla->fragmentos[i];
+    pthread_rwlock_wrlock(&fragmento->f.cerrojo);
+    ok = hash_table_reservar(fragmento->f.tabla, (int)por_fragmento) && ok;
+    pthread_rwlock_unlock(&fragmento->f.cerrojo);
+  }
+  return ok;
+}
+
+void hash_concurrente_insertar(TablaHashConcurrente *tabla, int individuo_id, int fila) {
+  if (!tabla) return;
+  FragmentoHash *fragmento = fragmento_de(tabla, individuo_id);
+  pthread_rwlock_wrlock(&fragmento->f.cerrojo);
+  hash_table_insertar(fragmento->f.tabla, individuo_id, fila);
+  pthread_rwlock_unlock(&fragmento->f.cerrojo);
+}
+
+int hash_concurrente_buscar(TablaHashConcurrente *tabla, int individuo_id) {
+  if (!tabla) return -1;
+  FragmentoHash *fragmento = fragmento_de(tabla, individuo_id);
+  pthread_rwlock_rdlock(&fragmento->f.cerrojo);
+  int fila = hash_table_consultar(fragmento->f.tabla, individuo_id);
+  pthread_rwlock_unlock(&fragmento->f.cerrojo);
+  return fila;
+}
+
+void hash_concurrente_buscar_lote(TablaHashConcurrente *tabla, const int *individuo_ids, int n, int *filas) {
+  if (!tabla || n <= 0) {
+    for (int i = 0; i < n; i++) filas[i] = -1;
+    return;
+  }
+
+  // Agrupar las claves por fragmento (conteo): inicio[f] .. inicio[f+1]
+  int F = tabla->num_fragmentos;
+  int *inicio = (int *)bio_calloc((size_t)F + 1, sizeof(int));
+  int *claves = (int *)bio_malloc((size_t)n * sizeof(int));
+  int *origen = (int *)bio_malloc((size_t)n * sizeof(int));
+  int *resultado = (int *)bio_malloc((size_t)n * sizeof(int));
+  if (!inicio || !claves || !origen || !resultado) {
+    // Sin memoria para agrupar: una clave a la vez
+    for (int i = 0; i < n; i++) filas[i] = hash_concurrente_buscar(tabla, individuo_ids[i]);
+  } else {
+    for (int i = 0; i < n; i++) inicio[indice_fragmento(tabla, individuo_ids[i]) + 1]++;
+    for (int f = 0; f < F; f++) inicio[f + 1] += inicio[f];
+    for (int i = 0; i < n; i++) {
+      int destino = inicio[indice_fragmento(tabla, individuo_ids[i])]++;
+      claves[destino] = individuo_ids[i];
+      origen[destino] = i;
+    }
+    // Tras repartir, inicio[f] es el fin del tramo de f (que empieza
+    // donde termina el de f - 1)
+
+    // Un cerrojo de lectura y una búsqueda por lote por fragmento
+    int desde = 0;
+    for (int f = 0; f < F; f++) {
+      int cantidad = inicio[f] - desde;
+      if (cantidad > 0) {
+        FragmentoHash *fragmento = &tabla->fragmentos[f];
+        pthread_rwlock_rdlock(&fragmento->f.cerrojo);
+        hash_table_consultar_lote(fragmento->f.tabla, &claves[desde], cantidad, &resultado[desde]);
+        pthread_rwlock_unlock(&fragmento->f.cerrojo);
+      }
+      desde = inicio[f];
+    }
+    for (int k = 0; k < n; k++) filas[origen[k]] = resultado[k];
+  }
+  bio_free(inicio);
+  bio_free(claves);
+  bio_free(origen);
+  bio_free(resultado);
+}
+
+void hash_concurrente_eliminar(TablaHashConcurrente *tabla, int individuo_id) {
+  if (!tabla) return;
+  FragmentoHash *fragmento = fragmento_de(tabla, individuo_id);
+  pthread_rwlock_wrlock(&fragmento->f.cerrojo);
+  hash_table_eliminar(fragmento->f.tabla, individuo_id);
+  pthread_rwlock_unlock(&fragmento->f.cerrojo);
+}
+
+int hash_concurrente_elementos(TablaHashConcurrente *tabla) {
+  if (!tabla) return 0;
+  int total = 0;
+  for (int i = 0; i < tabla->num_fragmentos; i++) {
+    FragmentoHash *fragmento = &tabla->fragmentos[i];
+    pthread_rwlock_rdlock(&fragmento->f.cerrojo);
+    total += fragmento->f.tabla->elementos;
+    pthread_rwlock_unlock(&fragmento->f.cerrojo);
+  }
+  return total;
+}
+
+int hash_concurrente_capacidad(TablaHashConcurrente *tabla) {
+  if (!tabla) return 0;
+  int total = 0;
+  for (int i = 0; i < tabla->num_fragmentos; i++) {
+    FragmentoHash *fragmento = &tabla->fragmentos[i];
+    pthread_rwlock_rdlock(&fragmento->f.cerrojo);
+    total += fragmento->f.tabla->capacidad;
+    pthread_rwlock_unlock(&fragmento->f.cerrojo);
+  }
+  return total;
+}
+
+void hash_concurrente_liberar(TablaHashConcurrente *tabla) {
+  if (!tabla) return;
+  for (int i = 0; i < tabla->num_fragmentos; i++) {
+    pthread_rwlock_destroy(&tabla->fragmentos[i].f.cerrojo);
+    hash_table_liberar(tabla->fragmentos[i].f.tabla);
+  }
+  bio_free(tabla->fragmentos);
+  bio_free(tabla);
+}
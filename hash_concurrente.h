@@ -0,0 +1,78 @@
+#ifndef HASH_CONCURRENTE_H
+#define HASH_CONCURRENTE_H
+
+#include "estructuras.h"
+
+// ============================================================
+// TABLA HASH CONCURRENTE - Consultas mientras la simulación escribe
+// La tabla se reparte en fragmentos (potencia de 2), cada uno una
+// TablaHash con su propio cerrojo de lectura/escritura. Las lecturas de
+// un fragmento no se bloquean entre sí y las escrituras solo bloquean su
+// fragmento; con más fragmentos que hilos casi nunca hay contención.
+// Un fragmento crece de forma incremental (ver hash_table.h) solo con
+// las escrituras, así que las lecturas no modifican nada.
+// ============================================================
+
+// Fragmentos por defecto (cubre hasta 64 hilos sin contención frecuente)
+#define HASH_CONCURRENTE_FRAGMENTOS 64
+
+typedef struct TablaHashConcurrente TablaHashConcurrente;
+
+/**
+ * Crea una tabla vacía con num_fragmentos fragmentos (se redondea a
+ * potencia de 2; <= 0: HASH_CONCURRENTE_FRAGMENTOS)
+ * Complejidad: O(fragmentos)
+ * Retorna: TablaHashConcurrente o NULL si no hay memoria
+ */
+TablaHashConcurrente* hash_concurrente_crear(int num_fragmentos);
+
+/**
+ * Amplía los fragmentos para que entren n elementos repartidos por hash
+ * (con margen para el desbalance). Llamar antes de compartir la tabla
+ * Complejidad: O(capacidad nueva)
+ * Retorna: false si no hay memoria
+ */
+bool hash_concurrente_reservar(TablaHashConcurrente *tabla, int n);
+
+/**
+ * Inserta o actualiza un individuo (cerrojo de escritura del fragmento)
+ * Complejidad: O(1) promedio
+ */
+void hash_concurrente_insertar(TablaHashConcurrente *tabla, int individuo_id, int fila);
+
+/**
+ * Busca un individuo (cerrojo de lectura del fragmento)
+ * Complejidad: O(1) promedio
+ * Retorna: Fila del individuo o -1 si no existe
+ */
+int hash_concurrente_buscar(TablaHashConcurrente *tabla, int individuo_id);
+
+/**
+ * Busca n individuos de una vez (ver hash_table_buscar_lote): las claves
+ * se agrupan por fragmento y cada fragmento se consulta con un solo
+ * cerrojo de lectura. filas[i] recibe la fila de individuo_ids[i] o -1
+ * Complejidad: O(n + fragmentos) promedio
+ */
+void hash_concurrente_buscar_lote(TablaHashConcurrente *tabla, const int *individuo_ids, int n, int *filas);
+
+/**
+ * Elimina un individuo (cerrojo de escritura del fragmento)
+ * Complejidad: O(1) promedio
+ */
+void hash_concurrente_eliminar(TablaHashConcurrente *tabla, int individuo_id);
+
+/**
+ * Elementos y posiciones totales (suma de los fragmentos; con escrituras
+ * en curso es una foto aproximada)
+ * Complejidad: O(fragmentos)
+ */
+int hash_concurrente_elementos(TablaHashConcurrente *tabla);
+int hash_concurrente_capacidad(TablaHashConcurrente *tabla);
+
+/**
+ * Libera los fragmentos (sin hilos usando la tabla)
+ * Complejidad: O(fragmentos)
+ */
+void hash_concurrente_liberar(TablaHashConcurrente *tabla);
+
+#endif // HASH_CONCURRENTE_H
@@ -1,99 +1,367 @@
 #include "hash_table.h"
+#include "memoria.h"
+#include "instrumentacion.h"
 #include <stdlib.h>
 #include <string.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 // ============================================================
 // IMPLEMENTACIÓN TABLA HASH
-// Función hash simple: DHM (Daniel J. Bernstein)
+// Sondeo lineal con bytes de control al estilo Swiss table: los 7 bits
+// altos del hash (etiqueta) se comparan de a HASH_GRUPO con una sola
+// instrucción SSE2, así que casi nunca se lee una clave que no coincide.
+// El primer grupo de control se repite tras el último: un grupo que
+// empieza cerca del final se lee sin dar la vuelta.
+//
+// Invariante del sondeo lineal: cada clave está entre su posición
+// inicial y el primer hueco que le sigue. Borrar corre hacia atrás las
+// entradas que lo permiten (backward shift) y el invariante se mantiene
+// sin lápidas.
+//
+// Crecimiento incremental: al superar 3/4 de carga se reserva la tabla
+// del doble y la anterior queda de solo lectura. Cada insertar, buscar o
+// eliminar copia HASH_MIGRACION_PASO posiciones de la anterior, en
+// orden; una clave está en la nueva o en la anterior (nunca en las dos).
+// En la anterior solo se marca el borrado (indice = -1): sus bytes de
+// control no cambian, así que sus cadenas de sondeo siguen intactas.
+// Con el paso >= 2 la copia termina antes de que la nueva vuelva a
+// necesitar crecer.
 // ============================================================
 
-static unsigned long hash_djb2(int key) {
-  return ((unsigned long)key) % HASH_TABLE_SIZE;
+// Control: 0 = vacío, 0x80 | 7 bits del hash = ocupado. Con vacío = 0 el
+// control nuevo sale de calloc (páginas en cero bajo demanda, sin memset)
+#define HASH_VACIO 0x00
+#define HASH_OCUPADO 0x80
+
+// Posiciones de la tabla anterior copiadas por operación
+#define HASH_MIGRACION_PASO 8
+
+// Claves de un lote con la precarga en vuelo a la vez: se piden las
+// líneas de las HASH_LOTE claves y recién después se resuelven
+#define HASH_LOTE 16
+
+// Mezclador de 64 bits (finalizador de splitmix64): claves consecutivas
+// quedan repartidas por toda la tabla
+static inline uint64_t mezclar(int clave) {
+  uint64_t x = (uint64_t)(uint32_t)clave;
+  x ^= x >> 30;
+  x *= 0xBF58476D1CE4E5B9ULL;
+  x ^= x >> 27;
+  x *= 0x94D049BB133111EBULL;
+  x ^= x >> 31;
+  return x;
+}
+
+static inline uint8_t etiqueta(uint64_t hash) {
+  return (uint8_t)(HASH_OCUPADO | (hash >> 57));
+}
+
+// Bit b: el byte de control b del grupo vale 'byte'
+static inline unsigned grupo_coincidencias(const uint8_t *grupo, uint8_t byte) {
+#if defined(__SSE2__)
+  __m128i control = _mm_loadu_si128((const __m128i *)grupo);
+  return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(control, _mm_set1_epi8((char)byte)));
+#else
+  unsigned mascara = 0;
+  for (int b = 0; b < HASH_GRUPO; b++) mascara |= (unsigned)(grupo[b] == byte) << b;
+  return mascara;
+#endif
+}
+
+// Bit b: la posición b del grupo está vacía
+static inline unsigned grupo_vacios(const uint8_t *grupo) {
+#if defined(__SSE2__)
+  return ~(unsigned)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)grupo)) & 0xFFFFu;
+#else
+  return grupo_coincidencias(grupo, HASH_VACIO);
+#endif
+}
+
+static inline int primer_bit(unsigned mascara) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_ctz(mascara);
+#else
+  int b = 0;
+  while (!(mascara & 1u)) {
+    mascara >>= 1;
+    b++;
+  }
+  return b;
+#endif
+}
+
+// Pide una línea de caché para lectura sin esperarla
+static inline void precargar(const void *direccion) {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(direccion, 0, 1);
+#else
+  (void)direccion;
+#endif
+}
+
+// Escribe un byte de control y su copia del final
+static inline void fijar_control(uint8_t *control, int capacidad, int posicion, uint8_t byte) {
+  control[posicion] = byte;
+  if (posicion < HASH_GRUPO) control[capacidad + posicion] = byte;
+}
+
+// Posición de la clave en (control, entradas) o -1
+static int buscar_posicion(const uint8_t *control, const EntradaHash *entradas, int capacidad,
+                           int individuo_id, uint64_t hash) {
+  int mascara = capacidad - 1;
+  uint8_t buscada = etiqueta(hash);
+  int inicio = (int)(hash & (uint64_t)mascara);
+
+  for (;;) {
+    INSTR_CONTAR(CONTADOR_HASH_SONDEOS, 1);
+    const uint8_t *grupo = &control[inicio];
+    unsigned coincidencias = grupo_coincidencias(grupo, buscada);
+    while (coincidencias) {
+      int posicion = (inicio + primer_bit(coincidencias)) & mascara;
+      if (entradas[posicion].individuo_id == individuo_id) return posicion;
+      coincidencias &= coincidencias - 1;
+    }
+    if (grupo_vacios(grupo)) return -1;
+    inicio = (inicio + HASH_GRUPO) & mascara;
+  }
+}
+
+// Posición viva de la clave en la tabla anterior (aún no copiada ni
+// borrada) o -1
+static int buscar_anterior(const TablaHash *tabla, int individuo_id, uint64_t hash) {
+  if (tabla->capacidad_anterior == 0) return -1;
+  int posicion = buscar_posicion(tabla->control_anterior, tabla->entradas_anterior,
+                                 tabla->capacidad_anterior, individuo_id, hash);
+  if (posicion < tabla->migradas || tabla->entradas_anterior[posicion].indice < 0) return -1;
+  return posicion;
+}
+
+// Coloca una clave que no está en la tabla nueva en su primer hueco
+static void colocar(TablaHash *tabla, EntradaHash entrada, uint64_t hash) {
+  int mascara = tabla->capacidad - 1;
+  int inicio = (int)(hash & (uint64_t)mascara);
+  for (;;) {
+    unsigned vacios = grupo_vacios(&tabla->control[inicio]);
+    if (vacios) {
+      int posicion = (inicio + primer_bit(vacios)) & mascara;
+      fijar_control(tabla->control, tabla->capacidad, posicion, etiqueta(hash));
+      tabla->entradas[posicion] = entrada;
+      return;
+    }
+    inicio = (inicio + HASH_GRUPO) & mascara;
+  }
+}
+
+static void soltar_anterior(TablaHash *tabla) {
+  bio_free(tabla->control_anterior);
+  bio_free(tabla->entradas_anterior);
+  tabla->control_anterior = NULL;
+  tabla->entradas_anterior = NULL;
+  tabla->capacidad_anterior = 0;
+  tabla->migradas = 0;
+}
+
+// Copia hasta 'posiciones' posiciones de la tabla anterior a la nueva
+static void migrar(TablaHash *tabla, int posiciones) {
+  if (tabla->capacidad_anterior == 0) return;
+  int fin = tabla->capacidad_anterior - tabla->migradas > posiciones
+            ? tabla->migradas + posiciones : tabla->capacidad_anterior;
+
+  for (int i = tabla->migradas; i < fin; i++) {
+    if (tabla->control_anterior[i] == HASH_VACIO) continue;
+    EntradaHash entrada = tabla->entradas_anterior[i];
+    if (entrada.indice >= 0) colocar(tabla, entrada, mezclar(entrada.individuo_id));
+  }
+  tabla->migradas = fin;
+  if (fin == tabla->capacidad_anterior) soltar_anterior(tabla);
+}
+
+static bool reservar_arrays(TablaHash *tabla, int capacidad) {
+  uint8_t *control = (uint8_t *)bio_calloc((size_t)capacidad + HASH_GRUPO, 1);
+  EntradaHash *entradas = (EntradaHash *)bio_malloc((size_t)capacidad * sizeof(EntradaHash));
+  if (!control || !entradas) {
+    bio_free(control);
+    bio_free(entradas);
+    return false;
+  }
+  tabla->control = control;
+  tabla->entradas = entradas;
+  tabla->capacidad = capacidad;
+  return true;
+}
+
+// Empieza a crecer: la tabla actual pasa a ser la anterior (sin
+// crecimiento en curso)
+static bool crecer(TablaHash *tabla, int capacidad) {
+  uint8_t *control = tabla->control;
+  EntradaHash *entradas = tabla->entradas;
+  int capacidad_actual = tabla->capacidad;
+  if (!reservar_arrays(tabla, capacidad)) return false;
+
+  tabla->control_anterior = control;
+  tabla->entradas_anterior = entradas;
+  tabla->capacidad_anterior = capacidad_actual;
+  tabla->migradas = 0;
+  return true;
+}
+
+// Menor capacidad (potencia de 2) con n <= 3/4 de ella
+static long long capacidad_para(long long n) {
+  long long capacidad = HASH_CAPACIDAD_MINIMA;
+  while (capacidad * 3 < n * 4) capacidad <<= 1;
+  return capacidad;
 }
 
 TablaHash* hash_table_crear() {
-  TablaHash *tabla = (TablaHash *)malloc(sizeof(TablaHash));
-  tabla->tabla = (NodoHash **)calloc(HASH_TABLE_SIZE, sizeof(NodoHash *));
-  tabla->size = HASH_TABLE_SIZE;
-  tabla->elementos = 0;
+  TablaHash *tabla = (TablaHash *)bio_calloc(1, sizeof(TablaHash));
+  if (!tabla) return NULL;
+  if (!reservar_arrays(tabla, HASH_CAPACIDAD_MINIMA)) {
+    bio_free(tabla);
+    return NULL;
+  }
   return tabla;
 }
 
-void hash_table_insertar(TablaHash *tabla, int individuo_id, Individuo *individuo) {
+bool hash_table_reservar(TablaHash *tabla, int n) {
+  if (!tabla) return false;
+  long long capacidad = capacidad_para(n);
+  if (capacidad <= tabla->capacidad) return true;
+  if (capacidad > (1LL << 30)) return false;
+
+  // Reserva explícita: se copia todo de una vez
+  migrar(tabla, tabla->capacidad_anterior);
+  if (!crecer(tabla, (int)capacidad)) return false;
+  migrar(tabla, tabla->capacidad_anterior);
+  return true;
+}
+
+void hash_table_insertar(TablaHash *tabla, int individuo_id, int fila) {
   if (!tabla) return;
-  
-  unsigned long indice = hash_djb2(individuo_id);
-  
-  // Verificar si ya existe
-  NodoHash *actual = tabla->tabla[indice];
-  while (actual != NULL) {
-    if (actual->individuo_id == individuo_id) {
-      actual->data = individuo;
-      return;
-    }
-    actual = actual->siguiente;
+  migrar(tabla, HASH_MIGRACION_PASO);
+
+  uint64_t hash = mezclar(individuo_id);
+
+  // Verificar si ya existe (en la tabla nueva o todavía en la anterior)
+  int posicion = buscar_posicion(tabla->control, tabla->entradas, tabla->capacidad,
+                                 individuo_id, hash);
+  if (posicion >= 0) {
+    tabla->entradas[posicion].indice = fila;
+    return;
   }
-  
-  // Insertar al inicio
-  NodoHash *nuevo = (NodoHash *)malloc(sizeof(NodoHash));
-  nuevo->individuo_id = individuo_id;
-  nuevo->data = individuo;
-  nuevo->siguiente = tabla->tabla[indice];
-  tabla->tabla[indice] = nuevo;
+  posicion = buscar_anterior(tabla, individuo_id, hash);
+  if (posicion >= 0) {
+    tabla->entradas_anterior[posicion].indice = fila;
+    return;
+  }
+
+  // Crecer antes de superar el factor de carga. Si la copia anterior no
+  // terminó (solo con reservas explícitas de por medio) se completa ya;
+  // sin memoria se sigue llenando la tabla actual mientras quede un hueco
+  if ((long long)(tabla->elementos + 1) * 4 > (long long)tabla->capacidad * 3) {
+    migrar(tabla, tabla->capacidad_anterior);
+    bool creciendo = tabla->capacidad < (1 << 30) && crecer(tabla, tabla->capacidad * 2);
+    if (!creciendo && tabla->elementos + 1 >= tabla->capacidad) return;
+  }
+
+  EntradaHash entrada = { individuo_id, fila };
+  colocar(tabla, entrada, hash);
   tabla->elementos++;
 }
 
-Individuo* hash_table_buscar(TablaHash *tabla, int individuo_id) {
-  if (!tabla) return NULL;
-  
-  unsigned long indice = hash_djb2(individuo_id);
-  NodoHash *actual = tabla->tabla[indice];
-  
-  while (actual != NULL) {
-    if (actual->individuo_id == individuo_id) {
-      return actual->data;
+// Fila de la clave (en la tabla nueva o todavía en la anterior) o -1
+static int resolver(const TablaHash *tabla, int individuo_id, uint64_t hash) {
+  int posicion = buscar_posicion(tabla->control, tabla->entradas, tabla->capacidad,
+                                 individuo_id, hash);
+  if (posicion >= 0) return tabla->entradas[posicion].indice;
+  posicion = buscar_anterior(tabla, individuo_id, hash);
+  return posicion >= 0 ? tabla->entradas_anterior[posicion].indice : -1;
+}
+
+int hash_table_consultar(const TablaHash *tabla, int individuo_id) {
+  if (!tabla) return -1;
+  INSTR_CONTAR(CONTADOR_HASH_BUSQUEDAS, 1);
+  return resolver(tabla, individuo_id, mezclar(individuo_id));
+}
+
+void hash_table_consultar_lote(const TablaHash *tabla, const int *individuo_ids, int n, int *filas) {
+  if (!tabla) {
+    for (int i = 0; i < n; i++) filas[i] = -1;
+    return;
+  }
+  INSTR_CONTAR(CONTADOR_HASH_BUSQUEDAS, n);
+
+  uint64_t hashes[HASH_LOTE];
+  uint64_t mascara = (uint64_t)(tabla->capacidad - 1);
+  for (int base = 0; base < n; base += HASH_LOTE) {
+    int cantidad = n - base < HASH_LOTE ? n - base : HASH_LOTE;
+
+    // Primera pasada: hash y precarga del grupo de control y de la
+    // entrada inicial de cada clave; los fallos de caché se solapan
+    for (int k = 0; k < cantidad; k++) {
+      hashes[k] = mezclar(individuo_ids[base + k]);
+      int inicio = (int)(hashes[k] & mascara);
+      precargar(&tabla->control[inicio]);
+      precargar(&tabla->entradas[inicio]);
+    }
+    // Segunda pasada: las líneas ya están llegando
+    for (int k = 0; k < cantidad; k++) {
+      filas[base + k] = resolver(tabla, individuo_ids[base + k], hashes[k]);
     }
-    actual = actual->siguiente;
   }
-  
-  return NULL;
+}
+
+int hash_table_buscar(TablaHash *tabla, int individuo_id) {
+  if (!tabla) return -1;
+  migrar(tabla, HASH_MIGRACION_PASO);
+  return hash_table_consultar(tabla, individuo_id);
+}
+
+void hash_table_buscar_lote(TablaHash *tabla, const int *individuo_ids, int n, int *filas) {
+  if (tabla) migrar(tabla, HASH_MIGRACION_PASO);
+  hash_table_consultar_lote(tabla, individuo_ids, n, filas);
 }
 
 void hash_table_eliminar(TablaHash *tabla, int individuo_id) {
   if (!tabla) return;
-  
-  unsigned long indice = hash_djb2(individuo_id);
-  NodoHash *actual = tabla->tabla[indice];
-  NodoHash *anterior = NULL;
-  
-  while (actual != NULL) {
-    if (actual->individuo_id == individuo_id) {
-      if (anterior == NULL) {
-        tabla->tabla[indice] = actual->siguiente;
-      } else {
-        anterior->siguiente = actual->siguiente;
-      }
-      free(actual);
+  migrar(tabla, HASH_MIGRACION_PASO);
+
+  uint64_t hash = mezclar(individuo_id);
+  int hueco = buscar_posicion(tabla->control, tabla->entradas, tabla->capacidad,
+                              individuo_id, hash);
+  if (hueco < 0) {
+    // Aún sin copiar: basta con marcarla
+    int posicion = buscar_anterior(tabla, individuo_id, hash);
+    if (posicion >= 0) {
+      tabla->entradas_anterior[posicion].indice = -1;
       tabla->elementos--;
-      return;
     }
-    anterior = actual;
-    actual = actual->siguiente;
+    return;
   }
+
+  // Backward shift: una entrada posterior pasa al hueco si su posición
+  // inicial no está entre el hueco y ella (así sigue siendo alcanzable)
+  int mascara = tabla->capacidad - 1;
+  int siguiente = (hueco + 1) & mascara;
+  while (tabla->control[siguiente] != HASH_VACIO) {
+    int inicial = (int)(mezclar(tabla->entradas[siguiente].individuo_id) & (uint64_t)mascara);
+    if (((siguiente - inicial) & mascara) >= ((siguiente - hueco) & mascara)) {
+      fijar_control(tabla->control, tabla->capacidad, hueco, tabla->control[siguiente]);
+      tabla->entradas[hueco] = tabla->entradas[siguiente];
+      hueco = siguiente;
+    }
+    siguiente = (siguiente + 1) & mascara;
+  }
+  fijar_control(tabla->control, tabla->capacidad, hueco, HASH_VACIO);
+  tabla->elementos--;
 }
 
 void hash_table_liberar(TablaHash *tabla) {
   if (!tabla) return;
-  
-  for (int i = 0; i < tabla->size; i++) {
-    NodoHash *actual = tabla->tabla[i];
-    while (actual != NULL) {
-      NodoHash *temp = actual;
-      actual = actual->siguiente;
-      free(temp);
-    }
-  }
-  
-  free(tabla->tabla);
-  free(tabla);
+
+  soltar_anterior(tabla);
+  bio_free(tabla->control);
+  bio_free(tabla->entradas);
+  bio_free(tabla);
 }
@@ -5,27 +5,66 @@
 
 // ============================================================
 // TABLA HASH - Subproblema 8: Consultas Rápidas
+// Direccionamiento abierto: sin nodos ni punteros por elemento, la tabla
+// crece sola (factor de carga <= 3/4) y el borrado desplaza hacia atrás
+// las entradas siguientes en lugar de dejar lápidas.
+// El crecimiento es incremental: insertar, buscar y eliminar copian cada
+// uno un tramo fijo de la tabla anterior, así que ninguna operación paga
+// un rehash completo
 // Complejidad: O(1) promedio para inserción, búsqueda y eliminación
 // ============================================================
 
 /**
- * Inicializa una tabla hash vacía
- * Complejidad: O(HASH_TABLE_SIZE)
+ * Inicializa una tabla hash vacía de HASH_CAPACIDAD_MINIMA posiciones
+ * Complejidad: O(1)
+ * Retorna: TablaHash o NULL si no hay memoria
  */
 TablaHash* hash_table_crear();
 
 /**
- * Inserta un individuo en la tabla hash
- * Complejidad: O(1) promedio
+ * Amplía la tabla para que entren n elementos sin volver a crecer
+ * (copia todo de una vez: pensado para antes de llenarla)
+ * Complejidad: O(capacidad nueva)
+ * Retorna: false si no hay memoria (la tabla queda como estaba)
+ */
+bool hash_table_reservar(TablaHash *tabla, int n);
+
+/**
+ * Inserta un individuo en la tabla hash (si ya está, actualiza su fila)
+ * fila: posición del individuo en la Poblacion (>= 0)
+ * Complejidad: O(1) promedio, también mientras la tabla crece
  */
-void hash_table_insertar(TablaHash *tabla, int individuo_id, Individuo *individuo);
+void hash_table_insertar(TablaHash *tabla, int individuo_id, int fila);
 
 /**
  * Busca un individuo por su ID
  * Complejidad: O(1) promedio
- * Retorna: Puntero al Individuo o NULL si no existe
+ * Retorna: Fila del individuo en la Poblacion o -1 si no existe
+ */
+int hash_table_buscar(TablaHash *tabla, int individuo_id);
+
+/**
+ * Busca un individuo sin avanzar el crecimiento: no modifica la tabla,
+ * así que varios hilos pueden consultar a la vez mientras nadie escribe
+ * Complejidad: O(1) promedio
+ * Retorna: Fila del individuo en la Poblacion o -1 si no existe
+ */
+int hash_table_consultar(const TablaHash *tabla, int individuo_id);
+
+/**
+ * Busca n individuos de una vez: calcula los hash de un tramo de claves,
+ * precarga sus posiciones y recién entonces las resuelve, así los fallos
+ * de caché de claves distintas se esperan en paralelo. filas[i] recibe
+ * la fila de individuo_ids[i] o -1
+ * Complejidad: O(n) promedio
+ */
+void hash_table_buscar_lote(TablaHash *tabla, const int *individuo_ids, int n, int *filas);
+
+/**
+ * Como hash_table_buscar_lote sin avanzar el crecimiento (solo lectura)
+ * Complejidad: O(n) promedio
  */
-Individuo* hash_table_buscar(TablaHash *tabla, int individuo_id);
+void hash_table_consultar_lote(const TablaHash *tabla, const int *individuo_ids, int n, int *filas);
 
 /**
  * Elimina un individuo de la tabla hash
@@ -35,7 +74,7 @@ void hash_table_eliminar(TablaHash *tabla, int individuo_id);
 
 /**
  * Libera toda la memoria de la tabla hash
- * Complejidad: O(HASH_TABLE_SIZE + elementos)
+ * Complejidad: O(1)
  */
 void hash_table_liberar(TablaHash *tabla);
 
@@ -1,4 +1,6 @@
 #include "heap.h"
+#include "memoria.h"
+#include "instrumentacion.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -21,21 +23,22 @@ static bool comparar(ElementoHeap a, ElementoHeap b, bool es_min) {
 }
 
 Heap* heap_crear(int capacidad_inicial, bool es_min_heap) {
-  Heap *heap = (Heap *)malloc(sizeof(Heap));
+  Heap *heap = (Heap *)bio_malloc(sizeof(Heap));
   heap->capacidad = capacidad_inicial;
   heap->tamano = 0;
   heap->es_min_heap = es_min_heap;
-  heap->elementos = (ElementoHeap *)malloc(capacidad_inicial * sizeof(ElementoHeap));
+  heap->elementos = (ElementoHeap *)bio_malloc(capacidad_inicial * sizeof(ElementoHeap));
   return heap;
 }
 
 void heap_insertar(Heap *heap, int individuo_id, int prioridad, void *datos) {
   if (!heap) return;
+  INSTR_CONTAR(CONTADOR_HEAP_INSERCIONES, 1);
   
   // Expandir si es necesario
   if (heap->tamano >= heap->capacidad) {
     heap->capacidad *= 2;
-    heap->elementos = (ElementoHeap *)realloc(heap->elementos, heap->capacidad * sizeof(ElementoHeap));
+    heap->elementos = (ElementoHeap *)bio_realloc(heap->elementos, heap->capacidad * sizeof(ElementoHeap));
   }
   
   // Insertar al final
@@ -60,6 +63,7 @@ ElementoHeap heap_extraer(Heap *heap) {
     return vacio;
   }
   
+  INSTR_CONTAR(CONTADOR_HEAP_EXTRACCIONES, 1);
   ElementoHeap raiz = heap->elementos[0];
   heap->elementos[0] = heap->elementos[heap->tamano - 1];
   heap->tamano--;
@@ -106,6 +110,6 @@ int heap_tamano(Heap *heap) {
 void heap_liberar(Heap *heap) {
   if (!heap) return;
   
-  free(heap->elementos);
-  free(heap);
+  bio_free(heap->elementos);
+  bio_free(heap);
 }
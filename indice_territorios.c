@@ -0,0 +1,131 @@
+#include "indice_territorios.h"
+#include "memoria.h"
+#include "paralelo.h"
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================
+// IMPLEMENTACION INDICE TERRITORIO -> MIEMBROS (CSR)
+// Ordenamiento por conteo de las filas según territorio_id
+// ============================================================
+
+// Filas mínimas por tramo: por debajo no compensa crear hilos
+#define FILAS_MIN_POR_TRAMO 65536
+
+typedef struct {
+  const int *territorio_id;
+  int num_individuos;
+  int num_territorios;
+  int num_tramos;
+  int *histogramas; // num_tramos x num_territorios
+  int *miembros;
+} ConstruccionIndice;
+
+static void rango_tramo(const ConstruccionIndice *c, int tramo, int *desde, int *hasta) {
+  *desde = (int)((long long)c->num_individuos * tramo / c->num_tramos);
+  *hasta = (int)((long long)c->num_individuos * (tramo + 1) / c->num_tramos);
+}
+
+// Paso 1: cada tramo cuenta sus miembros por territorio
+static void contar_tramo(void *contexto, int tramo) {
+  ConstruccionIndice *c = (ConstruccionIndice *)contexto;
+  int *histograma = c->histogramas + (size_t)tramo * c->num_territorios;
+  int desde, hasta;
+  rango_tramo(c, tramo, &desde, &hasta);
+
+  for (int i = desde; i < hasta; i++) {
+    histograma[c->territorio_id[i]]++;
+  }
+}
+
+// Paso 3: cada tramo coloca sus filas a partir de su desplazamiento
+static void colocar_tramo(void *contexto, int tramo) {
+  ConstruccionIndice *c = (ConstruccionIndice *)contexto;
+  int *siguiente = c->histogramas + (size_t)tramo * c->num_territorios;
+  int desde, hasta;
+  rango_tramo(c, tramo, &desde, &hasta);
+
+  for (int i = desde; i < hasta; i++) {
+    c->miembros[siguiente[c->territorio_id[i]]++] = i;
+  }
+}
+
+IndiceTerritorios* indice_territorios_construir_paralelo(const Poblacion *poblacion,
+                                                         int num_territorios, int num_hilos) {
+  if (!poblacion || num_territorios <= 0) return NULL;
+
+  int n = poblacion->num_individuos;
+  if (num_hilos <= 0) num_hilos = paralelo_hilos_disponibles();
+
+  // Un tramo por hilo, sin tramos demasiado pequeños ni histogramas
+  // que ocupen más que la propia población
+  int num_tramos = num_hilos;
+  if (num_tramos > n / FILAS_MIN_POR_TRAMO) num_tramos = n / FILAS_MIN_POR_TRAMO;
+  if (num_tramos > n / num_territorios) num_tramos = n / num_territorios;
+  if (num_tramos < 1) num_tramos = 1;
+
+  IndiceTerritorios *indice = (IndiceTerritorios *)bio_malloc(sizeof(IndiceTerritorios));
+  if (!indice) return NULL;
+
+  indice->num_territorios = num_territorios;
+  indice->num_miembros = n;
+  indice->inicio = (int *)bio_malloc((num_territorios + 1) * sizeof(int));
+  indice->miembros = (int *)bio_malloc((size_t)n * sizeof(int));
+
+  ConstruccionIndice c;
+  c.territorio_id = poblacion->territorio_id;
+  c.num_individuos = n;
+  c.num_territorios = num_territorios;
+  c.num_tramos = num_tramos;
+  c.histogramas = (int *)bio_calloc((size_t)num_tramos * num_territorios, sizeof(int));
+  c.miembros = indice->miembros;
+
+  if (!indice->inicio || (n > 0 && !indice->miembros) || !c.histogramas) {
+    bio_free(c.histogramas);
+    indice_territorios_liberar(indice);
+    return NULL;
+  }
+
+  // Paso 1: contar miembros por territorio en cada tramo - O(n / hilos)
+  paralelo_para(num_tramos, contar_tramo, &c, num_hilos);
+
+  // Paso 2: suma prefija en orden (territorio, tramo) - O(T * tramos)
+  // Cada histograma pasa a contener el desplazamiento inicial del tramo
+  int acumulado = 0;
+  for (int t = 0; t < num_territorios; t++) {
+    indice->inicio[t] = acumulado;
+    for (int k = 0; k < num_tramos; k++) {
+      int *celda = &c.histogramas[(size_t)k * num_territorios + t];
+      int cantidad = *celda;
+      *celda = acumulado;
+      acumulado += cantidad;
+    }
+  }
+  indice->inicio[num_territorios] = acumulado;
+
+  // Paso 3: colocar cada fila en su rango (estable) - O(n / hilos)
+  paralelo_para(num_tramos, colocar_tramo, &c, num_hilos);
+
+  bio_free(c.histogramas);
+  return indice;
+}
+
+IndiceTerritorios* indice_territorios_construir(const Poblacion *poblacion, int num_territorios) {
+  return indice_territorios_construir_paralelo(poblacion, num_territorios, 1);
+}
+
+int indice_territorios_tamano(const IndiceTerritorios *indice, int territorio) {
+  return indice->inicio[territorio + 1] - indice->inicio[territorio];
+}
+
+const int* indice_territorios_miembros(const IndiceTerritorios *indice, int territorio) {
+  return indice->miembros + indice->inicio[territorio];
+}
+
+void indice_territorios_liberar(IndiceTerritorios *indice) {
+  if (!indice) return;
+
+  bio_free(indice->inicio);
+  bio_free(indice->miembros);
+  bio_free(indice);
+}
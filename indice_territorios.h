@@ -0,0 +1,48 @@
+#ifndef INDICE_TERRITORIOS_H
+#define INDICE_TERRITORIOS_H
+
+#include "estructuras.h"
+
+// ============================================================
+// INDICE TERRITORIO -> MIEMBROS (CSR)
+// Subproblemas 2 y 3: recorrer los individuos de un territorio
+// como un rango contiguo en lugar de una lista enlazada
+// ============================================================
+
+/**
+ * Construye el índice a partir de la columna territorio_id
+ * Un pase de conteo, suma prefija y un pase de colocación
+ * Complejidad: O(n + T) con n = individuos, T = territorios
+ * Retorna: IndiceTerritorios o NULL si no hay memoria
+ */
+IndiceTerritorios* indice_territorios_construir(const Poblacion *poblacion, int num_territorios);
+
+/**
+ * Igual que indice_territorios_construir pero repartido en num_hilos:
+ * cada hilo cuenta un tramo contiguo de filas en su propio histograma y
+ * luego coloca sus filas en desplazamientos precalculados.
+ * El resultado es idéntico al secuencial (orden estable por fila)
+ * Complejidad: O(n / hilos + hilos * T)
+ */
+IndiceTerritorios* indice_territorios_construir_paralelo(const Poblacion *poblacion,
+                                                         int num_territorios, int num_hilos);
+
+/**
+ * Cantidad de miembros del territorio t
+ * Complejidad: O(1)
+ */
+int indice_territorios_tamano(const IndiceTerritorios *indice, int territorio);
+
+/**
+ * Puntero al primer miembro del territorio t (rango contiguo)
+ * Complejidad: O(1)
+ */
+const int* indice_territorios_miembros(const IndiceTerritorios *indice, int territorio);
+
+/**
+ * Libera el índice
+ * Complejidad: O(1)
+ */
+void indice_territorios_liberar(IndiceTerritorios *indice);
+
+#endif // INDICE_TERRITORIOS_H
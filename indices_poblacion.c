@@ -0,0 +1,294 @@
+#define _POSIX_C_SOURCE 200809L
+#include "indices_poblacion.h"
+#include "indice_territorios.h"
+#include "memoria.h"
+#include <limits.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================
+// IMPLEMENTACION INDICES SECUNDARIOS
+// Cada cubeta es un arreglo sin orden de filas; posicion[fila] dice
+// dónde está la fila dentro de su cubeta, así que sacarla es cambiarla
+// por la última (O(1)). Los valores fuera del dominio visto al
+// construir caen en la primera o la última cubeta: la consulta siempre
+// comprueba el valor exacto sobre la columna.
+// ============================================================
+
+// Cubetas por columna: dominios más grandes se agrupan en tramos
+#define INDICES_CUBETAS_MAXIMAS 1024
+
+typedef enum {
+  COLUMNA_ESTADO,
+  COLUMNA_RIESGO,
+  COLUMNA_TIEMPO,
+  NUM_COLUMNAS_INDEXADAS
+} ColumnaIndexada;
+
+typedef struct {
+  int minimo;            // Primer valor de la cubeta 0
+  int ancho;             // Valores por cubeta
+  int num_cubetas;
+  int **filas;           // Filas de cada cubeta
+  int *tamano;
+  int *capacidad;
+  int *cubeta;           // Cubeta de cada fila
+  int *posicion;         // Posición de cada fila en su cubeta
+} IndiceColumna;
+
+struct IndicesPoblacion {
+  int num_filas;
+  IndiceTerritorios *territorios;  // NULL si la Poblacion está vacía
+  IndiceColumna columnas[NUM_COLUMNAS_INDEXADAS];
+  pthread_rwlock_t cerrojo;
+};
+
+static int valor_columna(const Poblacion *poblacion, ColumnaIndexada columna, int fila) {
+  switch (columna) {
+    case COLUMNA_ESTADO: return (int)poblacion->estado[fila];
+    case COLUMNA_RIESGO: return poblacion->riesgo[fila];
+    default: return poblacion->tiempo_infeccion[fila];
+  }
+}
+
+// Límites del filtro sobre una columna
+static void rango_filtro(const FiltroPoblacion *filtro, ColumnaIndexada columna, int *desde, int *hasta) {
+  switch (columna) {
+    case COLUMNA_ESTADO:
+      *desde = filtro->estado < 0 ? INT_MIN : filtro->estado;
+      *hasta = filtro->estado < 0 ? INT_MAX : filtro->estado;
+      break;
+    case COLUMNA_RIESGO:
+      *desde = filtro->riesgo_minimo;
+      *hasta = filtro->riesgo_maximo;
+      break;
+    default:
+      *desde = filtro->tiempo_minimo;
+      *hasta = filtro->tiempo_maximo;
+      break;
+  }
+}
+
+// ===== CUBETAS =====
+
+static int cubeta_de(const IndiceColumna *indice, int valor) {
+  if (valor <= indice->minimo) return 0;
+  long long k = ((long long)valor - indice->minimo) / indice->ancho;
+  return k < indice->num_cubetas ? (int)k : indice->num_cubetas - 1;
+}
+
+static bool cubeta_asegurar(IndiceColumna *indice, int k) {
+  if (indice->tamano[k] < indice->capacidad[k]) return true;
+  int capacidad = indice->capacidad[k] ? indice->capacidad[k] * 2 : 4;
+  int *filas = (int *)bio_realloc(indice->filas[k], (size_t)capacidad * sizeof(int));
+  if (!filas) return false;
+  indice->filas[k] = filas;
+  indice->capacidad[k] = capacidad;
+  return true;
+}
+
+static void cubeta_agregar(IndiceColumna *indice, int k, int fila) {
+  indice->cubeta[fila] = k;
+  indice->posicion[fila] = indice->tamano[k];
+  indice->filas[k][indice->tamano[k]++] = fila;
+}
+
+static void cubeta_quitar(IndiceColumna *indice, int fila) {
+  int k = indice->cubeta[fila];
+  int p = indice->posicion[fila];
+  int ultima = indice->filas[k][--indice->tamano[k]];
+  indice->filas[k][p] = ultima;
+  indice->posicion[ultima] = p;
+}
+
+static void columna_liberar(IndiceColumna *indice) {
+  if (indice->filas) {
+    for (int k = 0; k < indice->num_cubetas; k++) bio_free(indice->filas[k]);
+  }
+  bio_free(indice->filas);
+  bio_free(indice->tamano);
+  bio_free(indice->capacidad);
+  bio_free(indice->cubeta);
+  bio_free(indice->posicion);
+}
+
+static bool columna_construir(IndiceColumna *indice, const Poblacion *poblacion, ColumnaIndexada columna) {
+  int n = poblacion->num_individuos;
+  long long minimo = 0, maximo = 0;
+  for (int i = 0; i < n; i++) {
+    int valor = valor_columna(poblacion, columna, i);
+    if (i == 0 || valor < minimo) minimo = valor;
+    if (i == 0 || valor > maximo) maximo = valor;
+  }
+  long long dominio = maximo - minimo + 1;
+  long long ancho = (dominio + INDICES_CUBETAS_MAXIMAS - 1) / INDICES_CUBETAS_MAXIMAS;
+
+  indice->minimo = (int)minimo;
+  indice->ancho = (int)ancho;
+  indice->num_cubetas = (int)((dominio + ancho - 1) / ancho);
+  indice->filas = (int **)bio_calloc((size_t)indice->num_cubetas, sizeof(int *));
+  indice->tamano = (int *)bio_calloc((size_t)indice->num_cubetas, sizeof(int));
+  indice->capacidad = (int *)bio_calloc((size_t)indice->num_cubetas, sizeof(int));
+  indice->cubeta = (int *)bio_malloc((size_t)(n > 0 ? n : 1) * sizeof(int));
+  indice->posicion = (int *)bio_malloc((size_t)(n > 0 ? n : 1) * sizeof(int));
+  if (!indice->filas || !indice->tamano || !indice->capacidad || !indice->cubeta || !indice->posicion) {
+    return false;
+  }
+
+  // Conteo primero: cada cubeta se reserva una sola vez a su tamaño
+  for (int i = 0; i < n; i++) {
+    indice->cubeta[i] = cubeta_de(indice, valor_columna(poblacion, columna, i));
+    indice->capacidad[indice->cubeta[i]]++;
+  }
+  for (int k = 0; k < indice->num_cubetas; k++) {
+    if (indice->capacidad[k] == 0) continue;
+    indice->filas[k] = (int *)bio_malloc((size_t)indice->capacidad[k] * sizeof(int));
+    if (!indice->filas[k]) return false;
+  }
+  for (int i = 0; i < n; i++) cubeta_agregar(indice, indice->cubeta[i], i);
+  return true;
+}
+
+// Cubetas [k0, k1] que cubren [desde, hasta]; devuelve cuántas filas tienen
+static int columna_candidatas(const IndiceColumna *indice, int desde, int hasta, int *k0, int *k1) {
+  *k0 = cubeta_de(indice, desde);
+  *k1 = cubeta_de(indice, hasta);
+  int total = 0;
+  for (int k = *k0; k <= *k1; k++) total += indice->tamano[k];
+  return total;
+}
+
+// ===== API =====
+
+FiltroPoblacion filtro_poblacion_todos(void) {
+  FiltroPoblacion filtro = { -1, -1, INT_MIN, INT_MAX, INT_MIN, INT_MAX };
+  return filtro;
+}
+
+bool filtro_poblacion_cumple(const FiltroPoblacion *filtro, const Poblacion *poblacion, int fila) {
+  if (filtro->territorio >= 0 && poblacion->territorio_id[fila] != filtro->territorio) return false;
+  if (filtro->estado >= 0 && (int)poblacion->estado[fila] != filtro->estado) return false;
+  int riesgo = poblacion->riesgo[fila];
+  if (riesgo < filtro->riesgo_minimo || riesgo > filtro->riesgo_maximo) return false;
+  int tiempo = poblacion->tiempo_infeccion[fila];
+  return tiempo >= filtro->tiempo_minimo && tiempo <= filtro->tiempo_maximo;
+}
+
+IndicesPoblacion* indices_poblacion_construir(const Poblacion *poblacion) {
+  if (!poblacion) return NULL;
+  IndicesPoblacion *indices = (IndicesPoblacion *)bio_calloc(1, sizeof(IndicesPoblacion));
+  if (!indices) return NULL;
+  indices->num_filas = poblacion->num_individuos;
+
+  int num_territorios = 0;
+  for (int i = 0; i < poblacion->num_individuos; i++) {
+    if (poblacion->territorio_id[i] >= num_territorios) num_territorios = poblacion->territorio_id[i] + 1;
+  }
+  bool ok = true;
+  if (num_territorios > 0) {
+    indices->territorios = indice_territorios_construir(poblacion, num_territorios);
+    ok = indices->territorios != NULL;
+  }
+  for (int c = 0; c < NUM_COLUMNAS_INDEXADAS && ok; c++) {
+    ok = columna_construir(&indices->columnas[c], poblacion, (ColumnaIndexada)c);
+  }
+  pthread_rwlock_init(&indices->cerrojo, NULL);
+  if (!ok) {
+    indices_poblacion_liberar(indices);
+    return NULL;
+  }
+  return indices;
+}
+
+bool indices_poblacion_fijar(IndicesPoblacion *indices, Poblacion *poblacion, int fila,
+                             EstadoSalud estado, int tiempo_infeccion) {
+  if (!indices || fila < 0 || fila >= indices->num_filas) return false;
+  pthread_rwlock_wrlock(&indices->cerrojo);
+
+  // Cubetas destino con lugar antes de tocar nada
+  int destino[NUM_COLUMNAS_INDEXADAS];
+  destino[COLUMNA_ESTADO] = cubeta_de(&indices->columnas[COLUMNA_ESTADO], (int)estado);
+  destino[COLUMNA_RIESGO] = indices->columnas[COLUMNA_RIESGO].cubeta[fila];
+  destino[COLUMNA_TIEMPO] = cubeta_de(&indices->columnas[COLUMNA_TIEMPO], tiempo_infeccion);
+  for (int c = 0; c < NUM_COLUMNAS_INDEXADAS; c++) {
+    IndiceColumna *indice = &indices->columnas[c];
+    if (destino[c] != indice->cubeta[fila] && !cubeta_asegurar(indice, destino[c])) {
+      pthread_rwlock_unlock(&indices->cerrojo);
+      return false;
+    }
+  }
+
+  poblacion->estado[fila] = estado;
+  poblacion->tiempo_infeccion[fila] = tiempo_infeccion;
+  for (int c = 0; c < NUM_COLUMNAS_INDEXADAS; c++) {
+    IndiceColumna *indice = &indices->columnas[c];
+    if (destino[c] == indice->cubeta[fila]) continue;
+    cubeta_quitar(indice, fila);
+    cubeta_agregar(indice, destino[c], fila);
+  }
+  pthread_rwlock_unlock(&indices->cerrojo);
+  return true;
+}
+
+int indices_poblacion_consultar(IndicesPoblacion *indices, const Poblacion *poblacion,
+                                const FiltroPoblacion *filtro, int *filas, int max_filas) {
+  if (!indices || !poblacion || !filtro) return 0;
+  pthread_rwlock_rdlock(&indices->cerrojo);
+
+  // Fuente de candidatas: el predicado con menos filas (o todas)
+  int mejor = indices->num_filas;
+  int columna = -1, k0 = 0, k1 = -1;
+  const int *miembros = NULL;
+  if (filtro->territorio >= 0) {
+    bool existe = indices->territorios && filtro->territorio < indices->territorios->num_territorios;
+    mejor = existe ? indice_territorios_tamano(indices->territorios, filtro->territorio) : 0;
+    miembros = existe ? indice_territorios_miembros(indices->territorios, filtro->territorio) : NULL;
+  }
+  for (int c = 0; c < NUM_COLUMNAS_INDEXADAS; c++) {
+    int desde, hasta;
+    rango_filtro(filtro, (ColumnaIndexada)c, &desde, &hasta);
+    if (desde == INT_MIN && hasta == INT_MAX) continue;
+    int c0 = 0, c1 = -1;  // Rango vacío: ninguna candidata
+    int candidatas = desde > hasta ? 0 : columna_candidatas(&indices->columnas[c], desde, hasta, &c0, &c1);
+    if (candidatas < mejor) {
+      mejor = candidatas;
+      columna = c;
+      k0 = c0;
+      k1 = c1;
+      miembros = NULL;
+    }
+  }
+
+  int total = 0;
+  if (columna >= 0) {
+    const IndiceColumna *indice = &indices->columnas[columna];
+    for (int k = k0; k <= k1; k++) {
+      for (int j = 0; j < indice->tamano[k]; j++) {
+        int fila = indice->filas[k][j];
+        if (!filtro_poblacion_cumple(filtro, poblacion, fila)) continue;
+        if (total < max_filas) filas[total] = fila;
+        total++;
+      }
+    }
+  } else {
+    // Miembros del territorio o, sin predicados indexados, todas las filas
+    int cantidad = filtro->territorio >= 0 ? mejor : indices->num_filas;
+    for (int j = 0; j < cantidad; j++) {
+      int fila = miembros ? miembros[j] : j;
+      if (!filtro_poblacion_cumple(filtro, poblacion, fila)) continue;
+      if (total < max_filas) filas[total] = fila;
+      total++;
+    }
+  }
+  pthread_rwlock_unlock(&indices->cerrojo);
+  return total;
+}
+
+void indices_poblacion_liberar(IndicesPoblacion *indices) {
+  if (!indices) return;
+  pthread_rwlock_destroy(&indices->cerrojo);
+  indice_territorios_liberar(indices->territorios);
+  for (int c = 0; c < NUM_COLUMNAS_INDEXADAS; c++) columna_liberar(&indices->columnas[c]);
+  bio_free(indices);
+}
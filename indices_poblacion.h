@@ -0,0 +1,76 @@
+#ifndef INDICES_POBLACION_H
+#define INDICES_POBLACION_H
+
+#include "estructuras.h"
+
+// ============================================================
+// INDICES SECUNDARIOS DE LA POBLACION - Consultas filtradas
+// "Infectados del territorio 7 con riesgo > 80" sin recorrer toda la
+// Poblacion: índice territorio -> filas (CSR, el territorio no cambia)
+// y, para estado, riesgo y tiempo_infeccion, una cubeta de filas por
+// valor (o por tramo de valores si el dominio es grande).
+// Una consulta toma como candidatas las filas del predicado más
+// selectivo y comprueba el resto sobre las columnas.
+// Los índices se mantienen con indices_poblacion_fijar: los cambios
+// escritos directamente en la Poblacion no se ven reflejados.
+// Consultas y actualizaciones pueden venir de varios hilos (cerrojo de
+// lectura/escritura interno).
+// ============================================================
+
+typedef struct IndicesPoblacion IndicesPoblacion;
+
+// Predicados de una consulta (se cumplen todos). Límites inclusivos
+typedef struct {
+  int territorio;        // -1 = cualquiera
+  int estado;            // EstadoSalud o -1 = cualquiera
+  int riesgo_minimo;
+  int riesgo_maximo;
+  int tiempo_minimo;     // tiempo_infeccion
+  int tiempo_maximo;
+} FiltroPoblacion;
+
+/**
+ * Filtro que acepta a todos (base para fijar solo algunos predicados)
+ * Complejidad: O(1)
+ */
+FiltroPoblacion filtro_poblacion_todos(void);
+
+/**
+ * Construye los índices de la Poblacion
+ * Complejidad: O(n + T) con n = individuos, T = territorios
+ * Retorna: IndicesPoblacion o NULL si no hay memoria
+ */
+IndicesPoblacion* indices_poblacion_construir(const Poblacion *poblacion);
+
+/**
+ * Escribe estado y tiempo_infeccion de una fila y la mueve de cubeta en
+ * los índices, de forma atómica respecto de las consultas
+ * Complejidad: O(1) amortizado
+ * Retorna: false si no hay memoria (la fila queda sin cambios)
+ */
+bool indices_poblacion_fijar(IndicesPoblacion *indices, Poblacion *poblacion, int fila,
+                             EstadoSalud estado, int tiempo_infeccion);
+
+/**
+ * Filas que cumplen el filtro: copia hasta max_filas en filas (en orden
+ * no especificado; filas puede ser NULL con max_filas = 0 para contar)
+ * Complejidad: O(C + cubetas) con C = filas del predicado más selectivo
+ * Retorna: Cantidad total de filas que cumplen el filtro
+ */
+int indices_poblacion_consultar(IndicesPoblacion *indices, const Poblacion *poblacion,
+                                const FiltroPoblacion *filtro, int *filas, int max_filas);
+
+/**
+ * Comprueba el filtro sobre una fila (lo que hace la consulta con cada
+ * candidata)
+ * Complejidad: O(1)
+ */
+bool filtro_poblacion_cumple(const FiltroPoblacion *filtro, const Poblacion *poblacion, int fila);
+
+/**
+ * Libera los índices
+ * Complejidad: O(cubetas)
+ */
+void indices_poblacion_liberar(IndicesPoblacion *indices);
+
+#endif // INDICES_POBLACION_H
@@ -0,0 +1,544 @@
+#define _POSIX_C_SOURCE 200809L
+#include "ingesta.h"
+#include "memoria.h"
+#include "poblacion.h"
+#include "grafo_csr.h"
+#include "mapeo_archivo.h"
+#include "paralelo.h"
+#include "instrumentacion.h"
+#include <float.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================
+// IMPLEMENTACION INGESTA
+// ============================================================
+
+// Cursor sobre el archivo mapeado
+typedef struct {
+  const char *actual;
+  const char *fin;
+  char delimitador;
+  long long linea;
+} Lector;
+
+// ===== UTILIDADES DE PARSEO =====
+
+static char detectar_delimitador(const char *inicio, const char *fin) {
+  int comas = 0, puntos_coma = 0, tabuladores = 0;
+  for (const char *p = inicio; p < fin && *p != '\n'; p++) {
+    if (*p == ',') comas++;
+    else if (*p == ';') puntos_coma++;
+    else if (*p == '\t') tabuladores++;
+  }
+  if (tabuladores >= comas && tabuladores >= puntos_coma && tabuladores > 0) return '\t';
+  if (puntos_coma > comas) return ';';
+  return ',';
+}
+
+// Cota superior de registros: saltos de línea + una línea final sin '\n'
+static long long contar_lineas(const char *inicio, const char *fin) {
+  long long lineas = 0;
+  const char *p = inicio;
+  while (p < fin) {
+    const char *salto = (const char *)memchr(p, '\n', (size_t)(fin - p));
+    lineas++;
+    if (!salto) break;
+    p = salto + 1;
+  }
+  return lineas;
+}
+
+static bool es_espacio(char c) {
+  return c == ' ' || c == '\r';
+}
+
+// Siguiente campo de la línea actual (sin copiarlo)
+// Retorna false si la línea ya no tiene más campos
+static bool leer_campo(Lector *lector, const char **campo, int *longitud) {
+  const char *p = lector->actual;
+  const char *fin = lector->fin;
+  if (p >= fin || *p == '\n') return false;
+
+  while (p < fin && *p == ' ') p++;
+
+  if (p < fin && *p == '"') {
+    // Campo entre comillas: hasta la comilla de cierre
+    const char *inicio = ++p;
+    while (p < fin && *p != '"' && *p != '\n') p++;
+    *campo = inicio;
+    *longitud = (int)(p - inicio);
+    if (p < fin && *p == '"') p++;
+    while (p < fin && *p != lector->delimitador && *p != '\n') p++;
+  } else {
+    const char *inicio = p;
+    while (p < fin && *p != lector->delimitador && *p != '\n') p++;
+    const char *final = p;
+    while (final > inicio && es_espacio(final[-1])) final--;
+    *campo = inicio;
+    *longitud = (int)(final - inicio);
+  }
+
+  if (p < fin && *p == lector->delimitador) p++;
+  lector->actual = p;
+  return true;
+}
+
+// Avanza hasta el comienzo de la línea siguiente
+static void siguiente_linea(Lector *lector) {
+  const char *salto = (const char *)memchr(lector->actual, '\n',
+                                           (size_t)(lector->fin - lector->actual));
+  lector->actual = salto ? salto + 1 : lector->fin;
+  lector->linea++;
+}
+
+// Línea vacía o solo espacios
+static bool linea_vacia(const Lector *lector) {
+  const char *p = lector->actual;
+  while (p < lector->fin && es_espacio(*p)) p++;
+  return p >= lector->fin || *p == '\n';
+}
+
+static bool parsear_entero(const char *campo, int longitud, int *valor) {
+  const char *p = campo;
+  const char *fin = campo + longitud;
+  bool negativo = false;
+
+  if (p < fin && (*p == '-' || *p == '+')) {
+    negativo = *p == '-';
+    p++;
+  }
+  if (p >= fin) return false;
+
+  long long acumulado = 0;
+  for (; p < fin; p++) {
+    if (*p < '0' || *p > '9') return false;
+    acumulado = acumulado * 10 + (*p - '0');
+    if (acumulado > (long long)INT_MAX + 1) return false;
+  }
+  if (negativo) acumulado = -acumulado;
+  if (acumulado > INT_MAX || acumulado < INT_MIN) return false;
+
+  *valor = (int)acumulado;
+  return true;
+}
+
+// Campo entero leído y convertido en un solo recorrido (camino rápido
+// para las columnas numéricas); no admite comillas
+static bool leer_entero(Lector *lector, int *valor) {
+  const char *p = lector->actual;
+  const char *fin = lector->fin;
+  char delimitador = lector->delimitador;
+
+  while (p < fin && *p == ' ') p++;
+
+  bool negativo = false;
+  if (p < fin && (*p == '-' || *p == '+')) {
+    negativo = *p == '-';
+    p++;
+  }
+
+  const char *digitos = p;
+  long long acumulado = 0;
+  while (p < fin && (unsigned)(*p - '0') <= 9) {
+    acumulado = acumulado * 10 + (*p - '0');
+    if (acumulado > (long long)INT_MAX + 1) return false;
+    p++;
+  }
+  if (p == digitos) return false;
+
+  while (p < fin && es_espacio(*p)) p++;
+  if (p < fin && *p != delimitador && *p != '\n') return false;
+  if (p < fin && *p == delimitador) p++;
+
+  if (negativo) acumulado = -acumulado;
+  if (acumulado > INT_MAX) return false;
+
+  *valor = (int)acumulado;
+  lector->actual = p;
+  return true;
+}
+
+// Más allá de este exponente cualquier mantisa desborda o se anula en
+// double; acotarlo evita bucles de miles de millones de iteraciones
+#define MAX_EXPONENTE 400
+
+// Decimal simple: [signo] dígitos [. dígitos] [e|E [signo] dígitos]
+// Rechaza valores que no caben en un float
+static bool parsear_float(const char *campo, int longitud, float *valor) {
+  const char *p = campo;
+  const char *fin = campo + longitud;
+  bool negativo = false;
+  int digitos = 0;
+
+  if (p < fin && (*p == '-' || *p == '+')) {
+    negativo = *p == '-';
+    p++;
+  }
+
+  double mantisa = 0.0;
+  for (; p < fin && *p >= '0' && *p <= '9'; p++, digitos++) {
+    mantisa = mantisa * 10.0 + (*p - '0');
+  }
+  if (p < fin && *p == '.') {
+    double escala = 0.1;
+    for (p++; p < fin && *p >= '0' && *p <= '9'; p++, digitos++) {
+      mantisa += (*p - '0') * escala;
+      escala *= 0.1;
+    }
+  }
+  if (digitos == 0) return false;
+
+  if (p < fin && (*p == 'e' || *p == 'E')) {
+    int exponente;
+    if (!parsear_entero(p + 1, (int)(fin - p - 1), &exponente)) return false;
+    if (exponente > MAX_EXPONENTE) exponente = MAX_EXPONENTE;
+    if (exponente < -MAX_EXPONENTE) exponente = -MAX_EXPONENTE;
+    for (; exponente > 0; exponente--) mantisa *= 10.0;
+    for (; exponente < 0; exponente++) mantisa /= 10.0;
+    p = fin;
+  }
+  if (p != fin) return false;
+  if (!(mantisa <= FLT_MAX)) return false;
+
+  *valor = (float)(negativo ? -mantisa : mantisa);
+  return true;
+}
+
+static bool campo_igual(const char *campo, int longitud, const char *texto) {
+  return (int)strlen(texto) == longitud && memcmp(campo, texto, longitud) == 0;
+}
+
+static bool parsear_estado(const char *campo, int longitud, EstadoSalud *estado) {
+  int valor;
+  if (parsear_entero(campo, longitud, &valor)) {
+    if (valor < SANO || valor > RECUPERADO) return false;
+    *estado = (EstadoSalud)valor;
+    return true;
+  }
+  if (campo_igual(campo, longitud, "SANO")) *estado = SANO;
+  else if (campo_igual(campo, longitud, "INFECTADO")) *estado = INFECTADO;
+  else if (campo_igual(campo, longitud, "RECUPERADO")) *estado = RECUPERADO;
+  else return false;
+  return true;
+}
+
+// ===== REPARTO EN TROZOS =====
+// El archivo se corta en trozos que terminan en salto de línea.
+// Pase 1 (paralelo): contar líneas de cada trozo -> fila inicial de cada uno
+// Pase 2 (paralelo): cada trozo parsea sus registros en su rango de filas
+// Las líneas vacías dejan huecos que se compactan al final.
+
+// Bytes por trozo de reparto entre hilos
+#define BYTES_POR_TROZO (8 << 20)
+
+typedef struct {
+  const char *inicio;
+  const char *fin;
+  long long lineas;       // Saltos de línea del trozo (cota de registros)
+  long long primera_fila; // Fila destino del primer registro
+  int filas;              // Registros escritos
+  long long linea_error;  // Línea relativa al trozo (1-based), 0 si no hubo
+  int max_id;             // Mayor territorio / nodo visto
+} Trozo;
+
+typedef struct {
+  MapeoArchivo mapeo;
+  char delimitador;
+  long long lineas_cabecera;
+  Trozo *trozos;
+  int num_trozos;
+  long long capacidad;
+  int num_hilos;
+  // Destino: población o lista de aristas
+  Poblacion *poblacion;
+  int *origenes;
+  int *destinos;
+  float *pesos;
+} Ingesta;
+
+static void contar_trozo(void *contexto, int t) {
+  Ingesta *ingesta = (Ingesta *)contexto;
+  Trozo *trozo = &ingesta->trozos[t];
+  trozo->lineas = contar_lineas(trozo->inicio, trozo->fin);
+}
+
+// Mapea el archivo, omite la cabecera, corta en trozos y cuenta líneas
+static bool ingesta_abrir(Ingesta *ingesta, const char *ruta, int num_hilos,
+                          EstadisticasIngesta *estadisticas) {
+  memset(ingesta, 0, sizeof(Ingesta));
+  if (!mapeo_archivo_abrir(&ingesta->mapeo, ruta, MAPEO_LECTURA)) return false;
+  mapeo_archivo_acceso_secuencial(&ingesta->mapeo);
+
+  estadisticas->bytes = (long long)ingesta->mapeo.tamano;
+  estadisticas->lineas = 0;
+  estadisticas->segundos = 0.0;
+  estadisticas->linea_error = 0;
+
+  const char *inicio = (const char *)ingesta->mapeo.datos;
+  const char *fin = inicio + ingesta->mapeo.tamano;
+  ingesta->delimitador = detectar_delimitador(inicio, fin);
+  ingesta->num_hilos = num_hilos;
+
+  // Cabecera: primer campo no numérico
+  Lector prueba = { inicio, fin, ingesta->delimitador, 1 };
+  const char *campo;
+  int longitud, valor;
+  if (leer_campo(&prueba, &campo, &longitud) && !parsear_entero(campo, longitud, &valor)) {
+    prueba.actual = inicio;
+    siguiente_linea(&prueba);
+    inicio = prueba.actual;
+    ingesta->lineas_cabecera = 1;
+  }
+
+  long long bytes = fin - inicio;
+  long long num_trozos = bytes / BYTES_POR_TROZO + 1;
+  ingesta->num_trozos = (int)num_trozos;
+  ingesta->trozos = (Trozo *)bio_calloc((size_t)num_trozos, sizeof(Trozo));
+  if (!ingesta->trozos) {
+    mapeo_archivo_cerrar(&ingesta->mapeo);
+    return false;
+  }
+
+  // Cortes nominales desplazados hasta después del siguiente '\n'
+  const char *corte = inicio;
+  for (int t = 0; t < ingesta->num_trozos; t++) {
+    const char *nominal = inicio + bytes * (t + 1) / num_trozos;
+    if (nominal < corte) nominal = corte;
+    const char *salto = nominal < fin ? (const char *)memchr(nominal, '\n', (size_t)(fin - nominal)) : NULL;
+    const char *siguiente = (t == ingesta->num_trozos - 1 || !salto) ? fin : salto + 1;
+    ingesta->trozos[t].inicio = corte;
+    ingesta->trozos[t].fin = siguiente;
+    ingesta->trozos[t].max_id = -1;
+    corte = siguiente;
+  }
+
+  paralelo_para(ingesta->num_trozos, contar_trozo, ingesta, num_hilos);
+
+  for (int t = 0; t < ingesta->num_trozos; t++) {
+    ingesta->trozos[t].primera_fila = ingesta->capacidad;
+    ingesta->capacidad += ingesta->trozos[t].lineas;
+  }
+  return true;
+}
+
+static void mover_filas(Ingesta *ingesta, long long desde, long long hacia, int filas) {
+  size_t n = (size_t)filas;
+  if (ingesta->poblacion) {
+    Poblacion *p = ingesta->poblacion;
+    memmove(p->id + hacia, p->id + desde, n * sizeof(int));
+    memmove(p->estado + hacia, p->estado + desde, n * sizeof(EstadoSalud));
+    memmove(p->riesgo + hacia, p->riesgo + desde, n * sizeof(int));
+    memmove(p->tiempo_infeccion + hacia, p->tiempo_infeccion + desde, n * sizeof(int));
+    memmove(p->territorio_id + hacia, p->territorio_id + desde, n * sizeof(int));
+    memmove(p->nombre + hacia, p->nombre + desde, n * MAX_NOMBRE);
+  } else {
+    memmove(ingesta->origenes + hacia, ingesta->origenes + desde, n * sizeof(int));
+    memmove(ingesta->destinos + hacia, ingesta->destinos + desde, n * sizeof(int));
+    memmove(ingesta->pesos + hacia, ingesta->pesos + desde, n * sizeof(float));
+  }
+}
+
+// Tras el pase 2: localizar el primer error y compactar huecos
+// Retorna el número total de registros o -1 si hubo error
+static long long ingesta_cerrar_trozos(Ingesta *ingesta, int *max_id,
+                                       EstadisticasIngesta *estadisticas) {
+  long long linea = ingesta->lineas_cabecera;
+  long long filas = 0;
+  *max_id = -1;
+
+  for (int t = 0; t < ingesta->num_trozos; t++) {
+    Trozo *trozo = &ingesta->trozos[t];
+    if (trozo->linea_error > 0) {
+      estadisticas->linea_error = linea + trozo->linea_error;
+      return -1;
+    }
+    if (trozo->primera_fila != filas && trozo->filas > 0) {
+      mover_filas(ingesta, trozo->primera_fila, filas, trozo->filas);
+    }
+    filas += trozo->filas;
+    linea += trozo->lineas;
+    if (trozo->max_id > *max_id) *max_id = trozo->max_id;
+  }
+  return filas;
+}
+
+static void ingesta_liberar(Ingesta *ingesta) {
+  mapeo_archivo_cerrar(&ingesta->mapeo);
+  bio_free(ingesta->trozos);
+}
+
+// ===== POBLACION =====
+
+static void parsear_trozo_poblacion(void *contexto, int t) {
+  Ingesta *ingesta = (Ingesta *)contexto;
+  Trozo *trozo = &ingesta->trozos[t];
+  Poblacion *poblacion = ingesta->poblacion;
+  Lector lector = { trozo->inicio, trozo->fin, ingesta->delimitador, 1 };
+  long long fila = trozo->primera_fila;
+
+  while (lector.actual < lector.fin) {
+    if (linea_vacia(&lector)) {
+      siguiente_linea(&lector);
+      continue;
+    }
+
+    const char *campo;
+    int longitud;
+    int id, territorio, riesgo, tiempo;
+    EstadoSalud estado;
+
+    // id, nombre, territorio, riesgo, estado, tiempo_infeccion
+    bool error = !leer_entero(&lector, &id);
+    if (!error) {
+      error = !leer_campo(&lector, &campo, &longitud);
+      if (!error) {
+        int copiar = longitud < MAX_NOMBRE - 1 ? longitud : MAX_NOMBRE - 1;
+        memcpy(poblacion->nombre[fila], campo, copiar);
+        poblacion->nombre[fila][copiar] = '\0';
+      }
+    }
+    error = error || !leer_entero(&lector, &territorio) || territorio < 0;
+    error = error || !leer_entero(&lector, &riesgo);
+    error = error || !leer_campo(&lector, &campo, &longitud) || !parsear_estado(campo, longitud, &estado);
+    error = error || !leer_entero(&lector, &tiempo);
+
+    if (error) {
+      trozo->linea_error = lector.linea;
+      return;
+    }
+
+    poblacion->id[fila] = id;
+    poblacion->territorio_id[fila] = territorio;
+    poblacion->riesgo[fila] = riesgo;
+    poblacion->estado[fila] = estado;
+    poblacion->tiempo_infeccion[fila] = tiempo;
+    if (territorio > trozo->max_id) trozo->max_id = territorio;
+    fila++;
+    trozo->filas++;
+
+    siguiente_linea(&lector);
+  }
+}
+
+Poblacion* ingesta_poblacion(const char *ruta, int num_hilos, int *num_territorios,
+                             EstadisticasIngesta *estadisticas) {
+  EstadisticasIngesta local;
+  if (!estadisticas) estadisticas = &local;
+
+  uint64_t inicio = instr_reloj_ns();
+  Ingesta ingesta;
+  if (!ingesta_abrir(&ingesta, ruta, num_hilos, estadisticas)) return NULL;
+
+  // Columnas reservadas una sola vez con la cota de líneas
+  if (ingesta.capacidad > INT_MAX ||
+      !(ingesta.poblacion = poblacion_crear((int)ingesta.capacidad))) {
+    ingesta_liberar(&ingesta);
+    return NULL;
+  }
+
+  paralelo_para(ingesta.num_trozos, parsear_trozo_poblacion, &ingesta, num_hilos);
+
+  int max_territorio;
+  long long filas = ingesta_cerrar_trozos(&ingesta, &max_territorio, estadisticas);
+  Poblacion *poblacion = ingesta.poblacion;
+  ingesta_liberar(&ingesta);
+
+  if (filas < 0) {
+    poblacion_liberar(poblacion);
+    return NULL;
+  }
+
+  // Las columnas pueden quedar algo sobredimensionadas (líneas vacías)
+  poblacion->num_individuos = (int)filas;
+  if (num_territorios) *num_territorios = max_territorio + 1;
+
+  estadisticas->lineas = filas;
+  estadisticas->segundos = (double)(instr_reloj_ns() - inicio) * 1e-9;
+  return poblacion;
+}
+
+// ===== ARISTAS =====
+
+static void parsear_trozo_aristas(void *contexto, int t) {
+  Ingesta *ingesta = (Ingesta *)contexto;
+  Trozo *trozo = &ingesta->trozos[t];
+  Lector lector = { trozo->inicio, trozo->fin, ingesta->delimitador, 1 };
+  long long fila = trozo->primera_fila;
+
+  while (lector.actual < lector.fin) {
+    if (linea_vacia(&lector)) {
+      siguiente_linea(&lector);
+      continue;
+    }
+
+    const char *campo;
+    int longitud;
+    int origen, destino;
+    float peso;
+
+    bool error = !leer_entero(&lector, &origen) || origen < 0;
+    error = error || !leer_entero(&lector, &destino) || destino < 0;
+    error = error || !leer_campo(&lector, &campo, &longitud) || !parsear_float(campo, longitud, &peso) ||
+            peso < 0.0f;
+
+    if (error) {
+      trozo->linea_error = lector.linea;
+      return;
+    }
+
+    ingesta->origenes[fila] = origen;
+    ingesta->destinos[fila] = destino;
+    ingesta->pesos[fila] = peso;
+    if (origen > trozo->max_id) trozo->max_id = origen;
+    if (destino > trozo->max_id) trozo->max_id = destino;
+    fila++;
+    trozo->filas++;
+
+    siguiente_linea(&lector);
+  }
+}
+
+GrafoCSR* ingesta_grafo(const char *ruta, int num_hilos, int num_nodos_minimo,
+                        EstadisticasIngesta *estadisticas) {
+  EstadisticasIngesta local;
+  if (!estadisticas) estadisticas = &local;
+
+  uint64_t inicio = instr_reloj_ns();
+  Ingesta ingesta;
+  if (!ingesta_abrir(&ingesta, ruta, num_hilos, estadisticas)) return NULL;
+
+  size_t capacidad = (size_t)ingesta.capacidad;
+  ingesta.origenes = (int *)bio_malloc(capacidad * sizeof(int));
+  ingesta.destinos = (int *)bio_malloc(capacidad * sizeof(int));
+  ingesta.pesos = (float *)bio_malloc(capacidad * sizeof(float));
+
+  GrafoCSR *grafo = NULL;
+  if (ingesta.capacidad <= INT_MAX &&
+      (capacidad == 0 || (ingesta.origenes && ingesta.destinos && ingesta.pesos))) {
+    paralelo_para(ingesta.num_trozos, parsear_trozo_aristas, &ingesta, num_hilos);
+
+    int max_nodo;
+    long long aristas = ingesta_cerrar_trozos(&ingesta, &max_nodo, estadisticas);
+    if (max_nodo < num_nodos_minimo - 1) max_nodo = num_nodos_minimo - 1;
+    if (aristas >= 0 && max_nodo >= 0) {
+      grafo = grafo_csr_desde_aristas(max_nodo + 1, ingesta.origenes, ingesta.destinos,
+                                      ingesta.pesos, (int)aristas);
+      estadisticas->lineas = aristas;
+    }
+  }
+
+  bio_free(ingesta.origenes);
+  bio_free(ingesta.destinos);
+  bio_free(ingesta.pesos);
+  ingesta_liberar(&ingesta);
+
+  if (grafo) estadisticas->segundos = (double)(instr_reloj_ns() - inicio) * 1e-9;
+  return grafo;
+}
+
+double ingesta_gb_por_segundo(const EstadisticasIngesta *estadisticas) {
+  if (estadisticas->segundos <= 0.0) return 0.0;
+  return (double)estadisticas->bytes / 1e9 / estadisticas->segundos;
+}
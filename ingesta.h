@@ -0,0 +1,51 @@
+#ifndef INGESTA_H
+#define INGESTA_H
+
+#include "estructuras.h"
+
+// ============================================================
+// INGESTA - Carga de datos reales desde CSV/TSV
+// El archivo se mapea en memoria y se recorre una sola vez con un
+// parser escrito a mano: sin copias de líneas ni reservas por campo.
+// El delimitador (',' ';' o tabulador) se detecta en la primera línea
+// y una cabecera no numérica se omite. Archivos grandes se cortan en
+// trozos de líneas completas que se parsean en paralelo.
+//
+// Población:  id, nombre, territorio, riesgo, estado, tiempo_infeccion
+//             (estado: 0/1/2 o SANO/INFECTADO/RECUPERADO)
+// Aristas:    origen, destino, peso (ids y peso no negativos)
+// ============================================================
+
+typedef struct {
+  long long bytes;         // Tamaño del archivo
+  long long lineas;        // Registros leídos (sin cabecera ni vacías)
+  double segundos;         // Tiempo de reloj de la ingesta
+  long long linea_error;   // Línea (1-based) del primer error, 0 si no hubo
+} EstadisticasIngesta;
+
+/**
+ * Lee una lista de individuos y llena una población nueva
+ * num_territorios recibe max(territorio) + 1
+ * num_hilos <= 0 usa todos los procesadores
+ * Complejidad: O(bytes / hilos)
+ * Retorna: Poblacion o NULL si el archivo no existe o tiene errores
+ */
+Poblacion* ingesta_poblacion(const char *ruta, int num_hilos, int *num_territorios,
+                             EstadisticasIngesta *estadisticas);
+
+/**
+ * Lee una lista de aristas dirigidas y la compacta a CSR
+ * El grafo tiene max(num_nodos_minimo, max(nodo) + 1) nodos
+ * Complejidad: O(bytes / hilos + n + m)
+ * Retorna: GrafoCSR o NULL si el archivo no existe o tiene errores
+ */
+GrafoCSR* ingesta_grafo(const char *ruta, int num_hilos, int num_nodos_minimo,
+                        EstadisticasIngesta *estadisticas);
+
+/**
+ * Rendimiento de la ingesta en GB/s
+ * Complejidad: O(1)
+ */
+double ingesta_gb_por_segundo(const EstadisticasIngesta *estadisticas);
+
+#endif // INGESTA_H
@@ -0,0 +1,334 @@
+#define _POSIX_C_SOURCE 200809L
+#include "instrumentacion.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+// ============================================================
+// IMPLEMENTACION INSTRUMENTACION
+// Árbol de ámbitos en un array fijo (hijos enlazados por índice) y
+// contadores globales con suma atómica relajada. La medición activa de
+// cada hilo va en una clave de hilo junto con la última lectura de sus
+// contadores de hardware
+// ============================================================
+
+typedef struct {
+  const char *nombre;
+  int padre;               // -1 = raíz
+  int primer_hijo;
+  int ultimo_hijo;
+  int siguiente_hermano;
+  uint64_t llamadas;
+  uint64_t total_ns;
+  uint64_t contadores[NUM_CONTADORES];
+  uint64_t bytes_asignados;
+  uint64_t asignaciones;
+  int64_t variacion_vivos;     // Bytes vivos al cerrar - al abrir
+  int64_t pico_vivos;          // Máximo de bytes vivos mientras estuvo abierto
+  long long pico_rss_kb;
+} NodoAmbito;
+
+static const char *NOMBRES_CONTADORES[NUM_CONTADORES] = {
+  "eventos procesados",
+  "heap inserciones",
+  "heap extracciones",
+  "aristas relajadas",
+  "busquedas directas",
+  "hash busquedas",
+  "hash sondeos"
+};
+
+static NodoAmbito nodos[INSTR_MAX_AMBITOS];
+static int num_nodos = 0;
+static int nodo_actual = -1;
+static uint64_t contadores[NUM_CONTADORES];
+static pthread_t hilo_ambitos;      // Hilo que abrió el primer ámbito
+static bool hilo_ambitos_fijado = false;
+static pthread_mutex_t cerrojo_hilo = PTHREAD_MUTEX_INITIALIZER;
+
+typedef struct {
+  MedicionInstr *medicion;
+  uint64_t hw_anterior[NUM_CONTADORES_HW];  // Lectura al activarla
+} EstadoHilo;
+
+static pthread_key_t clave_estado;
+static pthread_once_t clave_creada = PTHREAD_ONCE_INIT;
+static bool clave_lista = false;   // Ningún hilo activó una medición todavía
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SUMAR_RELAJADO(campo, n) __atomic_fetch_add(&(campo), (n), __ATOMIC_RELAXED)
+#else
+#define SUMAR_RELAJADO(campo, n) ((campo) += (n))
+#endif
+
+// El primer hilo que abre un ámbito se queda con el árbol; varios
+// escenarios pueden empezar a la vez en hilos distintos
+static bool es_hilo_ambitos(void) {
+  pthread_mutex_lock(&cerrojo_hilo);
+  if (!hilo_ambitos_fijado) {
+    hilo_ambitos = pthread_self();
+    hilo_ambitos_fijado = true;
+  }
+  bool propio = pthread_equal(hilo_ambitos, pthread_self());
+  pthread_mutex_unlock(&cerrojo_hilo);
+  return propio;
+}
+
+uint64_t instr_reloj_ns(void) {
+#ifdef _WIN32
+  LARGE_INTEGER frecuencia, contador;
+  QueryPerformanceFrequency(&frecuencia);
+  QueryPerformanceCounter(&contador);
+  return (uint64_t)((double)contador.QuadPart * 1e9 / (double)frecuencia.QuadPart);
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+static void crear_clave(void) {
+  pthread_key_create(&clave_estado, free);
+#if defined(__GNUC__) || defined(__clang__)
+  __atomic_store_n(&clave_lista, true, __ATOMIC_RELEASE);
+#else
+  clave_lista = true;
+#endif
+}
+
+static EstadoHilo* estado_hilo(void) {
+#if defined(__GNUC__) || defined(__clang__)
+  if (!__atomic_load_n(&clave_lista, __ATOMIC_ACQUIRE)) return NULL;
+#else
+  if (!clave_lista) return NULL;
+#endif
+  return (EstadoHilo *)pthread_getspecific(clave_estado);
+}
+
+void instr_contar(Contador contador, uint64_t n) {
+  SUMAR_RELAJADO(contadores[contador], n);
+  EstadoHilo *estado = estado_hilo();
+  if (estado && estado->medicion) SUMAR_RELAJADO(estado->medicion->contadores[contador], n);
+}
+
+MedicionInstr* instr_medicion_cambiar(MedicionInstr *medicion) {
+  pthread_once(&clave_creada, crear_clave);
+  EstadoHilo *estado = (EstadoHilo *)pthread_getspecific(clave_estado);
+  if (!estado) {
+    if (!medicion) return NULL;
+    // Fuera de bio_malloc: no es memoria de ninguna etapa
+    estado = (EstadoHilo *)calloc(1, sizeof(EstadoHilo));
+    if (!estado) return NULL;
+    pthread_setspecific(clave_estado, estado);
+  }
+  MedicionInstr *anterior = estado->medicion;
+  if (anterior == medicion) return anterior;
+
+  if (contadores_hw_activos()) {
+    uint64_t hw[NUM_CONTADORES_HW];
+    contadores_hw_hilo_leer(hw);
+    for (int c = 0; c < NUM_CONTADORES_HW; c++) {
+      if (anterior) SUMAR_RELAJADO(anterior->contadores_hw[c], hw[c] - estado->hw_anterior[c]);
+      estado->hw_anterior[c] = hw[c];
+    }
+  }
+  estado->medicion = medicion;
+  memoria_hilo_acumular(medicion ? &medicion->memoria : NULL);
+  return anterior;
+}
+
+MedicionInstr* instr_medicion_actual(void) {
+  EstadoHilo *estado = estado_hilo();
+  return estado ? estado->medicion : NULL;
+}
+
+uint64_t instr_contador(Contador contador) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __atomic_load_n(&contadores[contador], __ATOMIC_RELAXED);
+#else
+  return contadores[contador];
+#endif
+}
+
+// Busca el hijo con ese nombre bajo el ámbito actual o lo crea
+static int buscar_o_crear_hijo(const char *nombre) {
+  // Las raíces se enlazan como hermanas a partir del nodo 0
+  int hijo = nodo_actual >= 0 ? nodos[nodo_actual].primer_hijo : (num_nodos > 0 ? 0 : -1);
+  for (; hijo >= 0; hijo = nodos[hijo].siguiente_hermano) {
+    if (nodos[hijo].nombre == nombre || strcmp(nodos[hijo].nombre, nombre) == 0) {
+      return hijo;
+    }
+  }
+  if (num_nodos >= INSTR_MAX_AMBITOS) return -1;
+
+  int nuevo = num_nodos++;
+  NodoAmbito *nodo = &nodos[nuevo];
+  memset(nodo, 0, sizeof(NodoAmbito));
+  nodo->nombre = nombre;
+  nodo->padre = nodo_actual;
+  nodo->primer_hijo = -1;
+  nodo->ultimo_hijo = -1;
+  nodo->siguiente_hermano = -1;
+
+  if (nodo_actual >= 0) {
+    NodoAmbito *padre = &nodos[nodo_actual];
+    if (padre->ultimo_hijo >= 0) {
+      nodos[padre->ultimo_hijo].siguiente_hermano = nuevo;
+    } else {
+      padre->primer_hijo = nuevo;
+    }
+    padre->ultimo_hijo = nuevo;
+  } else if (nuevo > 0) {
+    // Enlazar tras la última raíz
+    int raiz = 0;
+    while (nodos[raiz].siguiente_hermano >= 0) raiz = nodos[raiz].siguiente_hermano;
+    nodos[raiz].siguiente_hermano = nuevo;
+  }
+  return nuevo;
+}
+
+AmbitoInstr instr_ambito_abrir(const char *nombre) {
+  AmbitoInstr ambito;
+  if (!es_hilo_ambitos()) {
+    // Ámbito de otro hilo: no se registra ni toca el pico de memoria
+    memset(&ambito, 0, sizeof(ambito));
+    ambito.nodo = -1;
+    ambito.pico_memoria_exterior = INT64_MIN;
+    return ambito;
+  }
+  ambito.nodo = buscar_o_crear_hijo(nombre);
+  if (ambito.nodo >= 0) nodo_actual = ambito.nodo;
+  for (int c = 0; c < NUM_CONTADORES; c++) {
+    ambito.contadores_inicio[c] = instr_contador((Contador)c);
+  }
+  ambito.pico_memoria_exterior = memoria_pico_reiniciar();
+  memoria_estadisticas(&ambito.memoria_inicio);
+  ambito.inicio_ns = instr_reloj_ns();
+  return ambito;
+}
+
+void instr_ambito_cerrar(const AmbitoInstr *ambito) {
+  uint64_t fin_ns = instr_reloj_ns();
+  EstadisticasMemoria memoria;
+  memoria_estadisticas(&memoria);
+  memoria_pico_restaurar(ambito->pico_memoria_exterior);
+  if (ambito->nodo < 0) return;  // Tabla llena: ámbito sin registrar
+
+  NodoAmbito *nodo = &nodos[ambito->nodo];
+  nodo->llamadas++;
+  nodo->total_ns += fin_ns - ambito->inicio_ns;
+  for (int c = 0; c < NUM_CONTADORES; c++) {
+    nodo->contadores[c] += instr_contador((Contador)c) - ambito->contadores_inicio[c];
+  }
+  nodo->bytes_asignados += memoria.bytes_asignados - ambito->memoria_inicio.bytes_asignados;
+  nodo->asignaciones += memoria.asignaciones - ambito->memoria_inicio.asignaciones;
+  nodo->variacion_vivos += memoria.bytes_vivos - ambito->memoria_inicio.bytes_vivos;
+  if (memoria.pico_bytes_vivos > nodo->pico_vivos) nodo->pico_vivos = memoria.pico_bytes_vivos;
+  long long rss = memoria_pico_rss_kb();
+  if (rss > nodo->pico_rss_kb) nodo->pico_rss_kb = rss;
+  nodo_actual = nodo->padre;
+}
+
+void instr_ambito_agregar(const char *nombre, const MedicionInstr *medicion) {
+  if (!es_hilo_ambitos()) return;
+  int id = buscar_o_crear_hijo(nombre);
+  if (id < 0) return;
+
+  NodoAmbito *nodo = &nodos[id];
+  nodo->llamadas++;
+  nodo->total_ns += medicion->total_ns;
+  for (int c = 0; c < NUM_CONTADORES; c++) nodo->contadores[c] += medicion->contadores[c];
+  nodo->bytes_asignados += medicion->memoria.bytes_asignados;
+  nodo->asignaciones += medicion->memoria.asignaciones;
+  nodo->variacion_vivos += medicion->memoria.bytes_vivos;
+  if (medicion->memoria.pico_bytes_vivos > nodo->pico_vivos) {
+    nodo->pico_vivos = medicion->memoria.pico_bytes_vivos;
+  }
+  if (medicion->pico_rss_kb > nodo->pico_rss_kb) nodo->pico_rss_kb = medicion->pico_rss_kb;
+}
+
+void instr_reiniciar(void) {
+  num_nodos = 0;
+  nodo_actual = -1;
+  pthread_mutex_lock(&cerrojo_hilo);
+  hilo_ambitos_fijado = false;
+  pthread_mutex_unlock(&cerrojo_hilo);
+  for (int c = 0; c < NUM_CONTADORES; c++) {
+#if defined(__GNUC__) || defined(__clang__)
+    __atomic_store_n(&contadores[c], 0, __ATOMIC_RELAXED);
+#else
+    contadores[c] = 0;
+#endif
+  }
+}
+
+static void imprimir_nodo(FILE *salida, int id, int profundidad) {
+  NodoAmbito *nodo = &nodos[id];
+
+  uint64_t hijos_ns = 0;
+  for (int h = nodo->primer_hijo; h >= 0; h = nodos[h].siguiente_hermano) {
+    hijos_ns += nodos[h].total_ns;
+  }
+  uint64_t propio_ns = nodo->total_ns > hijos_ns ? nodo->total_ns - hijos_ns : 0;
+  double porcentaje = 100.0;
+  if (nodo->padre >= 0 && nodos[nodo->padre].total_ns > 0) {
+    porcentaje = 100.0 * (double)nodo->total_ns / (double)nodos[nodo->padre].total_ns;
+  }
+
+  fprintf(salida, "%*s%-*s %8llu %12.3f %12.3f %7.1f\n",
+          profundidad * 2, "", 34 - profundidad * 2, nodo->nombre,
+          (unsigned long long)nodo->llamadas,
+          (double)nodo->total_ns / 1e6, (double)propio_ns / 1e6, porcentaje);
+  for (int c = 0; c < NUM_CONTADORES; c++) {
+    if (nodo->contadores[c] > 0) {
+      fprintf(salida, "%*s  [%s: %llu]\n", profundidad * 2, "",
+              NOMBRES_CONTADORES[c], (unsigned long long)nodo->contadores[c]);
+    }
+  }
+  if (nodo->asignaciones > 0 || nodo->pico_rss_kb > 0) {
+    fprintf(salida, "%*s  [memoria: %.2f MB en %llu asignaciones, vivos %+.2f MB, "
+                    "pico vivos %.2f MB, pico RSS %.1f MB]\n",
+            profundidad * 2, "", (double)nodo->bytes_asignados / 1048576.0,
+            (unsigned long long)nodo->asignaciones, (double)nodo->variacion_vivos / 1048576.0,
+            (double)nodo->pico_vivos / 1048576.0, (double)nodo->pico_rss_kb / 1024.0);
+  }
+
+  for (int h = nodo->primer_hijo; h >= 0; h = nodos[h].siguiente_hermano) {
+    imprimir_nodo(salida, h, profundidad + 1);
+  }
+}
+
+void instr_reporte(FILE *salida) {
+  fprintf(salida, "\n========== INSTRUMENTACION ==========\n");
+  fprintf(salida, "%-34s %8s %12s %12s %7s\n",
+          "Ambito", "Llamadas", "Total ms", "Propio ms", "% padre");
+  fprintf(salida, "----------------------------------+--------+------------+------------+-------\n");
+  if (num_nodos > 0) {
+    for (int raiz = 0; raiz >= 0; raiz = nodos[raiz].siguiente_hermano) {
+      imprimir_nodo(salida, raiz, 0);
+    }
+  }
+
+  fprintf(salida, "\nContadores totales:\n");
+  for (int c = 0; c < NUM_CONTADORES; c++) {
+    fprintf(salida, "  %-20s %llu\n", NOMBRES_CONTADORES[c],
+            (unsigned long long)instr_contador((Contador)c));
+  }
+
+  EstadisticasMemoria memoria;
+  memoria_estadisticas(&memoria);
+  fprintf(salida, "\nMemoria:\n");
+  fprintf(salida, "  %-20s %.2f MB\n", "asignados", (double)memoria.bytes_asignados / 1048576.0);
+  fprintf(salida, "  %-20s %llu\n", "asignaciones", (unsigned long long)memoria.asignaciones);
+  fprintf(salida, "  %-20s %llu\n", "liberaciones", (unsigned long long)memoria.liberaciones);
+  fprintf(salida, "  %-20s %.2f MB\n", "vivos", (double)memoria.bytes_vivos / 1048576.0);
+  fprintf(salida, "  %-20s %.2f MB\n", "pico vivos", (double)memoria.pico_bytes_vivos / 1048576.0);
+  fprintf(salida, "  %-20s %.1f MB\n", "pico RSS", (double)memoria_pico_rss_kb() / 1024.0);
+  fprintf(salida, "=====================================\n");
+}
@@ -0,0 +1,153 @@
+#ifndef INSTRUMENTACION_H
+#define INSTRUMENTACION_H
+
+#include "contadores_hw.h"
+#include "memoria.h"
+#include <stdint.h>
+#include <stdio.h>
+
+// ============================================================
+// INSTRUMENTACION - Tiempos jerárquicos y contadores por etapa
+// Se activa compilando con -DBIOSIM_INSTRUMENTACION (el Makefile lo
+// hace por defecto; make INSTRUMENTACION=0 la deja fuera). Sin la
+// bandera las macros INSTR_* no generan código.
+//
+// Uso:
+//   INSTR_AMBITO_INICIO(ambito, "propagacion");
+//   ...                                   // INSTR_CONTAR(CONTADOR_..., n)
+//   INSTR_AMBITO_FIN(ambito);
+//   INSTR_REPORTE(stdout);                // al final de main
+//
+// Los ámbitos se anidan según el orden de apertura y se abren y cierran
+// desde el hilo principal (el que abre el primero); los que se abren en
+// otros hilos, p.ej. dentro de etapas concurrentes, se ignoran. Los
+// contadores se pueden incrementar desde cualquier hilo; cada ámbito
+// acumula lo contado mientras estuvo abierto.
+// Cada ámbito registra además la memoria de su etapa (ver memoria.h):
+// bytes y número de asignaciones, variación de bytes vivos, pico de bytes
+// vivos dentro del ámbito y pico de RSS del proceso al cerrarlo.
+//
+// El trabajo que corre a la vez en otros hilos (etapas concurrentes) se
+// mide con un MedicionInstr: mientras un hilo lo tiene activo
+// (instr_medicion_cambiar) sus contadores, su memoria y sus contadores de
+// hardware se suman también ahí, y las tareas del pool heredan la
+// medición del hilo que las lanza. Al terminar, el hilo principal la
+// agrega al árbol con instr_ambito_agregar.
+// ============================================================
+
+// Máximo de ámbitos distintos (nombre + padre) en el árbol
+#define INSTR_MAX_AMBITOS 128
+
+typedef enum {
+  CONTADOR_EVENTOS_PROCESADOS,
+  CONTADOR_HEAP_INSERCIONES,
+  CONTADOR_HEAP_EXTRACCIONES,
+  CONTADOR_ARISTAS_RELAJADAS,
+  CONTADOR_BUSQUEDAS_DIRECTAS,   // MapaIds: resueltas por el índice directo
+  CONTADOR_HASH_BUSQUEDAS,
+  CONTADOR_HASH_SONDEOS,
+  NUM_CONTADORES
+} Contador;
+
+// Ámbito abierto: nodo del árbol y estado al abrir
+typedef struct {
+  int nodo;
+  uint64_t inicio_ns;
+  uint64_t contadores_inicio[NUM_CONTADORES];
+  EstadisticasMemoria memoria_inicio;
+  int64_t pico_memoria_exterior;  // Pico del ámbito padre, restaurado al cerrar
+} AmbitoInstr;
+
+// Trabajo medido fuera del hilo principal. Se pone a cero antes de usar;
+// total_ns y pico_rss_kb los completa quien mide
+typedef struct {
+  uint64_t total_ns;
+  uint64_t contadores[NUM_CONTADORES];
+  EstadisticasMemoria memoria;          // Lo asignado y liberado por sus hilos
+  uint64_t contadores_hw[NUM_CONTADORES_HW];
+  long long pico_rss_kb;
+} MedicionInstr;
+
+/**
+ * Reloj monótono en nanosegundos (disponible aunque la instrumentación
+ * esté desactivada)
+ * Complejidad: O(1)
+ */
+uint64_t instr_reloj_ns(void);
+
+/**
+ * Suma n a un contador global (atómico, apto para varios hilos) y a la
+ * medición activa del hilo, si hay una
+ * Complejidad: O(1)
+ */
+void instr_contar(Contador contador, uint64_t n);
+
+/**
+ * Valor actual de un contador
+ * Complejidad: O(1)
+ */
+uint64_t instr_contador(Contador contador);
+
+/**
+ * Abre un ámbito hijo del ámbito abierto actual (nombre: cadena estática)
+ * Complejidad: O(hijos del ámbito actual)
+ */
+AmbitoInstr instr_ambito_abrir(const char *nombre);
+
+/**
+ * Cierra el ámbito y acumula su tiempo, contadores y memoria
+ * Complejidad: O(NUM_CONTADORES)
+ */
+void instr_ambito_cerrar(const AmbitoInstr *ambito);
+
+/**
+ * Activa una medición en el hilo actual (NULL = ninguna). Los contadores
+ * de hardware del hilo desde el último cambio se suman a la medición que
+ * estaba activa
+ * Complejidad: O(NUM_CONTADORES_HW) (O(1) si no hay cambio)
+ * Retorna: La medición que estaba activa, para restaurarla después
+ */
+MedicionInstr* instr_medicion_cambiar(MedicionInstr *medicion);
+
+/**
+ * Medición activa en el hilo actual (NULL si ninguna)
+ * Complejidad: O(1)
+ */
+MedicionInstr* instr_medicion_actual(void);
+
+/**
+ * Agrega una medición terminada como una llamada de un ámbito hijo del
+ * ámbito abierto actual (solo desde el hilo de los ámbitos). Su pico de
+ * vivos es el de la propia medición, sin lo que ya estaba vivo
+ * Complejidad: O(hijos del ámbito actual + NUM_CONTADORES)
+ */
+void instr_ambito_agregar(const char *nombre, const MedicionInstr *medicion);
+
+/**
+ * Descarta ámbitos y contadores acumulados
+ * Complejidad: O(1)
+ */
+void instr_reiniciar(void);
+
+/**
+ * Imprime el árbol de ámbitos (llamadas, tiempo total y propio, % del
+ * padre, contadores, memoria) y los totales de cada contador
+ * Complejidad: O(ámbitos * NUM_CONTADORES)
+ */
+void instr_reporte(FILE *salida);
+
+#ifdef BIOSIM_INSTRUMENTACION
+#define INSTR_AMBITO_INICIO(var, nombre) AmbitoInstr var = instr_ambito_abrir(nombre)
+#define INSTR_AMBITO_FIN(var) instr_ambito_cerrar(&(var))
+#define INSTR_AMBITO_AGREGAR(nombre, medicion) instr_ambito_agregar((nombre), (medicion))
+#define INSTR_CONTAR(contador, n) instr_contar((contador), (uint64_t)(n))
+#define INSTR_REPORTE(salida) instr_reporte(salida)
+#else
+#define INSTR_AMBITO_INICIO(var, nombre) ((void)0)
+#define INSTR_AMBITO_FIN(var) ((void)0)
+#define INSTR_AMBITO_AGREGAR(nombre, medicion) ((void)0)
+#define INSTR_CONTAR(contador, n) ((void)0)
+#define INSTR_REPORTE(salida) ((void)0)
+#endif
+
+#endif // INSTRUMENTACION_H
@@ -0,0 +1,190 @@
+#include "mapa_ids.h"
+#include "instrumentacion.h"
+#include "memoria.h"
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================
+// IMPLEMENTACION MAPA DE IDS
+// El tramo se busca con histogramas: se reparte [minimo, maximo] en
+// MAPA_IDS_CUBETAS cubetas y se toma la ventana de cubetas contiguas
+// con más IDs que cumpla la densidad. Si ninguna junta la mitad de los
+// IDs (p. ej. IDs densos más unos pocos IDs enormes que estiran el
+// rango) se repite dentro de la cubeta más poblada, hasta
+// MAPA_IDS_RONDAS veces. Cada ronda es O(n + cubetas^2).
+// ============================================================
+
+#define MAPA_IDS_CUBETAS 256
+#define MAPA_IDS_RONDAS 4
+
+// Tramo [desde, hasta] de IDs con 'cantidad' individuos
+typedef struct {
+  long long desde;
+  long long hasta;
+  int cantidad;
+} TramoIds;
+
+static bool es_denso(long long ancho, long long cantidad) {
+  return ancho <= MAPA_IDS_DISPERSION_MAXIMA * cantidad;
+}
+
+static TramoIds elegir_tramo(const int *ids, int n) {
+  TramoIds mejor = { 0, -1, 0 };
+  if (n <= 0) return mejor;
+
+  long long minimo = ids[0], maximo = ids[0];
+  for (int i = 1; i < n; i++) {
+    if (ids[i] < minimo) minimo = ids[i];
+    if (ids[i] > maximo) maximo = ids[i];
+  }
+
+  int cuenta[MAPA_IDS_CUBETAS];
+  for (int ronda = 0; ronda < MAPA_IDS_RONDAS; ronda++) {
+    long long ancho = (maximo - minimo + 1 + MAPA_IDS_CUBETAS - 1) / MAPA_IDS_CUBETAS;
+    int dentro = 0;
+    memset(cuenta, 0, sizeof(cuenta));
+    for (int i = 0; i < n; i++) {
+      if (ids[i] < minimo || ids[i] > maximo) continue;
+      cuenta[(ids[i] - minimo) / ancho]++;
+      dentro++;
+    }
+    if (es_denso(maximo - minimo + 1, dentro)) {
+      TramoIds todo = { minimo, maximo, dentro };
+      mejor = todo;
+      break;
+    }
+
+    // Ventana de cubetas más poblada que siga siendo densa
+    for (int a = 0; a < MAPA_IDS_CUBETAS; a++) {
+      int suma = 0;
+      for (int b = a; b < MAPA_IDS_CUBETAS; b++) {
+        suma += cuenta[b];
+        if (suma > mejor.cantidad && es_denso((long long)(b - a + 1) * ancho, suma)) {
+          long long hasta = minimo + (long long)(b + 1) * ancho - 1;
+          TramoIds ventana = { minimo + (long long)a * ancho, hasta < maximo ? hasta : maximo, suma };
+          mejor = ventana;
+        }
+      }
+    }
+    if ((long long)mejor.cantidad * 2 >= n) break;
+
+    // Acercarse a la cubeta más poblada (si todavía puede tener la mitad)
+    int c = 0;
+    for (int k = 1; k < MAPA_IDS_CUBETAS; k++) {
+      if (cuenta[k] > cuenta[c]) c = k;
+    }
+    if ((long long)cuenta[c] * 2 < n || ancho == 1) break;
+    minimo += (long long)c * ancho;
+    if (minimo + ancho - 1 < maximo) maximo = minimo + ancho - 1;
+  }
+
+  if ((long long)mejor.cantidad * 2 < n) {
+    TramoIds ninguno = { 0, -1, 0 };
+    return ninguno;
+  }
+
+  // Ajustar a los IDs que realmente hay dentro
+  long long desde = mejor.hasta, hasta = mejor.desde;
+  for (int i = 0; i < n; i++) {
+    if (ids[i] < mejor.desde || ids[i] > mejor.hasta) continue;
+    if (ids[i] < desde) desde = ids[i];
+    if (ids[i] > hasta) hasta = ids[i];
+  }
+  mejor.desde = desde;
+  mejor.hasta = hasta;
+  return mejor;
+}
+
+static inline bool en_tramo(const MapaIds *mapa, int individuo_id, unsigned *posicion) {
+  *posicion = (unsigned)individuo_id - (unsigned)mapa->id_minimo;
+  return *posicion < (unsigned)mapa->rango;
+}
+
+MapaIds* mapa_ids_construir(const int *ids, int n) {
+  MapaIds *mapa = (MapaIds *)bio_calloc(1, sizeof(MapaIds));
+  if (!mapa) return NULL;
+
+  TramoIds tramo = elegir_tramo(ids, n);
+  long long rango = tramo.hasta - tramo.desde + 1;
+  if (tramo.cantidad > 0 && rango <= INT_MAX) {
+    mapa->directo = (int *)bio_malloc((size_t)rango * sizeof(int));
+    if (!mapa->directo) {
+      bio_free(mapa);
+      return NULL;
+    }
+    memset(mapa->directo, 0xFF, (size_t)rango * sizeof(int));  // -1
+    mapa->id_minimo = (int)tramo.desde;
+    mapa->rango = (int)rango;
+  }
+
+  for (int i = 0; i < n; i++) {
+    unsigned posicion;
+    if (en_tramo(mapa, ids[i], &posicion)) {
+      if (mapa->directo[posicion] < 0) mapa->num_directos++;
+      mapa->directo[posicion] = i;
+      continue;
+    }
+    if (!mapa->dispersos) {
+      mapa->dispersos = hash_concurrente_crear(0);
+      if (!mapa->dispersos || !hash_concurrente_reservar(mapa->dispersos, n - mapa->num_directos)) {
+        mapa_ids_liberar(mapa);
+        return NULL;
+      }
+    }
+    hash_concurrente_insertar(mapa->dispersos, ids[i], i);
+  }
+  return mapa;
+}
+
+int mapa_ids_buscar(const MapaIds *mapa, int individuo_id) {
+  unsigned posicion;
+  if (en_tramo(mapa, individuo_id, &posicion)) {
+    INSTR_CONTAR(CONTADOR_BUSQUEDAS_DIRECTAS, 1);
+    return mapa->directo[posicion];
+  }
+  return hash_concurrente_buscar(mapa->dispersos, individuo_id);
+}
+
+void mapa_ids_buscar_lote(const MapaIds *mapa, const int *individuo_ids, int n, int *filas) {
+  int sueltos = 0;
+  for (int i = 0; i < n; i++) {
+    unsigned posicion;
+    if (en_tramo(mapa, individuo_ids[i], &posicion)) {
+      filas[i] = mapa->directo[posicion];
+    } else {
+      filas[i] = -1;
+      sueltos++;
+    }
+  }
+  INSTR_CONTAR(CONTADOR_BUSQUEDAS_DIRECTAS, n - sueltos);
+  if (sueltos == 0 || !mapa->dispersos) return;
+
+  // Los sueltos, juntos, a la tabla hash
+  int *claves = (int *)bio_malloc((size_t)sueltos * 3 * sizeof(int));
+  if (!claves) {
+    for (int i = 0; i < n; i++) {
+      if (filas[i] < 0) filas[i] = mapa_ids_buscar(mapa, individuo_ids[i]);
+    }
+    return;
+  }
+  int *origen = claves + sueltos;
+  int *resultado = origen + sueltos;
+  int k = 0;
+  for (int i = 0; i < n; i++) {
+    unsigned posicion;
+    if (en_tramo(mapa, individuo_ids[i], &posicion)) continue;
+    claves[k] = individuo_ids[i];
+    origen[k++] = i;
+  }
+  hash_concurrente_buscar_lote(mapa->dispersos, claves, sueltos, resultado);
+  for (k = 0; k < sueltos; k++) filas[origen[k]] = resultado[k];
+  bio_free(claves);
+}
+
+void mapa_ids_liberar(MapaIds *mapa) {
+  if (!mapa) return;
+  bio_free(mapa->directo);
+  hash_concurrente_liberar(mapa->dispersos);
+  bio_free(mapa);
+}
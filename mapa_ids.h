@@ -0,0 +1,57 @@
+#ifndef MAPA_IDS_H
+#define MAPA_IDS_H
+
+#include "estructuras.h"
+#include "hash_concurrente.h"
+
+// ============================================================
+// MAPA DE IDS - Individuo ID -> fila de la Poblacion
+// Los IDs de inicializar_poblacion son densos (0..n-1): para el tramo
+// denso la fila sale de un arreglo indexado por id - id_minimo (una sola
+// lectura) y solo los IDs sueltos fuera del tramo van a una tabla hash.
+// El tramo se elige al construir; el mapa no cambia después, así que
+// las consultas no toman cerrojos (salvo las de la tabla de sueltos).
+// ============================================================
+
+// Densidad mínima del tramo directo: al menos 1 de cada
+// MAPA_IDS_DISPERSION_MAXIMA posiciones del arreglo tiene un individuo
+#define MAPA_IDS_DISPERSION_MAXIMA 2
+
+typedef struct {
+  int id_minimo;                     // Primer ID del tramo directo
+  int rango;                         // IDs [id_minimo, id_minimo + rango) (0 = sin tramo)
+  int *directo;                      // rango filas (-1 = ID sin individuo)
+  int num_directos;                  // IDs guardados en el tramo
+  TablaHashConcurrente *dispersos;   // IDs fuera del tramo (NULL si no hay)
+} MapaIds;
+
+/**
+ * Construye el mapa de n IDs (ids[i] es el individuo de la fila i).
+ * Elige el tramo con más IDs que cumpla la densidad mínima; el resto va
+ * a la tabla hash (todos si no hay un tramo que tenga la mitad)
+ * Complejidad: O(n)
+ * Retorna: MapaIds o NULL si no hay memoria
+ */
+MapaIds* mapa_ids_construir(const int *ids, int n);
+
+/**
+ * Fila de un individuo: una lectura del arreglo si el ID cae en el tramo
+ * Complejidad: O(1) (O(1) promedio para IDs fuera del tramo)
+ * Retorna: Fila del individuo o -1 si no existe
+ */
+int mapa_ids_buscar(const MapaIds *mapa, int individuo_id);
+
+/**
+ * Busca n individuos de una vez; los IDs fuera del tramo se resuelven
+ * juntos con hash_concurrente_buscar_lote
+ * Complejidad: O(n) promedio
+ */
+void mapa_ids_buscar_lote(const MapaIds *mapa, const int *individuo_ids, int n, int *filas);
+
+/**
+ * Libera el arreglo directo y la tabla de sueltos
+ * Complejidad: O(1)
+ */
+void mapa_ids_liberar(MapaIds *mapa);
+
+#endif // MAPA_IDS_H
@@ -0,0 +1,114 @@
+#define _POSIX_C_SOURCE 200809L
+#include "mapeo_archivo.h"
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// ============================================================
+// IMPLEMENTACION MAPEO DE ARCHIVOS
+// ============================================================
+
+#ifdef _WIN32
+
+bool mapeo_archivo_abrir(MapeoArchivo *mapeo, const char *ruta, ModoMapeo modo) {
+  memset(mapeo, 0, sizeof(MapeoArchivo));
+
+  HANDLE archivo = CreateFileA(ruta, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                               FILE_ATTRIBUTE_NORMAL, NULL);
+  if (archivo == INVALID_HANDLE_VALUE) return false;
+
+  LARGE_INTEGER tamano;
+  if (!GetFileSizeEx(archivo, &tamano)) {
+    CloseHandle(archivo);
+    return false;
+  }
+
+  mapeo->archivo = archivo;
+  mapeo->tamano = (size_t)tamano.QuadPart;
+  if (mapeo->tamano == 0) return true;
+
+  DWORD proteccion = modo == MAPEO_COPIA_PRIVADA ? PAGE_WRITECOPY : PAGE_READONLY;
+  DWORD acceso = modo == MAPEO_COPIA_PRIVADA ? FILE_MAP_COPY : FILE_MAP_READ;
+
+  HANDLE seccion = CreateFileMappingA(archivo, NULL, proteccion, 0, 0, NULL);
+  if (!seccion) {
+    CloseHandle(archivo);
+    return false;
+  }
+
+  mapeo->seccion = seccion;
+  mapeo->datos = MapViewOfFile(seccion, acceso, 0, 0, 0);
+  if (!mapeo->datos) {
+    CloseHandle(seccion);
+    CloseHandle(archivo);
+    return false;
+  }
+
+  return true;
+}
+
+void mapeo_archivo_acceso_secuencial(MapeoArchivo *mapeo) {
+  (void)mapeo; // Sin equivalente directo: Windows detecta el patrón por sí solo
+}
+
+void mapeo_archivo_cerrar(MapeoArchivo *mapeo) {
+  if (mapeo->datos) UnmapViewOfFile(mapeo->datos);
+  if (mapeo->seccion) CloseHandle((HANDLE)mapeo->seccion);
+  if (mapeo->archivo) CloseHandle((HANDLE)mapeo->archivo);
+  memset(mapeo, 0, sizeof(MapeoArchivo));
+}
+
+#else
+
+bool mapeo_archivo_abrir(MapeoArchivo *mapeo, const char *ruta, ModoMapeo modo) {
+  memset(mapeo, 0, sizeof(MapeoArchivo));
+
+  int descriptor = open(ruta, O_RDONLY);
+  if (descriptor < 0) return false;
+
+  struct stat info;
+  if (fstat(descriptor, &info) != 0) {
+    close(descriptor);
+    return false;
+  }
+
+  mapeo->tamano = (size_t)info.st_size;
+  if (mapeo->tamano == 0) {
+    close(descriptor);
+    return true;
+  }
+
+  int proteccion = modo == MAPEO_COPIA_PRIVADA ? (PROT_READ | PROT_WRITE) : PROT_READ;
+  int banderas = modo == MAPEO_COPIA_PRIVADA ? MAP_PRIVATE : MAP_SHARED;
+  void *datos = mmap(NULL, mapeo->tamano, proteccion, banderas, descriptor, 0);
+
+  // El mapeo sigue siendo válido después de cerrar el descriptor
+  close(descriptor);
+  if (datos == MAP_FAILED) {
+    mapeo->tamano = 0;
+    return false;
+  }
+
+  mapeo->datos = datos;
+  return true;
+}
+
+void mapeo_archivo_acceso_secuencial(MapeoArchivo *mapeo) {
+  if (mapeo->datos) {
+    posix_madvise(mapeo->datos, mapeo->tamano, POSIX_MADV_SEQUENTIAL);
+  }
+}
+
+void mapeo_archivo_cerrar(MapeoArchivo *mapeo) {
+  if (mapeo->datos) munmap(mapeo->datos, mapeo->tamano);
+  memset(mapeo, 0, sizeof(MapeoArchivo));
+}
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef MAPEO_ARCHIVO_H
+#define MAPEO_ARCHIVO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// ============================================================
+// MAPEO DE ARCHIVOS EN MEMORIA
+// Envoltura mínima sobre mmap (POSIX) y MapViewOfFile (Windows)
+// Las páginas se cargan bajo demanda desde la caché del sistema y se
+// comparten entre procesos que mapean el mismo archivo.
+// ============================================================
+
+typedef enum {
+  MAPEO_LECTURA,       // Solo lectura, compartido
+  MAPEO_COPIA_PRIVADA  // Lectura/escritura copy-on-write: las escrituras
+                       // no llegan al archivo ni a otros procesos
+} ModoMapeo;
+
+typedef struct {
+  void *datos;     // Inicio de la vista (NULL si el archivo está vacío)
+  size_t tamano;   // Bytes mapeados (= tamaño del archivo)
+#ifdef _WIN32
+  void *archivo;   // HANDLE del archivo
+  void *seccion;   // HANDLE del objeto de mapeo
+#endif
+} MapeoArchivo;
+
+/**
+ * Mapea el archivo completo en memoria
+ * Complejidad: O(1) (las páginas se leen al primer acceso)
+ * Retorna: true si se pudo abrir y mapear
+ */
+bool mapeo_archivo_abrir(MapeoArchivo *mapeo, const char *ruta, ModoMapeo modo);
+
+/**
+ * Indica al sistema que la vista se recorrerá de forma secuencial
+ * (lectura anticipada más agresiva). Es solo una sugerencia
+ * Complejidad: O(1)
+ */
+void mapeo_archivo_acceso_secuencial(MapeoArchivo *mapeo);
+
+/**
+ * Desmapea la vista y cierra el archivo
+ * Complejidad: O(1)
+ */
+void mapeo_archivo_cerrar(MapeoArchivo *mapeo);
+
+#endif // MAPEO_ARCHIVO_H
@@ -0,0 +1,208 @@
+#define _POSIX_C_SOURCE 200809L
+#include "memoria.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+// ============================================================
+// IMPLEMENTACION MEMORIA
+// Cabecera de 16 bytes delante de cada bloque (mantiene la alineación de
+// malloc) con el tamaño pedido; contadores globales atómicos y, si el
+// hilo fijó uno, su acumulador (también atómico: lo comparten los hilos
+// que trabajan para la misma medición)
+// ============================================================
+
+#define CABECERA_MEMORIA 16
+
+static EstadisticasMemoria contadores;
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SUMAR(campo, n) __atomic_add_fetch(&(campo), (n), __ATOMIC_RELAXED)
+#define LEER(campo) __atomic_load_n(&(campo), __ATOMIC_RELAXED)
+#else
+#define SUMAR(campo, n) ((campo) += (n))
+#define LEER(campo) (campo)
+#endif
+
+static pthread_key_t clave_acumulador;
+static pthread_once_t clave_creada = PTHREAD_ONCE_INIT;
+static bool clave_lista = false;   // Ningún hilo fijó acumulador todavía
+
+static void crear_clave(void) {
+  pthread_key_create(&clave_acumulador, NULL);
+#if defined(__GNUC__) || defined(__clang__)
+  __atomic_store_n(&clave_lista, true, __ATOMIC_RELEASE);
+#else
+  clave_lista = true;
+#endif
+}
+
+static void actualizar_pico(EstadisticasMemoria *estadisticas, int64_t vivos) {
+#if defined(__GNUC__) || defined(__clang__)
+  int64_t pico = __atomic_load_n(&estadisticas->pico_bytes_vivos, __ATOMIC_RELAXED);
+  while (vivos > pico &&
+         !__atomic_compare_exchange_n(&estadisticas->pico_bytes_vivos, &pico, vivos, true,
+                                      __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+  }
+#else
+  if (vivos > estadisticas->pico_bytes_vivos) estadisticas->pico_bytes_vivos = vivos;
+#endif
+}
+
+#ifdef BIOSIM_INSTRUMENTACION
+
+static EstadisticasMemoria* acumulador_hilo(void) {
+#if defined(__GNUC__) || defined(__clang__)
+  if (!__atomic_load_n(&clave_lista, __ATOMIC_ACQUIRE)) return NULL;
+#else
+  if (!clave_lista) return NULL;
+#endif
+  return (EstadisticasMemoria *)pthread_getspecific(clave_acumulador);
+}
+
+static void registrar_asignacion(size_t bytes) {
+  SUMAR(contadores.bytes_asignados, (uint64_t)bytes);
+  SUMAR(contadores.asignaciones, 1);
+  actualizar_pico(&contadores, SUMAR(contadores.bytes_vivos, (int64_t)bytes));
+
+  EstadisticasMemoria *acumulador = acumulador_hilo();
+  if (acumulador) {
+    SUMAR(acumulador->bytes_asignados, (uint64_t)bytes);
+    SUMAR(acumulador->asignaciones, 1);
+    actualizar_pico(acumulador, SUMAR(acumulador->bytes_vivos, (int64_t)bytes));
+  }
+}
+
+static void registrar_liberacion(size_t bytes) {
+  SUMAR(contadores.liberaciones, 1);
+  SUMAR(contadores.bytes_vivos, -(int64_t)bytes);
+
+  EstadisticasMemoria *acumulador = acumulador_hilo();
+  if (acumulador) {
+    SUMAR(acumulador->liberaciones, 1);
+    SUMAR(acumulador->bytes_vivos, -(int64_t)bytes);
+  }
+}
+
+static void* marcar_bloque(unsigned char *bloque, size_t bytes) {
+  memcpy(bloque, &bytes, sizeof(bytes));
+  return bloque + CABECERA_MEMORIA;
+}
+
+static size_t tamano_bloque(const unsigned char *bloque) {
+  size_t bytes;
+  memcpy(&bytes, bloque, sizeof(bytes));
+  return bytes;
+}
+
+void* bio_malloc(size_t bytes) {
+  if (bytes > SIZE_MAX - CABECERA_MEMORIA) return NULL;
+  unsigned char *bloque = (unsigned char *)malloc(bytes + CABECERA_MEMORIA);
+  if (!bloque) return NULL;
+  registrar_asignacion(bytes);
+  return marcar_bloque(bloque, bytes);
+}
+
+void* bio_calloc(size_t cantidad, size_t tamano) {
+  if (tamano != 0 && cantidad > (SIZE_MAX - CABECERA_MEMORIA) / tamano) return NULL;
+  size_t bytes = cantidad * tamano;
+  unsigned char *bloque = (unsigned char *)calloc(1, bytes + CABECERA_MEMORIA);
+  if (!bloque) return NULL;
+  registrar_asignacion(bytes);
+  return marcar_bloque(bloque, bytes);
+}
+
+void* bio_realloc(void *puntero, size_t bytes) {
+  if (!puntero) return bio_malloc(bytes);
+  if (bytes > SIZE_MAX - CABECERA_MEMORIA) return NULL;
+
+  unsigned char *bloque = (unsigned char *)puntero - CABECERA_MEMORIA;
+  size_t anterior = tamano_bloque(bloque);
+  unsigned char *nuevo = (unsigned char *)realloc(bloque, bytes + CABECERA_MEMORIA);
+  if (!nuevo) return NULL;
+  registrar_liberacion(anterior);
+  registrar_asignacion(bytes);
+  return marcar_bloque(nuevo, bytes);
+}
+
+void bio_free(void *puntero) {
+  if (!puntero) return;
+  unsigned char *bloque = (unsigned char *)puntero - CABECERA_MEMORIA;
+  registrar_liberacion(tamano_bloque(bloque));
+  free(bloque);
+}
+
+#endif
+
+void memoria_estadisticas(EstadisticasMemoria *estadisticas) {
+  estadisticas->bytes_asignados = LEER(contadores.bytes_asignados);
+  estadisticas->asignaciones = LEER(contadores.asignaciones);
+  estadisticas->liberaciones = LEER(contadores.liberaciones);
+  estadisticas->bytes_vivos = LEER(contadores.bytes_vivos);
+  estadisticas->pico_bytes_vivos = LEER(contadores.pico_bytes_vivos);
+}
+
+int64_t memoria_pico_reiniciar(void) {
+  int64_t anterior = LEER(contadores.pico_bytes_vivos);
+#if defined(__GNUC__) || defined(__clang__)
+  __atomic_store_n(&contadores.pico_bytes_vivos, LEER(contadores.bytes_vivos), __ATOMIC_RELAXED);
+#else
+  contadores.pico_bytes_vivos = contadores.bytes_vivos;
+#endif
+  return anterior;
+}
+
+void memoria_pico_restaurar(int64_t pico_guardado) {
+  actualizar_pico(&contadores, pico_guardado);
+}
+
+EstadisticasMemoria* memoria_hilo_acumular(EstadisticasMemoria *acumulador) {
+  pthread_once(&clave_creada, crear_clave);
+  EstadisticasMemoria *anterior = (EstadisticasMemoria *)pthread_getspecific(clave_acumulador);
+  pthread_setspecific(clave_acumulador, acumulador);
+  return anterior;
+}
+
+long long memoria_pico_rss_kb(void) {
+#ifdef _WIN32
+  PROCESS_MEMORY_COUNTERS info;
+  if (!K32GetProcessMemoryInfo(GetCurrentProcess(), &info, sizeof(info))) return -1;
+  return (long long)(info.PeakWorkingSetSize / 1024);
+#else
+  struct rusage uso;
+  if (getrusage(RUSAGE_SELF, &uso) != 0) return -1;
+#ifdef __APPLE__
+  return (long long)uso.ru_maxrss / 1024;  // bytes en macOS
+#else
+  return (long long)uso.ru_maxrss;         // KB en Linux
+#endif
+#endif
+}
+
+long long memoria_rss_actual_kb(void) {
+#ifdef _WIN32
+  PROCESS_MEMORY_COUNTERS info;
+  if (!K32GetProcessMemoryInfo(GetCurrentProcess(), &info, sizeof(info))) return -1;
+  return (long long)(info.WorkingSetSize / 1024);
+#elif defined(__linux__)
+  FILE *archivo = fopen("/proc/self/statm", "r");
+  if (!archivo) return -1;
+  long long paginas_total = 0, paginas_residentes = 0;
+  int leidos = fscanf(archivo, "%lld %lld", &paginas_total, &paginas_residentes);
+  fclose(archivo);
+  if (leidos != 2) return -1;
+  return paginas_residentes * (sysconf(_SC_PAGESIZE) / 1024);
+#else
+  return -1;
+#endif
+}
@@ -0,0 +1,81 @@
+#ifndef MEMORIA_H
+#define MEMORIA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================================
+// MEMORIA - Asignador con contabilidad
+// Todos los módulos reservan con bio_malloc/bio_calloc/bio_realloc y
+// liberan con bio_free. Con -DBIOSIM_INSTRUMENTACION cada bloque lleva
+// una cabecera con su tamaño y se contabilizan bytes asignados, vivos,
+// pico de vivos y número de asignaciones (los ámbitos de instrumentacion
+// los reportan por etapa). Sin la bandera son malloc/calloc/realloc/free.
+// La memoria devuelta por una función de la biblioteca se libera con
+// bio_free (o con la función *_liberar correspondiente).
+// ============================================================
+
+typedef struct {
+  uint64_t bytes_asignados;   // Acumulado (realloc cuenta el tamaño nuevo)
+  uint64_t asignaciones;
+  uint64_t liberaciones;
+  int64_t bytes_vivos;
+  int64_t pico_bytes_vivos;   // Desde el inicio o el último memoria_pico_reiniciar
+} EstadisticasMemoria;
+
+#ifdef BIOSIM_INSTRUMENTACION
+void* bio_malloc(size_t bytes);
+void* bio_calloc(size_t cantidad, size_t tamano);
+void* bio_realloc(void *puntero, size_t bytes);
+void bio_free(void *puntero);
+#else
+#include <stdlib.h>
+#define bio_malloc malloc
+#define bio_calloc calloc
+#define bio_realloc realloc
+#define bio_free free
+#endif
+
+/**
+ * Copia de los contadores (ceros sin BIOSIM_INSTRUMENTACION)
+ * Complejidad: O(1)
+ */
+void memoria_estadisticas(EstadisticasMemoria *estadisticas);
+
+/**
+ * Lleva el pico de bytes vivos al valor actual y devuelve el anterior
+ * (para medir el pico de una etapa: reiniciar al abrir y restaurar con
+ * memoria_pico_restaurar al cerrar)
+ * Complejidad: O(1)
+ */
+int64_t memoria_pico_reiniciar(void);
+
+/**
+ * Devuelve el pico al máximo entre el valor guardado y el actual
+ * Complejidad: O(1)
+ */
+void memoria_pico_restaurar(int64_t pico_guardado);
+
+/**
+ * Fija el acumulador del hilo actual (NULL lo quita): además de los
+ * contadores globales, lo que asigne y libere este hilo se suma en él.
+ * Varios hilos pueden compartir un acumulador (sumas atómicas); su pico
+ * es el máximo de los bytes vivos netos que acumuló
+ * Complejidad: O(1)
+ * Retorna: El acumulador que tenía el hilo
+ */
+EstadisticasMemoria* memoria_hilo_acumular(EstadisticasMemoria *acumulador);
+
+/**
+ * Pico de memoria residente del proceso en KB (-1 si no disponible)
+ * Complejidad: O(1)
+ */
+long long memoria_pico_rss_kb(void);
+
+/**
+ * Memoria residente actual del proceso en KB (-1 si no disponible)
+ * Complejidad: O(1)
+ */
+long long memoria_rss_actual_kb(void);
+
+#endif // MEMORIA_H
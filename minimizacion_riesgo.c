@@ -1,4 +1,5 @@
 #include "minimizacion_riesgo.h"
+#include "memoria.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -37,20 +38,29 @@ static int comparar_riesgo_descendente(const void *a, const void *b) {
 //     * Cuanto más tiempo, más contactos posibles
 //   - Si RECUPERADO: riesgo = 0 (ya no propaga)
 // ============================================================
-float* calcular_riesgo_propagacion(Individuo *poblacion, int num_individuos) {
-  float *riesgo = (float *)malloc(num_individuos * sizeof(float));
+float* calcular_riesgo_propagacion(Poblacion *poblacion) {
+  if (!poblacion) {
+    return NULL;
+  }
+  
+  int num_individuos = poblacion->num_individuos;
+  float *riesgo = (float *)bio_malloc(num_individuos * sizeof(float));
   
-  if (!riesgo || !poblacion) {
+  if (!riesgo) {
     return riesgo;
   }
   
+  const EstadoSalud *estado = poblacion->estado;
+  const int *riesgo_personal = poblacion->riesgo;
+  const int *tiempo_infeccion = poblacion->tiempo_infeccion;
+  
   for (int i = 0; i < num_individuos; i++) {
     // Solo individuos infectados pueden propagar
-    if (poblacion[i].estado == INFECTADO) {
+    if (estado[i] == INFECTADO) {
       // Riesgo base multiplicado por factor de tiempo
       // Cuanto más días infectado, mayor riesgo de haber contagiado
-      float factor_tiempo = 1.0f + (poblacion[i].tiempo_infeccion / 100.0f);
-      riesgo[i] = poblacion[i].riesgo * factor_tiempo;
+      float factor_tiempo = 1.0f + (tiempo_infeccion[i] / 100.0f);
+      riesgo[i] = riesgo_personal[i] * factor_tiempo;
     } else {
       // Sanos o recuperados no propagan
       riesgo[i] = 0.0f;
@@ -72,8 +82,7 @@ float* calcular_riesgo_propagacion(Individuo *poblacion, int num_individuos) {
 //   5. Retornar IDs de individuos a aislar
 // ============================================================
 ResultadoAislamiento minimizar_riesgo_greedy(
-  Individuo *poblacion,
-  int num_individuos,
+  Poblacion *poblacion,
   float porcentaje_aislamiento
 ) {
   ResultadoAislamiento resultado;
@@ -81,27 +90,28 @@ ResultadoAislamiento minimizar_riesgo_greedy(
   resultado.individuos_a_aislar = NULL;
   resultado.riesgo_reducido = 0.0;
   
+  int num_individuos = poblacion ? poblacion->num_individuos : 0;
   if (!poblacion || num_individuos <= 0 || porcentaje_aislamiento < 0 || porcentaje_aislamiento > 100) {
     return resultado;
   }
   
   // Paso 1: Calcular riesgos - O(n)
-  float *riesgos = calcular_riesgo_propagacion(poblacion, num_individuos);
+  float *riesgos = calcular_riesgo_propagacion(poblacion);
   if (!riesgos) {
     return resultado;
   }
   
   // Paso 2: Crear array con (id, riesgo) - O(n)
   IndividuoConRiesgo *individuos_riesgo = 
-    (IndividuoConRiesgo *)malloc(num_individuos * sizeof(IndividuoConRiesgo));
+    (IndividuoConRiesgo *)bio_malloc(num_individuos * sizeof(IndividuoConRiesgo));
   
   if (!individuos_riesgo) {
-    free(riesgos);
+    bio_free(riesgos);
     return resultado;
   }
   
   for (int i = 0; i < num_individuos; i++) {
-    individuos_riesgo[i].individuo_id = poblacion[i].id;
+    individuos_riesgo[i].individuo_id = poblacion->id[i];
     individuos_riesgo[i].riesgo_valor = riesgos[i];
   }
   
@@ -118,12 +128,12 @@ ResultadoAislamiento minimizar_riesgo_greedy(
   // Paso 5: Asignar memoria y copiar IDs - O(k) donde k = cantidad
   if (resultado.cantidad > 0) {
     resultado.individuos_a_aislar = 
-      (int *)malloc(resultado.cantidad * sizeof(int));
+      (int *)bio_malloc(resultado.cantidad * sizeof(int));
     
     if (!resultado.individuos_a_aislar) {
       resultado.cantidad = 0;
-      free(riesgos);
-      free(individuos_riesgo);
+      bio_free(riesgos);
+      bio_free(individuos_riesgo);
       return resultado;
     }
     
@@ -145,15 +155,15 @@ ResultadoAislamiento minimizar_riesgo_greedy(
   }
   
   // Liberar memoria temporal
-  free(riesgos);
-  free(individuos_riesgo);
+  bio_free(riesgos);
+  bio_free(individuos_riesgo);
   
   return resultado;
 }
 
 void aislamiento_liberar(ResultadoAislamiento *resultado) {
   if (resultado && resultado->individuos_a_aislar) {
-    free(resultado->individuos_a_aislar);
+    bio_free(resultado->individuos_a_aislar);
     resultado->individuos_a_aislar = NULL;
     resultado->cantidad = 0;
   }
@@ -163,99 +173,101 @@ void aislamiento_liberar(ResultadoAislamiento *resultado) {
 // FUNCION DE PRUEBA: Test del algoritmo Greedy
 // ============================================================
 
-void test_minimizacion_riesgo(Individuo *poblacion, int num_individuos) {
-  if (!poblacion || num_individuos <= 0) {
-    printf("ERROR: Poblacion invalida para test\n");
+void test_minimizacion_riesgo(Poblacion *poblacion, FILE *salida) {
+  if (!poblacion || poblacion->num_individuos <= 0) {
+    fprintf(salida, "ERROR: Poblacion invalida para test\n");
     return;
   }
   
-  printf("\n========== SUBPROBLEMA 4: MINIMIZACION DE RIESGO ==========\n");
-  printf("Poblacion: %d individuos\n\n", num_individuos);
+  int num_individuos = poblacion->num_individuos;
+  
+  fprintf(salida, "\n========== SUBPROBLEMA 4: MINIMIZACION DE RIESGO ==========\n");
+  fprintf(salida, "Poblacion: %d individuos\n\n", num_individuos);
   
   // Calcular riesgos y estadísticas
-  float *riesgos = calcular_riesgo_propagacion(poblacion, num_individuos);
+  float *riesgos = calcular_riesgo_propagacion(poblacion);
   int num_infectados = 0;
   float riesgo_total_poblacion = 0.0f;
   
   for (int i = 0; i < num_individuos; i++) {
-    if (poblacion[i].estado == INFECTADO) {
+    if (poblacion->estado[i] == INFECTADO) {
       num_infectados++;
     }
     riesgo_total_poblacion += riesgos[i];
   }
   
-  printf("Infectados: %d\n", num_infectados);
-  printf("Riesgo total de poblacion: %.2f\n\n", riesgo_total_poblacion);
+  fprintf(salida, "Infectados: %d\n", num_infectados);
+  fprintf(salida, "Riesgo total de poblacion: %.2f\n\n", riesgo_total_poblacion);
   
   // Prueba 1: Aislar el 5% de la población
-  printf("--- PRUEBA 1: Aislar 5%% de la poblacion ---\n");
-  ResultadoAislamiento resultado_5 = minimizar_riesgo_greedy(poblacion, num_individuos, 5.0f);
+  fprintf(salida, "--- PRUEBA 1: Aislar 5%% de la poblacion ---\n");
+  ResultadoAislamiento resultado_5 = minimizar_riesgo_greedy(poblacion, 5.0f);
   
-  printf("Individuos a aislar: %d\n", resultado_5.cantidad);
-  printf("Riesgo reducido: %.2f\n", resultado_5.riesgo_reducido);
+  fprintf(salida, "Individuos a aislar: %d\n", resultado_5.cantidad);
+  fprintf(salida, "Riesgo reducido: %.2f\n", resultado_5.riesgo_reducido);
   
   if (resultado_5.cantidad > 0) {
-    printf("IDs a aislar (primeros 10): ");
+    fprintf(salida, "IDs a aislar (primeros 10): ");
     for (int i = 0; i < 10 && i < resultado_5.cantidad; i++) {
-      printf("%d ", resultado_5.individuos_a_aislar[i]);
+      fprintf(salida, "%d ", resultado_5.individuos_a_aislar[i]);
     }
-    if (resultado_5.cantidad > 10) printf("...");
-    printf("\n");
+    if (resultado_5.cantidad > 10) fprintf(salida, "...");
+    fprintf(salida, "\n");
   }
   
   // Prueba 2: Aislar el 10% de la población
-  printf("--- PRUEBA 2: Aislar 10%% de la poblacion ---\n");
-  ResultadoAislamiento resultado_10 = minimizar_riesgo_greedy(poblacion, num_individuos, 10.0f);
+  fprintf(salida, "--- PRUEBA 2: Aislar 10%% de la poblacion ---\n");
+  ResultadoAislamiento resultado_10 = minimizar_riesgo_greedy(poblacion, 10.0f);
   
-  printf("Individuos a aislar: %d\n", resultado_10.cantidad);
-  printf("Riesgo reducido: %.2f\n", resultado_10.riesgo_reducido);
+  fprintf(salida, "Individuos a aislar: %d\n", resultado_10.cantidad);
+  fprintf(salida, "Riesgo reducido: %.2f\n", resultado_10.riesgo_reducido);
   
   if (resultado_10.cantidad > 0) {
-    printf("IDs a aislar (primeros 10): ");
+    fprintf(salida, "IDs a aislar (primeros 10): ");
     for (int i = 0; i < 10 && i < resultado_10.cantidad; i++) {
-      printf("%d ", resultado_10.individuos_a_aislar[i]);
+      fprintf(salida, "%d ", resultado_10.individuos_a_aislar[i]);
     }
-    if (resultado_10.cantidad > 10) printf("...");
-    printf("\n");
+    if (resultado_10.cantidad > 10) fprintf(salida, "...");
+    fprintf(salida, "\n");
   }
   
   // Prueba 3: Aislar el 20% de la población
-  printf("--- PRUEBA 3: Aislar 20%% de la poblacion ---\n");
-  ResultadoAislamiento resultado_20 = minimizar_riesgo_greedy(poblacion, num_individuos, 20.0f);
+  fprintf(salida, "--- PRUEBA 3: Aislar 20%% de la poblacion ---\n");
+  ResultadoAislamiento resultado_20 = minimizar_riesgo_greedy(poblacion, 20.0f);
   
-  printf("Individuos a aislar: %d\n", resultado_20.cantidad);
-  printf("Riesgo reducido: %.2f\n", resultado_20.riesgo_reducido);
+  fprintf(salida, "Individuos a aislar: %d\n", resultado_20.cantidad);
+  fprintf(salida, "Riesgo reducido: %.2f\n", resultado_20.riesgo_reducido);
   
   if (resultado_20.cantidad > 0) {
-    printf("IDs a aislar (primeros 10): ");
+    fprintf(salida, "IDs a aislar (primeros 10): ");
     for (int i = 0; i < 10 && i < resultado_20.cantidad; i++) {
-      printf("%d ", resultado_20.individuos_a_aislar[i]);
+      fprintf(salida, "%d ", resultado_20.individuos_a_aislar[i]);
     }
-    if (resultado_20.cantidad > 10) printf("...");
-    printf("\n");
+    if (resultado_20.cantidad > 10) fprintf(salida, "...");
+    fprintf(salida, "\n");
   }
   
   // Estadísticas
-  printf("\n--- COMPARACION DE ESTRATEGIAS ---\n");
-  printf("Aislamiento | Cantidad | Riesgo Reducido | Porcentaje de Riesgo\n");
-  printf("%-11s | %8d | %15.2f | %18.2f%%\n", 
-         "5%", resultado_5.cantidad, resultado_5.riesgo_reducido, 
-         (riesgo_total_poblacion > 0) ? (resultado_5.riesgo_reducido / riesgo_total_poblacion * 100) : 0);
-  printf("%-11s | %8d | %15.2f | %18.2f%%\n", 
-         "10%", resultado_10.cantidad, resultado_10.riesgo_reducido,
-         (riesgo_total_poblacion > 0) ? (resultado_10.riesgo_reducido / riesgo_total_poblacion * 100) : 0);
-  printf("%-11s | %8d | %15.2f | %18.2f%%\n", 
-         "20%", resultado_20.cantidad, resultado_20.riesgo_reducido,
-         (riesgo_total_poblacion > 0) ? (resultado_20.riesgo_reducido / riesgo_total_poblacion * 100) : 0);
-  
-  printf("\nComplejidad: O(n log n) por ordenamiento\n");
-  printf("Estrategia: Greedy - Selecciona individuos con maximo riesgo\n");
-  
-  printf("\n===== FIN PRUEBAS SUBPROBLEMA 4 =====\n\n");
+  fprintf(salida, "\n--- COMPARACION DE ESTRATEGIAS ---\n");
+  fprintf(salida, "Aislamiento | Cantidad | Riesgo Reducido | Porcentaje de Riesgo\n");
+  fprintf(salida, "%-11s | %8d | %15.2f | %18.2f%%\n", 
+          "5%", resultado_5.cantidad, resultado_5.riesgo_reducido, 
+          (riesgo_total_poblacion > 0) ? (resultado_5.riesgo_reducido / riesgo_total_poblacion * 100) : 0);
+  fprintf(salida, "%-11s | %8d | %15.2f | %18.2f%%\n", 
+          "10%", resultado_10.cantidad, resultado_10.riesgo_reducido,
+          (riesgo_total_poblacion > 0) ? (resultado_10.riesgo_reducido / riesgo_total_poblacion * 100) : 0);
+  fprintf(salida, "%-11s | %8d | %15.2f | %18.2f%%\n", 
+          "20%", resultado_20.cantidad, resultado_20.riesgo_reducido,
+          (riesgo_total_poblacion > 0) ? (resultado_20.riesgo_reducido / riesgo_total_poblacion * 100) : 0);
+  
+  fprintf(salida, "\nComplejidad: O(n log n) por ordenamiento\n");
+  fprintf(salida, "Estrategia: Greedy - Selecciona individuos con maximo riesgo\n");
+  
+  fprintf(salida, "\n===== FIN PRUEBAS SUBPROBLEMA 4 =====\n\n");
   
   // Liberar resultados
   aislamiento_liberar(&resultado_5);
   aislamiento_liberar(&resultado_10);
   aislamiento_liberar(&resultado_20);
-  free(riesgos);
+  bio_free(riesgos);
 }
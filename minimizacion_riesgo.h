@@ -24,17 +24,17 @@ typedef struct {
  * Retorna: Array con IDs de individuos a aislar
  */
 ResultadoAislamiento minimizar_riesgo_greedy(
-  Individuo *poblacion,
-  int num_individuos,
+  Poblacion *poblacion,
   float porcentaje_aislamiento
 );
 
 /**
  * Calcula el riesgo de propagación de cada individuo
  * Basado en: estado, tiempo de infección, riesgo personal
+ * Recorre solo las columnas estado, riesgo y tiempo_infeccion
  * Complejidad: O(n)
  */
-float* calcular_riesgo_propagacion(Individuo *poblacion, int num_individuos);
+float* calcular_riesgo_propagacion(Poblacion *poblacion);
 
 /**
  * Libera los resultados del aislamiento
@@ -45,7 +45,8 @@ void aislamiento_liberar(ResultadoAislamiento *resultado);
 /**
  * Función de prueba para el algoritmo Greedy de minimización de riesgo
  * Prueba con diferentes porcentajes de aislamiento
+ * El reporte se escribe en salida (stdout o el buffer de la etapa)
  */
-void test_minimizacion_riesgo(Individuo *poblacion, int num_individuos);
+void test_minimizacion_riesgo(Poblacion *poblacion, FILE *salida);
 
 #endif // MINIMIZACION_RIESGO_H
@@ -0,0 +1,251 @@
+#include "mundo.h"
+#include "poblacion.h"
+#include "grafo_csr.h"
+#include "paralelo.h"
+#include "rng.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================
+// IMPLEMENTACION MUNDO
+// ============================================================
+
+// Cepas y nodos por bloque de trabajo
+#define BLOQUE_CEPAS 4096
+#define BLOQUE_NODOS 4096
+
+// Hasta este grado los destinos se sortean con rechazo; por encima,
+// muestreo secuencial (un pase sobre los candidatos)
+#define GRADO_MAX_RECHAZO 64
+
+static int num_bloques(int elementos, int tamano_bloque) {
+  return (elementos + tamano_bloque - 1) / tamano_bloque;
+}
+
+// --- Funciones Auxiliares ---
+
+static float random_float(RngFlujo *rng, float min, float max) {
+  return rng_rango_float(rng, min, max);
+}
+
+static void generar_cadena_adn(RngFlujo *rng, char *buffer, int length) {
+  const char bases[] = "ACGT";
+  for (int i = 0; i < length - 1; i++) {
+    buffer[i] = bases[rng_entero(rng, 4)];
+  }
+  buffer[length - 1] = '\0';
+}
+
+// ===== CONFIGURACION =====
+
+ConfiguracionMundo mundo_configuracion_defecto(uint64_t semilla) {
+  ConfiguracionMundo config;
+  config.num_individuos = MUNDO_INDIVIDUOS_DEFECTO;
+  config.num_territorios = MUNDO_TERRITORIOS_DEFECTO;
+  config.num_cepas = MUNDO_CEPAS_DEFECTO;
+  config.num_conexiones = MUNDO_CONEXIONES_DEFECTO;
+  config.num_pacientes_cero = MUNDO_PACIENTES_CERO_DEFECTO;
+  config.num_hilos = 0;
+  config.semilla = semilla;
+  return config;
+}
+
+bool mundo_configuracion_validar(ConfiguracionMundo *config) {
+  if (config->num_individuos < 1 || config->num_territorios < 1 || config->num_cepas < 1) {
+    return false;
+  }
+
+  // Un grafo dirigido sin lazos admite T * (T - 1) aristas
+  long long max_conexiones = (long long)config->num_territorios * (config->num_territorios - 1);
+  if (config->num_conexiones < 0) config->num_conexiones = 0;
+  if (config->num_conexiones > max_conexiones) config->num_conexiones = (int)max_conexiones;
+
+  if (config->num_pacientes_cero < 0) config->num_pacientes_cero = 0;
+  if (config->num_pacientes_cero > config->num_individuos) {
+    config->num_pacientes_cero = config->num_individuos;
+  }
+
+  if (config->num_hilos <= 0) config->num_hilos = paralelo_hilos_disponibles();
+  return true;
+}
+
+// ===== CEPAS =====
+
+typedef struct {
+  const ConfiguracionMundo *config;
+  Cepa *cepas;
+} GeneracionCepas;
+
+static void generar_bloque_cepas(void *contexto, int bloque) {
+  GeneracionCepas *g = (GeneracionCepas *)contexto;
+  int desde = bloque * BLOQUE_CEPAS;
+  int hasta = desde + BLOQUE_CEPAS;
+  if (hasta > g->config->num_cepas) hasta = g->config->num_cepas;
+
+  for (int i = desde; i < hasta; i++) {
+    RngFlujo rng = rng_flujo_crear(g->config->semilla, RNG_FLUJO(RNG_FLUJO_CEPAS, i));
+    Cepa *cepa = &g->cepas[i];
+    cepa->id = i;
+    generar_cadena_adn(&rng, cepa->nombre_adn, 20); // ADN de longitud 20
+    cepa->beta = random_float(&rng, 0.1, 0.9);
+    cepa->letalidad = random_float(&rng, 0.01, 0.3);
+    cepa->gamma = random_float(&rng, 0.05, 0.5);
+  }
+}
+
+void mundo_generar_cepas(const ConfiguracionMundo *config, Cepa *cepas) {
+  GeneracionCepas g = { config, cepas };
+  paralelo_para(num_bloques(config->num_cepas, BLOQUE_CEPAS), generar_bloque_cepas,
+                &g, config->num_hilos);
+}
+
+// ===== TERRITORIOS =====
+
+void mundo_generar_territorios(const ConfiguracionMundo *config, Territorio *territorios) {
+  for (int i = 0; i < config->num_territorios; i++) {
+    territorios[i].id = i;
+    snprintf(territorios[i].nombre, MAX_NOMBRE, "Territorio_%d", i);
+    territorios[i].num_individuos = 0;
+  }
+}
+
+// ===== GRAFO DE TERRITORIOS =====
+// El grado de salida de cada nodo es conocido de antemano
+// (E / T, uno más para los primeros E % T nodos), así que inicio[] se
+// calcula sin pasada previa y cada bloque escribe su fila en su lugar.
+
+typedef struct {
+  const ConfiguracionMundo *config;
+  GrafoCSR *grafo;
+} GeneracionGrafo;
+
+static bool destino_repetido(const int *fila, int usados, int destino) {
+  for (int k = 0; k < usados; k++) {
+    if (fila[k] == destino) return true;
+  }
+  return false;
+}
+
+static void generar_fila(GrafoCSR *grafo, RngFlujo *rng, int u) {
+  int n = grafo->num_nodos;
+  int *fila = grafo->destino_id + grafo->inicio[u];
+  float *pesos = grafo->peso + grafo->inicio[u];
+  int grado = grafo->inicio[u + 1] - grafo->inicio[u];
+
+  if (grado <= GRADO_MAX_RECHAZO) {
+    // Pocos destinos: sortear y descartar repetidos dentro de la fila
+    int usados = 0;
+    while (usados < grado) {
+      int destino = rng_entero(rng, n);
+      if (destino != u && !destino_repetido(fila, usados, destino)) {
+        fila[usados++] = destino;
+      }
+    }
+  } else {
+    // Muchos destinos: muestreo secuencial sobre los n - 1 candidatos
+    int pendientes = grado;
+    int restantes = n - 1;
+    int usados = 0;
+    for (int v = 0; v < n && pendientes > 0; v++) {
+      if (v == u) continue;
+      if (rng_entero(rng, restantes) < pendientes) {
+        fila[usados++] = v;
+        pendientes--;
+      }
+      restantes--;
+    }
+  }
+
+  for (int k = 0; k < grado; k++) {
+    pesos[k] = random_float(rng, 1.0, 10.0); // Distancia o costo
+  }
+}
+
+static void generar_bloque_grafo(void *contexto, int bloque) {
+  GeneracionGrafo *g = (GeneracionGrafo *)contexto;
+  int desde = bloque * BLOQUE_NODOS;
+  int hasta = desde + BLOQUE_NODOS;
+  if (hasta > g->grafo->num_nodos) hasta = g->grafo->num_nodos;
+
+  for (int u = desde; u < hasta; u++) {
+    RngFlujo rng = rng_flujo_crear(g->config->semilla, RNG_FLUJO(RNG_FLUJO_GRAFO, u));
+    generar_fila(g->grafo, &rng, u);
+  }
+}
+
+GrafoCSR* mundo_generar_grafo(const ConfiguracionMundo *config) {
+  int n = config->num_territorios;
+  int m = config->num_conexiones;
+  GrafoCSR *grafo = grafo_csr_crear(n, m);
+  if (!grafo) return NULL;
+
+  int base = m / n;
+  int extra = m % n;
+  for (int u = 0; u < n; u++) {
+    grafo->inicio[u + 1] = grafo->inicio[u] + base + (u < extra ? 1 : 0);
+  }
+
+  GeneracionGrafo g = { config, grafo };
+  paralelo_para(num_bloques(n, BLOQUE_NODOS), generar_bloque_grafo, &g, config->num_hilos);
+  return grafo;
+}
+
+// ===== POBLACION =====
+
+typedef struct {
+  const ConfiguracionMundo *config;
+  Poblacion *poblacion;
+} GeneracionPoblacion;
+
+static void generar_bloque_poblacion(void *contexto, int bloque) {
+  GeneracionPoblacion *g = (GeneracionPoblacion *)contexto;
+  Poblacion *poblacion = g->poblacion;
+  int num_territorios = g->config->num_territorios;
+  int desde = bloque * MUNDO_BLOQUE_POBLACION;
+  int hasta = desde + MUNDO_BLOQUE_POBLACION;
+  if (hasta > poblacion->num_individuos) hasta = poblacion->num_individuos;
+
+  // Un flujo por bloque: el bloque b produce siempre las mismas filas
+  RngFlujo rng = rng_flujo_crear(g->config->semilla, RNG_FLUJO(RNG_FLUJO_POBLACION, bloque));
+
+  int *id = poblacion->id;
+  int *territorio_id = poblacion->territorio_id;
+  int *riesgo = poblacion->riesgo;
+  EstadoSalud *estado = poblacion->estado;
+  int *tiempo_infeccion = poblacion->tiempo_infeccion;
+
+  for (int i = desde; i < hasta; i++) {
+    id[i] = i;
+    territorio_id[i] = rng_entero(&rng, num_territorios);
+    riesgo[i] = rng_entero(&rng, 50);  // Riesgo bajo: 0-49 (SANO)
+    estado[i] = SANO;
+    tiempo_infeccion[i] = 0;
+  }
+}
+
+Poblacion* mundo_generar_poblacion(const ConfiguracionMundo *config) {
+  Poblacion *poblacion = poblacion_crear_sintetica(config->num_individuos);
+  if (!poblacion) return NULL;
+
+  GeneracionPoblacion g = { config, poblacion };
+  paralelo_para(num_bloques(config->num_individuos, MUNDO_BLOQUE_POBLACION),
+                generar_bloque_poblacion, &g, config->num_hilos);
+  return poblacion;
+}
+
+void mundo_infectar_pacientes_cero(const ConfiguracionMundo *config, Poblacion *poblacion) {
+  RngFlujo rng = rng_flujo_crear(config->semilla, RNG_FLUJO(RNG_FLUJO_PACIENTES_CERO, 0));
+  int infectados = 0;
+
+  // Rechazo de repetidos: la población recién generada está sana
+  while (infectados < config->num_pacientes_cero) {
+    int idx = rng_entero(&rng, poblacion->num_individuos);
+    if (poblacion->estado[idx] == INFECTADO) continue;
+
+    poblacion->estado[idx] = INFECTADO;
+    poblacion->tiempo_infeccion[idx] = 1;
+    poblacion->riesgo[idx] = 50 + rng_entero(&rng, 50);  // Riesgo alto: 50-99 (INFECTADO)
+    infectados++;
+  }
+}
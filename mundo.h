@@ -0,0 +1,82 @@
+#ifndef MUNDO_H
+#define MUNDO_H
+
+#include "estructuras.h"
+#include <stdint.h>
+
+// ============================================================
+// MUNDO - Generación paralela y determinista del escenario
+// Cepas, territorios, grafo de territorios y población con tamaños
+// definidos en tiempo de ejecución. Cada bloque de trabajo usa su propio
+// flujo RNG (semilla, categoría, bloque): el resultado es idéntico con
+// cualquier número de hilos.
+// ============================================================
+
+// Valores por defecto (escenario de ejemplo original)
+#define MUNDO_CEPAS_DEFECTO 50
+#define MUNDO_TERRITORIOS_DEFECTO 20
+#define MUNDO_CONEXIONES_DEFECTO 30
+#define MUNDO_INDIVIDUOS_DEFECTO 1000
+#define MUNDO_PACIENTES_CERO_DEFECTO 10
+
+// Individuos por bloque de generación (unidad de reparto entre hilos)
+#define MUNDO_BLOQUE_POBLACION 65536
+
+typedef struct {
+  int num_individuos;
+  int num_territorios;
+  int num_cepas;
+  int num_conexiones;     // Aristas dirigidas del grafo de territorios
+  int num_pacientes_cero;
+  int num_hilos;          // <= 0: todos los procesadores
+  uint64_t semilla;
+} ConfiguracionMundo;
+
+/**
+ * Configuración con los valores por defecto y la semilla indicada
+ * Complejidad: O(1)
+ */
+ConfiguracionMundo mundo_configuracion_defecto(uint64_t semilla);
+
+/**
+ * Ajusta valores fuera de rango (conexiones y pacientes cero posibles)
+ * Complejidad: O(1)
+ * Retorna: true si la configuración es utilizable
+ */
+bool mundo_configuracion_validar(ConfiguracionMundo *config);
+
+/**
+ * Genera config->num_cepas cepas en el array dado
+ * Complejidad: O(C) repartido entre hilos
+ */
+void mundo_generar_cepas(const ConfiguracionMundo *config, Cepa *cepas);
+
+/**
+ * Inicializa config->num_territorios territorios (sin miembros)
+ * Complejidad: O(T)
+ */
+void mundo_generar_territorios(const ConfiguracionMundo *config, Territorio *territorios);
+
+/**
+ * Genera el grafo dirigido de territorios directamente en CSR
+ * Las conexiones se reparten de forma pareja entre los nodos de origen;
+ * cada nodo sortea destinos distintos con su propio flujo
+ * Complejidad: O(T + E) repartido entre hilos
+ */
+GrafoCSR* mundo_generar_grafo(const ConfiguracionMundo *config);
+
+/**
+ * Genera la población sana en bloques de MUNDO_BLOQUE_POBLACION filas
+ * Los nombres son sintéticos (derivados del id, sin columna)
+ * Complejidad: O(n) repartido entre hilos
+ * Retorna: Poblacion o NULL si no hay memoria
+ */
+Poblacion* mundo_generar_poblacion(const ConfiguracionMundo *config);
+
+/**
+ * Infecta config->num_pacientes_cero individuos distintos con riesgo alto
+ * Complejidad: O(k) esperado
+ */
+void mundo_infectar_pacientes_cero(const ConfiguracionMundo *config, Poblacion *poblacion);
+
+#endif // MUNDO_H
@@ -0,0 +1,53 @@
+#define _POSIX_C_SOURCE 200809L
+#include "paralelo.h"
+#include "pool_tareas.h"
+#include "traza.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+// ============================================================
+// IMPLEMENTACION PARALELO
+// Cada bloque es una tarea del pool global; el robo de trabajo reparte
+// los bloques entre los trabajadores
+// ============================================================
+
+typedef struct {
+  FuncionBloque funcion;
+  void *contexto;
+} TrabajoParalelo;
+
+static void ejecutar_bloques(void *contexto, int desde, int hasta) {
+  TrabajoParalelo *trabajo = (TrabajoParalelo *)contexto;
+  for (int bloque = desde; bloque < hasta; bloque++) {
+    uint64_t traza = traza_inicio();
+    trabajo->funcion(trabajo->contexto, bloque);
+    traza_fin("bloque", "paralelo", traza, bloque);
+  }
+}
+
+int paralelo_hilos_disponibles(void) {
+#ifdef _WIN32
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return info.dwNumberOfProcessors > 0 ? (int)info.dwNumberOfProcessors : 1;
+#else
+  long n = sysconf(_SC_NPROCESSORS_ONLN);
+  return n > 0 ? (int)n : 1;
+#endif
+}
+
+void paralelo_para(int num_bloques, FuncionBloque funcion, void *contexto, int num_hilos) {
+  if (num_bloques <= 0 || !funcion) return;
+
+  TrabajoParalelo trabajo = { funcion, contexto };
+  // Caso secuencial: sin pasar por el pool
+  if (num_hilos == 1 || num_bloques == 1) {
+    ejecutar_bloques(&trabajo, 0, num_bloques);
+    return;
+  }
+  pool_tareas_para(pool_tareas_global(), 0, num_bloques, 1, ejecutar_bloques, &trabajo);
+}
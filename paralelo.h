@@ -0,0 +1,31 @@
+#ifndef PARALELO_H
+#define PARALELO_H
+
+// ============================================================
+// PARALELO - Reparto de bloques de trabajo entre hilos (pool global)
+// Cada bloque se identifica por su índice: si el resultado de un bloque
+// depende solo de ese índice (p.ej. su flujo RNG), la salida es idéntica
+// sin importar el número de hilos ni el orden de ejecución.
+// ============================================================
+
+/**
+ * Función que procesa el bloque número 'bloque'
+ */
+typedef void (*FuncionBloque)(void *contexto, int bloque);
+
+/**
+ * Ejecuta funcion(contexto, b) para b = 0 .. num_bloques-1
+ * num_hilos == 1 corre en el hilo llamador; cualquier otro valor usa el
+ * pool global (pool_tareas.h), cuyo tamaño es el mismo para todos los
+ * módulos y evita sobresuscribir los procesadores
+ * Complejidad: O(num_bloques / hilos) por hilo
+ */
+void paralelo_para(int num_bloques, FuncionBloque funcion, void *contexto, int num_hilos);
+
+/**
+ * Número de procesadores lógicos disponibles
+ * Complejidad: O(1)
+ */
+int paralelo_hilos_disponibles(void);
+
+#endif // PARALELO_H
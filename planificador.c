@@ -0,0 +1,185 @@
+#define _POSIX_C_SOURCE 200809L
+#include "planificador.h"
+#include "contadores_hw.h"
+#include "instrumentacion.h"
+#include "memoria.h"
+#include "pool_tareas.h"
+#include "traza.h"
+#include <pthread.h>
+#include <string.h>
+
+// ============================================================
+// IMPLEMENTACION PLANIFICADOR
+// Cada etapa es una tarea del pool global. Al terminar, una etapa lanza
+// (dentro de su propia tarea, así el grupo nunca queda vacío antes de
+// tiempo) las etapas cuyos predecesores ya terminaron. Con
+// PLAN_MAX_ETAPAS <= 32 los conjuntos de etapas son máscaras de 32 bits.
+// Cada etapa concurrente acumula su instrumentación y sus contadores de
+// hardware en su propia MedicionInstr (también las tareas que lance); el
+// hilo llamador las agrega en orden de declaración tras esperar
+// ============================================================
+
+struct EjecucionPlan;
+
+typedef struct {
+  struct EjecucionPlan *ejecucion;
+  int etapa;
+} TareaEtapa;
+
+typedef struct EjecucionPlan {
+  Planificador *plan;
+  PoolTareas *pool;
+  GrupoTareas grupo;
+  FILE **buffers;
+  TareaEtapa tareas[PLAN_MAX_ETAPAS];
+  MedicionInstr mediciones[PLAN_MAX_ETAPAS];
+  uint32_t lanzadas;
+  uint32_t terminadas;
+  pthread_mutex_t cerrojo;
+} EjecucionPlan;
+
+void planificador_iniciar(Planificador *plan) {
+  plan->num_etapas = 0;
+}
+
+bool planificador_agregar(Planificador *plan, const char *nombre, FuncionEtapa funcion,
+                          void *contexto, unsigned lee, unsigned escribe, long long elementos) {
+  if (plan->num_etapas >= PLAN_MAX_ETAPAS || !funcion) return false;
+
+  EtapaPlan *etapa = &plan->etapas[plan->num_etapas];
+  etapa->nombre = nombre;
+  etapa->funcion = funcion;
+  etapa->contexto = contexto;
+  etapa->lee = lee;
+  etapa->escribe = escribe;
+  etapa->elementos = elementos;
+  etapa->predecesores = 0;
+  etapa->ms = 0.0;
+
+  for (int i = 0; i < plan->num_etapas; i++) {
+    const EtapaPlan *anterior = &plan->etapas[i];
+    if ((anterior->escribe & (lee | escribe)) || (anterior->lee & escribe)) {
+      etapa->predecesores |= (uint32_t)1 << i;
+    }
+  }
+  plan->num_etapas++;
+  return true;
+}
+
+// Retorna: duración en ns (también queda en etapa->ms)
+static uint64_t correr_etapa(EtapaPlan *etapa, FILE *salida) {
+  uint64_t traza = traza_inicio();
+  uint64_t inicio = instr_reloj_ns();
+  etapa->funcion(etapa->contexto, salida);
+  uint64_t duracion = instr_reloj_ns() - inicio;
+  traza_fin(etapa->nombre, "etapa", traza, etapa->elementos);
+  etapa->ms = (double)duracion / 1e6;
+  return duracion;
+}
+
+static void ejecutar_secuencial(Planificador *plan, FILE *salida) {
+  for (int i = 0; i < plan->num_etapas; i++) {
+    EtapaPlan *etapa = &plan->etapas[i];
+    INSTR_AMBITO_INICIO(ambito, etapa->nombre);
+    contadores_hw_etapa_inicio(etapa->nombre);
+    correr_etapa(etapa, salida);
+    contadores_hw_etapa_fin(etapa->elementos);
+    INSTR_AMBITO_FIN(ambito);
+  }
+}
+
+static void tarea_etapa(void *contexto);
+
+// Lanza las etapas no lanzadas cuyos predecesores terminaron (con el
+// cerrojo tomado)
+static void lanzar_listas(EjecucionPlan *ejecucion) {
+  const Planificador *plan = ejecucion->plan;
+  for (int i = 0; i < plan->num_etapas; i++) {
+    uint32_t bit = (uint32_t)1 << i;
+    if (!(ejecucion->lanzadas & bit) &&
+        (plan->etapas[i].predecesores & ~ejecucion->terminadas) == 0) {
+      ejecucion->lanzadas |= bit;
+      pool_tareas_lanzar(ejecucion->pool, &ejecucion->grupo, tarea_etapa, &ejecucion->tareas[i]);
+    }
+  }
+}
+
+static void tarea_etapa(void *contexto) {
+  TareaEtapa *tarea = (TareaEtapa *)contexto;
+  EjecucionPlan *ejecucion = tarea->ejecucion;
+  MedicionInstr *medicion = &ejecucion->mediciones[tarea->etapa];
+
+  MedicionInstr *anterior = instr_medicion_cambiar(medicion);
+  medicion->total_ns = correr_etapa(&ejecucion->plan->etapas[tarea->etapa],
+                                    ejecucion->buffers[tarea->etapa]);
+  medicion->pico_rss_kb = memoria_pico_rss_kb();
+  instr_medicion_cambiar(anterior);
+
+  pthread_mutex_lock(&ejecucion->cerrojo);
+  ejecucion->terminadas |= (uint32_t)1 << tarea->etapa;
+  lanzar_listas(ejecucion);
+  pthread_mutex_unlock(&ejecucion->cerrojo);
+}
+
+static void copiar_buffer(FILE *buffer, FILE *salida) {
+  char bloque[4096];
+  size_t leidos;
+  rewind(buffer);
+  while ((leidos = fread(bloque, 1, sizeof(bloque), buffer)) > 0) {
+    fwrite(bloque, 1, leidos, salida);
+  }
+}
+
+void planificador_ejecutar(Planificador *plan, int num_hilos, FILE *salida) {
+  if (plan->num_etapas == 0) return;
+  PoolTareas *pool = num_hilos == 1 ? NULL : pool_tareas_global();
+  if (!pool || pool_tareas_hilos(pool) == 1) {
+    ejecutar_secuencial(plan, salida);
+    return;
+  }
+
+  // Un buffer por etapa; sin archivos temporales se corre en secuencia
+  FILE *buffers[PLAN_MAX_ETAPAS];
+  for (int i = 0; i < plan->num_etapas; i++) {
+    buffers[i] = tmpfile();
+    if (!buffers[i]) {
+      for (int j = 0; j < i; j++) fclose(buffers[j]);
+      ejecutar_secuencial(plan, salida);
+      return;
+    }
+  }
+
+  EjecucionPlan ejecucion;
+  ejecucion.plan = plan;
+  ejecucion.pool = pool;
+  ejecucion.buffers = buffers;
+  ejecucion.lanzadas = 0;
+  ejecucion.terminadas = 0;
+  for (int i = 0; i < plan->num_etapas; i++) {
+    ejecucion.tareas[i].ejecucion = &ejecucion;
+    ejecucion.tareas[i].etapa = i;
+  }
+  memset(ejecucion.mediciones, 0, sizeof(ejecucion.mediciones));
+  grupo_tareas_iniciar(&ejecucion.grupo);
+  pthread_mutex_init(&ejecucion.cerrojo, NULL);
+
+  // El hilo llamador solo espera; después agrega lo medido por cada etapa
+  pthread_mutex_lock(&ejecucion.cerrojo);
+  lanzar_listas(&ejecucion);
+  pthread_mutex_unlock(&ejecucion.cerrojo);
+  pool_tareas_esperar(pool, &ejecucion.grupo);
+
+  for (int i = 0; i < plan->num_etapas; i++) {
+    const EtapaPlan *etapa = &plan->etapas[i];
+    const MedicionInstr *medicion = &ejecucion.mediciones[i];
+    INSTR_AMBITO_AGREGAR(etapa->nombre, medicion);
+    contadores_hw_etapa_agregar(etapa->nombre, etapa->elementos, etapa->ms,
+                                medicion->contadores_hw);
+  }
+
+  for (int i = 0; i < plan->num_etapas; i++) {
+    copiar_buffer(buffers[i], salida);
+    fclose(buffers[i]);
+  }
+  pthread_mutex_destroy(&ejecucion.cerrojo);
+}
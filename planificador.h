@@ -0,0 +1,74 @@
+#ifndef PLANIFICADOR_H
+#define PLANIFICADOR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// ============================================================
+// PLANIFICADOR - Etapas del pipeline como grafo de dependencias
+// Cada etapa declara qué recursos lee y cuáles escribe (máscaras de bits
+// definidas por el llamador). Una etapa depende de las anteriores con
+// las que choca: escritura/lectura, lectura/escritura o
+// escritura/escritura sobre algún recurso. Las etapas sin dependencias
+// pendientes corren en paralelo y comparten los datos por puntero (el
+// orden de las dependencias garantiza que no haya carreras).
+//
+// Cada etapa escribe su reporte en un buffer propio que se copia a la
+// salida en el orden de declaración, así que la salida es la misma con
+// cualquier número de hilos.
+// ============================================================
+
+// Máximo de etapas en un plan
+#define PLAN_MAX_ETAPAS 32
+
+/**
+ * Trabajo de una etapa; el reporte va a salida
+ */
+typedef void (*FuncionEtapa)(void *contexto, FILE *salida);
+
+typedef struct {
+  const char *nombre;       // Cadena estática (ámbitos, traza)
+  FuncionEtapa funcion;
+  void *contexto;
+  unsigned lee;             // Recursos que solo lee
+  unsigned escribe;         // Recursos que modifica
+  long long elementos;      // Tamaño de la entrada (contadores de hardware)
+  uint32_t predecesores;    // Bit i: depende de la etapa i
+  double ms;                // Duración en la última ejecución
+} EtapaPlan;
+
+typedef struct {
+  EtapaPlan etapas[PLAN_MAX_ETAPAS];
+  int num_etapas;
+} Planificador;
+
+/**
+ * Deja el plan vacío
+ * Complejidad: O(1)
+ */
+void planificador_iniciar(Planificador *plan);
+
+/**
+ * Agrega una etapa al final del plan y calcula sus dependencias con las
+ * etapas ya agregadas
+ * Complejidad: O(etapas)
+ * Retorna: false si el plan está lleno
+ */
+bool planificador_agregar(Planificador *plan, const char *nombre, FuncionEtapa funcion,
+                          void *contexto, unsigned lee, unsigned escribe, long long elementos);
+
+/**
+ * Ejecuta todas las etapas respetando sus dependencias
+ * num_hilos == 1: en orden de declaración en el hilo llamador, con un
+ * ámbito de instrumentación y una etapa de contadores de hardware por
+ * etapa. Otro valor: las etapas son tareas del pool global (tantas a la
+ * vez como trabajadores tenga); cada una mide en su tarea lo que hacen
+ * sus hilos (ver MedicionInstr) y al terminar se agrega igual un ámbito
+ * y una etapa de contadores de hardware por etapa (tiempo = de su inicio
+ * a su fin). La traza muestra cada etapa en su hilo.
+ * Complejidad: O(etapas^2) de planificación + el trabajo de las etapas
+ */
+void planificador_ejecutar(Planificador *plan, int num_hilos, FILE *salida);
+
+#endif // PLANIFICADOR_H
@@ -0,0 +1,112 @@
+#include "poblacion.h"
+#include "memoria.h"
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================
+// IMPLEMENTACION POBLACION (Structure of Arrays)
+// ============================================================
+
+static Poblacion* poblacion_reservar(int num_individuos, bool con_nombres) {
+  if (num_individuos < 0) return NULL;
+
+  Poblacion *poblacion = (Poblacion *)bio_malloc(sizeof(Poblacion));
+  if (!poblacion) return NULL;
+
+  size_t n = (size_t)num_individuos;
+  poblacion->num_individuos = num_individuos;
+  poblacion->id = (int *)bio_malloc(n * sizeof(int));
+  poblacion->estado = (EstadoSalud *)bio_malloc(n * sizeof(EstadoSalud));
+  poblacion->riesgo = (int *)bio_malloc(n * sizeof(int));
+  poblacion->tiempo_infeccion = (int *)bio_malloc(n * sizeof(int));
+  poblacion->territorio_id = (int *)bio_malloc(n * sizeof(int));
+  poblacion->nombre = con_nombres ? (char (*)[MAX_NOMBRE])bio_malloc(n * MAX_NOMBRE) : NULL;
+
+  if (n > 0 && (!poblacion->id || !poblacion->estado || !poblacion->riesgo ||
+                !poblacion->tiempo_infeccion || !poblacion->territorio_id ||
+                (con_nombres && !poblacion->nombre))) {
+    poblacion_liberar(poblacion);
+    return NULL;
+  }
+
+  return poblacion;
+}
+
+Poblacion* poblacion_crear(int num_individuos) {
+  return poblacion_reservar(num_individuos, true);
+}
+
+Poblacion* poblacion_crear_sintetica(int num_individuos) {
+  return poblacion_reservar(num_individuos, false);
+}
+
+// Escribe "Individuo_%04d" sin pasar por sprintf
+static void nombre_sintetico(int id, char *buffer) {
+  static const char prefijo[] = "Individuo_";
+  char digitos[12];
+  int num_digitos = 0;
+  unsigned int valor = id < 0 ? 0u - (unsigned int)id : (unsigned int)id;
+
+  do {
+    digitos[num_digitos++] = (char)('0' + valor % 10);
+    valor /= 10;
+  } while (valor > 0);
+  while (num_digitos < 4) {
+    digitos[num_digitos++] = '0';
+  }
+
+  int pos = (int)sizeof(prefijo) - 1;
+  memcpy(buffer, prefijo, pos);
+  if (id < 0) buffer[pos++] = '-';
+  while (num_digitos > 0) {
+    buffer[pos++] = digitos[--num_digitos];
+  }
+  buffer[pos] = '\0';
+}
+
+Individuo poblacion_obtener(const Poblacion *poblacion, int i) {
+  Individuo individuo;
+  individuo.id = poblacion->id[i];
+  if (poblacion->nombre) {
+    memcpy(individuo.nombre, poblacion->nombre[i], MAX_NOMBRE);
+    individuo.nombre[MAX_NOMBRE - 1] = '\0';
+  } else {
+    nombre_sintetico(poblacion->id[i], individuo.nombre);
+  }
+  individuo.territorio_id = poblacion->territorio_id[i];
+  individuo.riesgo = poblacion->riesgo[i];
+  individuo.estado = poblacion->estado[i];
+  individuo.tiempo_infeccion = poblacion->tiempo_infeccion[i];
+  return individuo;
+}
+
+void poblacion_establecer(Poblacion *poblacion, int i, const Individuo *individuo) {
+  poblacion->id[i] = individuo->id;
+  // En poblaciones sintéticas el nombre se deriva del id
+  if (poblacion->nombre) {
+    memcpy(poblacion->nombre[i], individuo->nombre, MAX_NOMBRE);
+    poblacion->nombre[i][MAX_NOMBRE - 1] = '\0';
+  }
+  poblacion->territorio_id[i] = individuo->territorio_id;
+  poblacion->riesgo[i] = individuo->riesgo;
+  poblacion->estado[i] = individuo->estado;
+  poblacion->tiempo_infeccion[i] = individuo->tiempo_infeccion;
+}
+
+const char* poblacion_nombre(const Poblacion *poblacion, int i, char *buffer) {
+  if (poblacion->nombre) return poblacion->nombre[i];
+  nombre_sintetico(poblacion->id[i], buffer);
+  return buffer;
+}
+
+void poblacion_liberar(Poblacion *poblacion) {
+  if (!poblacion) return;
+
+  bio_free(poblacion->id);
+  bio_free(poblacion->estado);
+  bio_free(poblacion->riesgo);
+  bio_free(poblacion->tiempo_infeccion);
+  bio_free(poblacion->territorio_id);
+  bio_free(poblacion->nombre);
+  bio_free(poblacion);
+}
@@ -0,0 +1,55 @@
+#ifndef POBLACION_H
+#define POBLACION_H
+
+#include "estructuras.h"
+
+// ============================================================
+// POBLACION - Almacén columnar de individuos (Structure of Arrays)
+// Los bucles críticos recorren directamente las columnas
+// (poblacion->estado, poblacion->riesgo, ...); estas funciones cubren
+// la creación, la liberación y el acceso puntual por filas.
+// ============================================================
+
+/**
+ * Crea una población vacía con espacio para num_individuos filas
+ * Complejidad: O(1) (las columnas no se inicializan)
+ * Retorna: Poblacion o NULL si no hay memoria
+ */
+Poblacion* poblacion_crear(int num_individuos);
+
+/**
+ * Crea una población sin columna de nombres (nombre == NULL)
+ * Los nombres se derivan del id bajo demanda ("Individuo_0042"):
+ * evita MAX_NOMBRE bytes y un sprintf por individuo en poblaciones grandes
+ * Complejidad: O(1)
+ * Retorna: Poblacion o NULL si no hay memoria
+ */
+Poblacion* poblacion_crear_sintetica(int num_individuos);
+
+/**
+ * Lee la fila i como un registro Individuo
+ * Complejidad: O(1)
+ */
+Individuo poblacion_obtener(const Poblacion *poblacion, int i);
+
+/**
+ * Escribe un registro Individuo en la fila i
+ * Complejidad: O(1)
+ */
+void poblacion_establecer(Poblacion *poblacion, int i, const Individuo *individuo);
+
+/**
+ * Nombre del individuo en la fila i (columna fría)
+ * Si la población es sintética el nombre se escribe en buffer
+ * (MAX_NOMBRE bytes); si no, se retorna la columna directamente
+ * Complejidad: O(1)
+ */
+const char* poblacion_nombre(const Poblacion *poblacion, int i, char *buffer);
+
+/**
+ * Libera todas las columnas de la población
+ * Complejidad: O(1)
+ */
+void poblacion_liberar(Poblacion *poblacion);
+
+#endif // POBLACION_H
@@ -0,0 +1,369 @@
+#define _POSIX_C_SOURCE 200809L
+#include "pool_tareas.h"
+#include "instrumentacion.h"
+#include "memoria.h"
+#include "paralelo.h"
+#include <pthread.h>
+#include <sched.h>
+
+// ============================================================
+// IMPLEMENTACION POOL DE TAREAS
+// Deques circulares con un cerrojo cada uno (el dueño usa el fondo, los
+// ladrones el frente). Los trabajadores sin trabajo duermen en una
+// variable de condición; 'en_cola' cuenta las tareas encoladas en todas
+// las deques para saber cuándo despertarlos
+// ============================================================
+
+#define CAPACIDAD_DEQUE_INICIAL 64
+
+typedef struct {
+  FuncionTarea funcion;
+  void *contexto;
+  GrupoTareas *grupo;
+  MedicionInstr *medicion;   // La del hilo que la lanzó
+} Tarea;
+
+typedef struct {
+  pthread_mutex_t cerrojo;
+  Tarea *tareas;        // Anillo de 'capacidad' (potencia de 2)
+  int capacidad;
+  long frente;          // Tareas en [frente, fondo)
+  long fondo;
+} DequeTareas;
+
+typedef struct {
+  PoolTareas *pool;
+  int indice;
+} IdentidadTrabajador;
+
+struct PoolTareas {
+  int num_hilos;
+  pthread_t *hilos;
+  IdentidadTrabajador *identidades;
+  DequeTareas *deques;          // Una por trabajador
+  int num_deques;               // Deques iniciadas (>= num_hilos)
+  DequeTareas entrada;          // Tareas lanzadas desde fuera del pool
+  int en_cola;                  // Acceso atómico
+  pthread_mutex_t cerrojo;
+  pthread_cond_t hay_trabajo;
+  pthread_cond_t grupo_terminado;
+  int dormidos;
+  bool terminar;
+};
+
+static pthread_key_t clave_trabajador;
+static pthread_once_t clave_creada = PTHREAD_ONCE_INIT;
+
+static pthread_mutex_t cerrojo_global = PTHREAD_MUTEX_INITIALIZER;
+static PoolTareas *pool_global = NULL;
+static int hilos_pool_global = 0;
+
+static void crear_clave(void) {
+  pthread_key_create(&clave_trabajador, NULL);
+}
+
+// Índice del hilo actual en este pool (-1 si no es uno de sus trabajadores)
+static int indice_trabajador(const PoolTareas *pool) {
+  const IdentidadTrabajador *yo = (const IdentidadTrabajador *)pthread_getspecific(clave_trabajador);
+  return (yo && yo->pool == pool) ? yo->indice : -1;
+}
+
+// ===== DEQUES =====
+
+static bool deque_iniciar(DequeTareas *deque) {
+  deque->tareas = (Tarea *)bio_malloc(CAPACIDAD_DEQUE_INICIAL * sizeof(Tarea));
+  if (!deque->tareas) return false;
+  deque->capacidad = CAPACIDAD_DEQUE_INICIAL;
+  deque->frente = 0;
+  deque->fondo = 0;
+  pthread_mutex_init(&deque->cerrojo, NULL);
+  return true;
+}
+
+static void deque_liberar(DequeTareas *deque) {
+  pthread_mutex_destroy(&deque->cerrojo);
+  bio_free(deque->tareas);
+}
+
+static bool deque_empujar(DequeTareas *deque, Tarea tarea) {
+  pthread_mutex_lock(&deque->cerrojo);
+  long cantidad = deque->fondo - deque->frente;
+  if (cantidad == deque->capacidad) {
+    // Duplicar y reubicar el anillo a partir de 0
+    Tarea *nuevas = (Tarea *)bio_malloc(2 * (size_t)deque->capacidad * sizeof(Tarea));
+    if (!nuevas) {
+      pthread_mutex_unlock(&deque->cerrojo);
+      return false;
+    }
+    for (long i = 0; i < cantidad; i++) {
+      nuevas[i] = deque->tareas[(deque->frente + i) & (deque->capacidad - 1)];
+    }
+    bio_free(deque->tareas);
+    deque->tareas = nuevas;
+    deque->capacidad *= 2;
+    deque->frente = 0;
+    deque->fondo = cantidad;
+  }
+  deque->tareas[deque->fondo & (deque->capacidad - 1)] = tarea;
+  deque->fondo++;
+  pthread_mutex_unlock(&deque->cerrojo);
+  return true;
+}
+
+// Dueño: la tarea más reciente (mejor localidad)
+static bool deque_sacar_fondo(DequeTareas *deque, Tarea *tarea) {
+  bool hay = false;
+  pthread_mutex_lock(&deque->cerrojo);
+  if (deque->fondo > deque->frente) {
+    deque->fondo--;
+    *tarea = deque->tareas[deque->fondo & (deque->capacidad - 1)];
+    hay = true;
+  }
+  pthread_mutex_unlock(&deque->cerrojo);
+  return hay;
+}
+
+// Ladrón: la tarea más antigua (suele ser la más grande)
+static bool deque_robar_frente(DequeTareas *deque, Tarea *tarea) {
+  bool hay = false;
+  pthread_mutex_lock(&deque->cerrojo);
+  if (deque->fondo > deque->frente) {
+    *tarea = deque->tareas[deque->frente & (deque->capacidad - 1)];
+    deque->frente++;
+    hay = true;
+  }
+  pthread_mutex_unlock(&deque->cerrojo);
+  return hay;
+}
+
+// ===== TRABAJADORES =====
+
+// Deque propia, luego la de entrada, luego robo en las de los demás
+static bool obtener_tarea(PoolTareas *pool, int yo, Tarea *tarea) {
+  if (__atomic_load_n(&pool->en_cola, __ATOMIC_ACQUIRE) == 0) return false;
+
+  bool hay = deque_sacar_fondo(&pool->deques[yo], tarea) ||
+             deque_robar_frente(&pool->entrada, tarea);
+  // num_deques no cambia una vez creados los hilos (num_hilos sí, mientras
+  // se crean); las deques sin hilo están siempre vacías
+  for (int k = 1; !hay && k < pool->num_deques; k++) {
+    hay = deque_robar_frente(&pool->deques[(yo + k) % pool->num_deques], tarea);
+  }
+  if (hay) __atomic_sub_fetch(&pool->en_cola, 1, __ATOMIC_ACQ_REL);
+  return hay;
+}
+
+static void ejecutar_tarea(PoolTareas *pool, const Tarea *tarea) {
+  MedicionInstr *anterior = instr_medicion_cambiar(tarea->medicion);
+  tarea->funcion(tarea->contexto);
+  instr_medicion_cambiar(anterior);
+  if (__atomic_sub_fetch(&tarea->grupo->pendientes, 1, __ATOMIC_ACQ_REL) == 0) {
+    pthread_mutex_lock(&pool->cerrojo);
+    pthread_cond_broadcast(&pool->grupo_terminado);
+    pthread_mutex_unlock(&pool->cerrojo);
+  }
+}
+
+static void* trabajador(void *arg) {
+  IdentidadTrabajador *identidad = (IdentidadTrabajador *)arg;
+  PoolTareas *pool = identidad->pool;
+  pthread_setspecific(clave_trabajador, identidad);
+
+  for (;;) {
+    Tarea tarea;
+    if (obtener_tarea(pool, identidad->indice, &tarea)) {
+      ejecutar_tarea(pool, &tarea);
+      continue;
+    }
+
+    pthread_mutex_lock(&pool->cerrojo);
+    while (__atomic_load_n(&pool->en_cola, __ATOMIC_ACQUIRE) == 0 && !pool->terminar) {
+      pool->dormidos++;
+      pthread_cond_wait(&pool->hay_trabajo, &pool->cerrojo);
+      pool->dormidos--;
+    }
+    bool salir = pool->terminar && __atomic_load_n(&pool->en_cola, __ATOMIC_ACQUIRE) == 0;
+    pthread_mutex_unlock(&pool->cerrojo);
+    if (salir) break;
+  }
+  return NULL;
+}
+
+// ===== POOL =====
+
+PoolTareas* pool_tareas_crear(int num_hilos) {
+  pthread_once(&clave_creada, crear_clave);
+  if (num_hilos <= 0) num_hilos = paralelo_hilos_disponibles();
+
+  PoolTareas *pool = (PoolTareas *)bio_calloc(1, sizeof(PoolTareas));
+  if (!pool) return NULL;
+  pthread_mutex_init(&pool->cerrojo, NULL);
+  pthread_cond_init(&pool->hay_trabajo, NULL);
+  pthread_cond_init(&pool->grupo_terminado, NULL);
+
+  pool->hilos = (pthread_t *)bio_malloc(num_hilos * sizeof(pthread_t));
+  pool->identidades = (IdentidadTrabajador *)bio_malloc(num_hilos * sizeof(IdentidadTrabajador));
+  pool->deques = (DequeTareas *)bio_calloc(num_hilos, sizeof(DequeTareas));
+  if (!pool->hilos || !pool->identidades || !pool->deques || !deque_iniciar(&pool->entrada)) {
+    pool_tareas_liberar(pool);
+    return NULL;
+  }
+  while (pool->num_deques < num_hilos && deque_iniciar(&pool->deques[pool->num_deques])) {
+    pool->num_deques++;
+  }
+
+  // Con menos hilos de los pedidos el pool sigue siendo válido
+  for (int h = 0; h < pool->num_deques; h++) {
+    pool->identidades[pool->num_hilos].pool = pool;
+    pool->identidades[pool->num_hilos].indice = pool->num_hilos;
+    if (pthread_create(&pool->hilos[pool->num_hilos], NULL, trabajador,
+                       &pool->identidades[pool->num_hilos]) == 0) {
+      pool->num_hilos++;
+    }
+  }
+  if (pool->num_hilos == 0) {
+    pool_tareas_liberar(pool);
+    return NULL;
+  }
+  return pool;
+}
+
+void pool_tareas_liberar(PoolTareas *pool) {
+  if (!pool) return;
+
+  pthread_mutex_lock(&pool->cerrojo);
+  pool->terminar = true;
+  pthread_cond_broadcast(&pool->hay_trabajo);
+  pthread_mutex_unlock(&pool->cerrojo);
+  for (int h = 0; h < pool->num_hilos; h++) {
+    pthread_join(pool->hilos[h], NULL);
+  }
+
+  for (int d = 0; d < pool->num_deques; d++) {
+    deque_liberar(&pool->deques[d]);
+  }
+  if (pool->entrada.tareas) deque_liberar(&pool->entrada);
+  pthread_cond_destroy(&pool->grupo_terminado);
+  pthread_cond_destroy(&pool->hay_trabajo);
+  pthread_mutex_destroy(&pool->cerrojo);
+  bio_free(pool->deques);
+  bio_free(pool->identidades);
+  bio_free(pool->hilos);
+  bio_free(pool);
+}
+
+int pool_tareas_hilos(const PoolTareas *pool) {
+  return pool ? pool->num_hilos : 1;
+}
+
+bool pool_tareas_global_configurar(int num_hilos) {
+  pthread_mutex_lock(&cerrojo_global);
+  bool libre = pool_global == NULL;
+  if (libre) hilos_pool_global = num_hilos;
+  pthread_mutex_unlock(&cerrojo_global);
+  return libre;
+}
+
+PoolTareas* pool_tareas_global(void) {
+  pthread_mutex_lock(&cerrojo_global);
+  if (!pool_global) pool_global = pool_tareas_crear(hilos_pool_global);
+  PoolTareas *pool = pool_global;
+  pthread_mutex_unlock(&cerrojo_global);
+  return pool;
+}
+
+void pool_tareas_global_cerrar(void) {
+  pthread_mutex_lock(&cerrojo_global);
+  PoolTareas *pool = pool_global;
+  pool_global = NULL;
+  pthread_mutex_unlock(&cerrojo_global);
+  pool_tareas_liberar(pool);
+}
+
+// ===== TAREAS =====
+
+void grupo_tareas_iniciar(GrupoTareas *grupo) {
+  grupo->pendientes = 0;
+}
+
+void pool_tareas_lanzar(PoolTareas *pool, GrupoTareas *grupo, FuncionTarea funcion, void *contexto) {
+  Tarea tarea = { funcion, contexto, grupo, instr_medicion_actual() };
+  int yo = indice_trabajador(pool);
+  DequeTareas *deque = yo >= 0 ? &pool->deques[yo] : &pool->entrada;
+
+  __atomic_add_fetch(&grupo->pendientes, 1, __ATOMIC_ACQ_REL);
+  if (!deque_empujar(deque, tarea)) {
+    // Sin memoria para encolar: se ejecuta aquí mismo
+    ejecutar_tarea(pool, &tarea);
+    return;
+  }
+  __atomic_add_fetch(&pool->en_cola, 1, __ATOMIC_ACQ_REL);
+
+  pthread_mutex_lock(&pool->cerrojo);
+  if (pool->dormidos > 0) pthread_cond_signal(&pool->hay_trabajo);
+  pthread_mutex_unlock(&pool->cerrojo);
+}
+
+void pool_tareas_esperar(PoolTareas *pool, GrupoTareas *grupo) {
+  int yo = indice_trabajador(pool);
+  if (yo >= 0) {
+    // Un trabajador no se bloquea: ejecuta tareas hasta que el grupo termine
+    while (__atomic_load_n(&grupo->pendientes, __ATOMIC_ACQUIRE) > 0) {
+      Tarea tarea;
+      if (obtener_tarea(pool, yo, &tarea)) {
+        ejecutar_tarea(pool, &tarea);
+      } else {
+        sched_yield();
+      }
+    }
+    return;
+  }
+
+  pthread_mutex_lock(&pool->cerrojo);
+  while (__atomic_load_n(&grupo->pendientes, __ATOMIC_ACQUIRE) > 0) {
+    pthread_cond_wait(&pool->grupo_terminado, &pool->cerrojo);
+  }
+  pthread_mutex_unlock(&pool->cerrojo);
+}
+
+typedef struct {
+  FuncionRango funcion;
+  void *contexto;
+  int desde;
+  int hasta;
+} TrozoRango;
+
+static void ejecutar_trozo(void *contexto) {
+  TrozoRango *trozo = (TrozoRango *)contexto;
+  trozo->funcion(trozo->contexto, trozo->desde, trozo->hasta);
+}
+
+void pool_tareas_para(PoolTareas *pool, int inicio, int fin, int grano,
+                      FuncionRango funcion, void *contexto) {
+  if (fin <= inicio) return;
+  int n = fin - inicio;
+  if (grano <= 0) {
+    grano = n / (4 * pool_tareas_hilos(pool));
+    if (grano < 1) grano = 1;
+  }
+  int num_trozos = (n + grano - 1) / grano;
+
+  TrozoRango *trozos = NULL;
+  if (pool && num_trozos > 1) trozos = (TrozoRango *)bio_malloc(num_trozos * sizeof(TrozoRango));
+  if (!trozos) {
+    funcion(contexto, inicio, fin);
+    return;
+  }
+
+  GrupoTareas grupo;
+  grupo_tareas_iniciar(&grupo);
+  for (int t = 0; t < num_trozos; t++) {
+    trozos[t].funcion = funcion;
+    trozos[t].contexto = contexto;
+    trozos[t].desde = inicio + t * grano;
+    trozos[t].hasta = (t == num_trozos - 1) ? fin : trozos[t].desde + grano;
+    pool_tareas_lanzar(pool, &grupo, ejecutar_trozo, &trozos[t]);
+  }
+  pool_tareas_esperar(pool, &grupo);
+  bio_free(trozos);
+}
@@ -0,0 +1,109 @@
+#ifndef POOL_TAREAS_H
+#define POOL_TAREAS_H
+
+#include <stdbool.h>
+
+// ============================================================
+// POOL DE TAREAS - Hilos fijos con robo de trabajo
+// Un único pool global atiende a todos los módulos (paralelo_para, el
+// planificador de etapas, lotes de Dijkstra...), así que las etapas
+// concurrentes no crean más hilos que procesadores.
+// Cada trabajador tiene su deque: apila y desapila tareas por el fondo y,
+// si se queda sin trabajo, roba por el frente de los demás. Las tareas
+// lanzadas desde fuera del pool van a una cola de entrada compartida.
+//
+// Uso:
+//   GrupoTareas grupo;
+//   grupo_tareas_iniciar(&grupo);
+//   pool_tareas_lanzar(pool, &grupo, funcion, contexto);   // n veces
+//   pool_tareas_esperar(pool, &grupo);
+//
+// Un trabajador que espera un grupo ejecuta tareas mientras tanto, así
+// que las tareas pueden lanzar y esperar subtareas sin bloquear el pool.
+// Un hilo externo que espera solo se bloquea.
+// Cada tarea corre con la medición de instrumentación que tenía activa el
+// hilo que la lanzó (ver instr_medicion_cambiar), así lo que una etapa
+// reparte por el pool se le sigue atribuyendo.
+// ============================================================
+
+typedef struct PoolTareas PoolTareas;
+
+typedef void (*FuncionTarea)(void *contexto);
+
+/**
+ * Procesa los índices [desde, hasta) de un rango
+ */
+typedef void (*FuncionRango)(void *contexto, int desde, int hasta);
+
+// Conjunto de tareas que se espera en bloque
+typedef struct {
+  int pendientes;   // Acceso atómico
+} GrupoTareas;
+
+/**
+ * Crea un pool con num_hilos trabajadores (<= 0: todos los procesadores)
+ * Complejidad: O(num_hilos)
+ * Retorna: NULL si no se pudo crear ningún hilo
+ */
+PoolTareas* pool_tareas_crear(int num_hilos);
+
+/**
+ * Espera a que se vacíen las colas, detiene los hilos y libera el pool
+ * Complejidad: O(num_hilos)
+ */
+void pool_tareas_liberar(PoolTareas *pool);
+
+/**
+ * Número de trabajadores del pool
+ * Complejidad: O(1)
+ */
+int pool_tareas_hilos(const PoolTareas *pool);
+
+/**
+ * Fija los trabajadores del pool global antes de su primer uso
+ * Complejidad: O(1)
+ * Retorna: false si el pool global ya existe
+ */
+bool pool_tareas_global_configurar(int num_hilos);
+
+/**
+ * Pool compartido por todos los módulos (se crea en el primer uso)
+ * Complejidad: O(1) (O(hilos) la primera vez)
+ */
+PoolTareas* pool_tareas_global(void);
+
+/**
+ * Libera el pool global (sin tareas en curso); un uso posterior lo crea
+ * de nuevo
+ * Complejidad: O(hilos)
+ */
+void pool_tareas_global_cerrar(void);
+
+/**
+ * Deja el grupo sin tareas pendientes
+ * Complejidad: O(1)
+ */
+void grupo_tareas_iniciar(GrupoTareas *grupo);
+
+/**
+ * Encola funcion(contexto) como parte del grupo
+ * Complejidad: O(1) amortizado
+ */
+void pool_tareas_lanzar(PoolTareas *pool, GrupoTareas *grupo, FuncionTarea funcion, void *contexto);
+
+/**
+ * Vuelve cuando todas las tareas del grupo terminaron
+ * Complejidad: O(trabajo del grupo / hilos)
+ */
+void pool_tareas_esperar(PoolTareas *pool, GrupoTareas *grupo);
+
+/**
+ * Ejecuta funcion sobre [inicio, fin) en trozos de grano índices
+ * (grano <= 0: reparto automático en unos 4 trozos por trabajador) y
+ * espera a que terminen todos. Con pool NULL corre en el hilo llamador.
+ * Complejidad: O((fin - inicio) / hilos) por hilo
+ */
+void pool_tareas_para(PoolTareas *pool, int inicio, int fin, int grano,
+                      FuncionRango funcion, void *contexto);
+
+#endif // POOL_TAREAS_H
@@ -1,6 +1,14 @@
 #include "propagacion_temporal.h"
+#include "memoria.h"
 #include "heap.h"
+#include "indice_territorios.h"
+#include "instrumentacion.h"
+#include "rng.h"
+#include "traza.h"
 #include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
 #include <time.h>
 
 // ========================================================================
@@ -19,10 +27,25 @@ static int comparar_eventos(ElementoHeap a, ElementoHeap b) {
   return 0;
 }
 
-// Crear evento de infección
-static EventoInfeccion* crear_evento(int tiempo, int individuo_id, int tipo) {
+// Evento procesado en la lista de libres (reutiliza su propia memoria)
+typedef struct EventoLibre {
+  struct EventoLibre *siguiente;
+} EventoLibre;
+
+// Bloques de la arena de eventos: ~2700 eventos por bloque
+#define BLOQUE_EVENTOS (64 * 1024)
+
+// Crear evento de infección: primero de la lista de libres, si no de la arena
+static EventoInfeccion* crear_evento(EstadoSimulacion *sim, int tiempo, int individuo_id, int tipo) {
   // tipo: 0=infección, 1=recuperación
-  EventoInfeccion *evento = (EventoInfeccion *)malloc(sizeof(EventoInfeccion));
+  EventoInfeccion *evento;
+  if (sim->eventos_libres) {
+    EventoLibre *libre = (EventoLibre *)sim->eventos_libres;
+    sim->eventos_libres = libre->siguiente;
+    evento = (EventoInfeccion *)libre;
+  } else {
+    evento = (EventoInfeccion *)arena_reservar(sim->eventos, sizeof(EventoInfeccion));
+  }
   evento->tiempo = tiempo;
   evento->individuo_id = individuo_id;
   evento->individuo_origen = tipo; // Reutilizamos este campo para guardar tipo
@@ -32,15 +55,17 @@ static EventoInfeccion* crear_evento(int tiempo, int individuo_id, int tipo) {
   return evento;
 }
 
-// Simular propagación con Min-Heap
-ResultadoPropagacion* simular_propagacion_temporal(Territorio *territorios,
-                                                   int num_territorios,
-                                                   Individuo *poblacion,
-                                                   int num_poblacion,
-                                                   Cepa *cepas,
-                                                   int num_cepas,
-                                                   int dias_simulacion) {
-  ResultadoPropagacion *resultado = (ResultadoPropagacion *)malloc(sizeof(ResultadoPropagacion));
+// Devuelve un evento procesado a la lista de libres - O(1)
+static void liberar_evento(EstadoSimulacion *sim, EventoInfeccion *evento) {
+  EventoLibre *libre = (EventoLibre *)evento;
+  libre->siguiente = (EventoLibre *)sim->eventos_libres;
+  sim->eventos_libres = libre;
+}
+
+// ===== ESTADO DE SIMULACION =====
+
+static ResultadoPropagacion* crear_resultado(int dias_simulacion) {
+  ResultadoPropagacion *resultado = (ResultadoPropagacion *)bio_malloc(sizeof(ResultadoPropagacion));
   resultado->dias_simulados = dias_simulacion;
   resultado->num_eventos = 0;
   resultado->total_infectados = 0;
@@ -48,47 +73,81 @@ ResultadoPropagacion* simular_propagacion_temporal(Territorio *territorios,
   resultado->total_muertos = 0;
   
   // Arrays de estadísticas por día
-  resultado->infectados_por_dia = (int *)calloc(dias_simulacion + 1, sizeof(int));
-  resultado->recuperados_por_dia = (int *)calloc(dias_simulacion + 1, sizeof(int));
-  resultado->muertos_por_dia = (int *)calloc(dias_simulacion + 1, sizeof(int));
+  resultado->infectados_por_dia = (int *)bio_calloc(dias_simulacion + 1, sizeof(int));
+  resultado->recuperados_por_dia = (int *)bio_calloc(dias_simulacion + 1, sizeof(int));
+  resultado->muertos_por_dia = (int *)bio_calloc(dias_simulacion + 1, sizeof(int));
+  return resultado;
+}
+
+// Reserva el estado (sin inicializar arrays ni heap)
+static EstadoSimulacion* reservar_simulacion(const IndiceTerritorios *indice,
+                                             const Poblacion *poblacion,
+                                             int dias_simulacion) {
+  int num_poblacion = poblacion->num_individuos;
+  EstadoSimulacion *sim = (EstadoSimulacion *)bio_malloc(sizeof(EstadoSimulacion));
+  sim->indice = indice;
+  sim->poblacion = poblacion;
+  sim->num_poblacion = num_poblacion;
+  sim->dias_simulacion = dias_simulacion;
+  sim->dia_actual = 0;
+  sim->ultimo_dia = 0;
   
   // Estado de cada individuo
-  EstadoSalud *estado = (EstadoSalud *)malloc(sizeof(EstadoSalud) * num_poblacion);
-  int *dia_infeccion = (int *)malloc(sizeof(int) * num_poblacion);
-  bool *procesado = (bool *)malloc(sizeof(bool) * num_poblacion);
+  sim->estado = (EstadoSalud *)bio_malloc(sizeof(EstadoSalud) * num_poblacion);
+  sim->dia_infeccion = (int *)bio_malloc(sizeof(int) * num_poblacion);
+  sim->procesado = (bool *)bio_malloc(sizeof(bool) * num_poblacion);
+  sim->heap = NULL;
+  sim->eventos = arena_crear(BLOQUE_EVENTOS);
+  sim->eventos_libres = NULL;
+  sim->resultado = crear_resultado(dias_simulacion);
+  return sim;
+}
+
+EstadoSimulacion* simulacion_iniciar(const IndiceTerritorios *indice, const Poblacion *poblacion,
+                                     int dias_simulacion, uint64_t semilla) {
+  EstadoSimulacion *sim = reservar_simulacion(indice, poblacion, dias_simulacion);
+  int num_poblacion = sim->num_poblacion;
+  EstadoSalud *estado = sim->estado;
+  bool *procesado = sim->procesado;
+  ResultadoPropagacion *resultado = sim->resultado;
   
-  // Inicializar
+  // Inicializar (copia directa de la columna de estado)
+  memcpy(estado, poblacion->estado, sizeof(EstadoSalud) * num_poblacion);
   for (int i = 0; i < num_poblacion; i++) {
-    estado[i] = poblacion[i].estado;
-    dia_infeccion[i] = -1;
+    sim->dia_infeccion[i] = -1;
     procesado[i] = false;
   }
   
   // Crear Min-Heap para eventos
   Heap *heap = heap_crear(num_poblacion * 2, true);
+  sim->heap = heap;
+  
+  // Flujo aleatorio propio de la simulación (reproducible con la semilla del escenario)
+  sim->rng = rng_flujo_crear(semilla, RNG_FLUJO(RNG_FLUJO_PROPAGACION, 0));
+  RngFlujo *rng = &sim->rng;
   
   // Contar infectados iniciales y generar eventos
   for (int i = 0; i < num_poblacion; i++) {
     if (estado[i] == INFECTADO) {
       resultado->total_infectados++;
-      dia_infeccion[i] = 0;
+      sim->dia_infeccion[i] = 0;
       procesado[i] = true;
       
       // Generar evento de recuperación (día 12-19)
-      int dia_recuperacion = 12 + (rand() % 8);
-      EventoInfeccion *evento_recup = crear_evento(dia_recuperacion, i, 1);
+      int dia_recuperacion = 12 + rng_entero(rng, 8);
+      EventoInfeccion *evento_recup = crear_evento(sim, dia_recuperacion, i, 1);
       heap_insertar(heap, i, dia_recuperacion, evento_recup);
       resultado->num_eventos++;
       
       // IMPORTANTE: Generar contagios iniciales desde cada infectado inicial
       // Cada uno contagia 5-8 personas en los primeros días (R0 alto)
-      int max_contagios = 5 + (rand() % 4);
+      int max_contagios = 5 + rng_entero(rng, 4);
       int contagios = 0;
       
       for (int j = 0; j < num_poblacion && contagios < max_contagios; j++) {
-        if (estado[j] == SANO && !procesado[j] && (rand() % 100) < 60) {
-          int dia_contagio = 1 + (rand() % 3); // Días 1-3
-          EventoInfeccion *evento_inf = crear_evento(dia_contagio, j, 0);
+        if (estado[j] == SANO && !procesado[j] && rng_entero(rng, 100) < 60) {
+          int dia_contagio = 1 + rng_entero(rng, 3); // Días 1-3
+          EventoInfeccion *evento_inf = crear_evento(sim, dia_contagio, j, 0);
           heap_insertar(heap, j, dia_contagio, evento_inf);
           contagios++;
         }
@@ -101,157 +160,426 @@ ResultadoPropagacion* simular_propagacion_temporal(Territorio *territorios,
   resultado->recuperados_por_dia[0] = 0;
   resultado->muertos_por_dia[0] = 0;
   
-  // Procesar eventos con Min-Heap O(n log n)
-  int ultimo_dia = 0;
-  while (!heap_vacio(heap)) {
-    ElementoHeap elem = heap_extraer(heap);
-    EventoInfeccion *evento = (EventoInfeccion *)elem.datos;
+  return sim;
+}
+
+// Procesa un evento extraído del heap (y lo devuelve a la lista de libres)
+static void procesar_evento(EstadoSimulacion *sim, EventoInfeccion *evento) {
+  ResultadoPropagacion *resultado = sim->resultado;
+  EstadoSalud *estado = sim->estado;
+  bool *procesado = sim->procesado;
+  RngFlujo *rng = &sim->rng;
+  int num_poblacion = sim->num_poblacion;
+  int dias_simulacion = sim->dias_simulacion;
+  
+  int tiempo = evento->tiempo;
+  int ind_id = evento->individuo_id;
+  int tipo_evento = evento->individuo_origen; // 0=infección, 1=recuperación
+  INSTR_CONTAR(CONTADOR_EVENTOS_PROCESADOS, 1);
+  
+  // Actualizar estadísticas diarias si cambió el día
+  if (tiempo > sim->ultimo_dia) {
+    for (int d = sim->ultimo_dia + 1; d <= tiempo && d <= dias_simulacion; d++) {
+      resultado->infectados_por_dia[d] = resultado->total_infectados;
+      resultado->recuperados_por_dia[d] = resultado->total_recuperados;
+      resultado->muertos_por_dia[d] = resultado->total_muertos;
+    }
+    sim->ultimo_dia = tiempo;
+  }
+  
+  // EVENTO DE INFECCIÓN (tipo 0)
+  if (tipo_evento == 0 && estado[ind_id] == SANO && !procesado[ind_id]) {
+    estado[ind_id] = INFECTADO;
+    sim->dia_infeccion[ind_id] = tiempo;
+    procesado[ind_id] = true;
+    resultado->total_infectados++;
+    resultado->num_eventos++;
     
-    int tiempo = evento->tiempo;
-    int ind_id = evento->individuo_id;
-    int tipo_evento = evento->individuo_origen; // 0=infección, 1=recuperación
+    // Generar evento de recuperación para este nuevo infectado
+    int dias_duracion = 12 + rng_entero(rng, 8); // Entre 12 y 19 días
+    int dia_recup = tiempo + dias_duracion;
     
-    if (tiempo > dias_simulacion) {
-      free(evento);
-      continue;
+    if (dia_recup <= dias_simulacion + 10) { // Permitir recuperación después del último día
+      EventoInfeccion *evento_recup = crear_evento(sim, dia_recup, ind_id, 1);
+      heap_insertar(sim->heap, ind_id, dia_recup, evento_recup);
     }
     
-    // Actualizar estadísticas diarias si cambió el día
-    if (tiempo > ultimo_dia) {
-      for (int d = ultimo_dia + 1; d <= tiempo && d <= dias_simulacion; d++) {
-        resultado->infectados_por_dia[d] = resultado->total_infectados;
-        resultado->recuperados_por_dia[d] = resultado->total_recuperados;
-        resultado->muertos_por_dia[d] = resultado->total_muertos;
-      }
-      ultimo_dia = tiempo;
-    }
+    // Generar contagios a otros individuos SANOS (propagación controlada)
+    // Cada infectado contagia 4-7 personas en promedio (R0 alto para más propagación)
+    int max_contagios = 4 + rng_entero(rng, 4); // Entre 4 y 7 contagios por infectado
+    int contagios_generados = 0;
     
-    // EVENTO DE INFECCIÓN (tipo 0)
-    if (tipo_evento == 0 && estado[ind_id] == SANO && !procesado[ind_id]) {
-      estado[ind_id] = INFECTADO;
-      dia_infeccion[ind_id] = tiempo;
-      procesado[ind_id] = true;
-      resultado->total_infectados++;
-      resultado->num_eventos++;
-      
-      // Generar evento de recuperación para este nuevo infectado
-      int dias_duracion = 12 + (rand() % 8); // Entre 12 y 19 días
-      int dia_recup = tiempo + dias_duracion;
-      
-      if (dia_recup <= dias_simulacion + 10) { // Permitir recuperación después del día 30
-        EventoInfeccion *evento_recup = crear_evento(dia_recup, ind_id, 1);
-        heap_insertar(heap, ind_id, dia_recup, evento_recup);
-      }
-      
-      // Generar contagios a otros individuos SANOS (propagación controlada)
-      // Cada infectado contagia 4-7 personas en promedio (R0 alto para más propagación)
-      int max_contagios = 4 + (rand() % 4); // Entre 4 y 7 contagios por infectado
-      int contagios_generados = 0;
-      
-      for (int j = 0; j < num_poblacion && contagios_generados < max_contagios; j++) {
-        if (estado[j] == SANO && !procesado[j]) {
-          // 50% de probabilidad de contagiar a cada sano encontrado
-          if ((rand() % 100) < 50) {
-            // Contagio ocurre 1-3 días después
-            int delay = 1 + (rand() % 3);
-            int tiempo_contagio = tiempo + delay;
-            
-            if (tiempo_contagio <= dias_simulacion) {
-              EventoInfeccion *evento_contagio = crear_evento(tiempo_contagio, j, 0);
-              heap_insertar(heap, j, tiempo_contagio, evento_contagio);
-              contagios_generados++;
-            }
+    for (int j = 0; j < num_poblacion && contagios_generados < max_contagios; j++) {
+      if (estado[j] == SANO && !procesado[j]) {
+        // 50% de probabilidad de contagiar a cada sano encontrado
+        if (rng_entero(rng, 100) < 50) {
+          // Contagio ocurre 1-3 días después
+          int delay = 1 + rng_entero(rng, 3);
+          int tiempo_contagio = tiempo + delay;
+          
+          if (tiempo_contagio <= dias_simulacion) {
+            EventoInfeccion *evento_contagio = crear_evento(sim, tiempo_contagio, j, 0);
+            heap_insertar(sim->heap, j, tiempo_contagio, evento_contagio);
+            contagios_generados++;
           }
         }
       }
     }
+  }
+  
+  // EVENTO DE RECUPERACIÓN (tipo 1)
+  else if (tipo_evento == 1 && estado[ind_id] == INFECTADO) {
+    estado[ind_id] = RECUPERADO;
+    resultado->total_infectados--;
     
-    // EVENTO DE RECUPERACIÓN (tipo 1)
-    else if (tipo_evento == 1 && estado[ind_id] == INFECTADO) {
-      estado[ind_id] = RECUPERADO;
-      resultado->total_infectados--;
-      
-      // 1% de mortalidad
-      if ((rand() % 100) < 1) {
-        resultado->total_muertos++;
-      } else {
-        resultado->total_recuperados++;
-      }
+    // 1% de mortalidad
+    if (rng_entero(rng, 100) < 1) {
+      resultado->total_muertos++;
+    } else {
+      resultado->total_recuperados++;
     }
-    
-    free(evento);
   }
   
+  liberar_evento(sim, evento);
+}
+
+// Los eventos nuevos siempre caen en días posteriores al actual, así que
+// detenerse entre días no altera el orden de extracción del heap
+bool simulacion_avanzar_dia(EstadoSimulacion *sim) {
+  if (sim->dia_actual >= sim->dias_simulacion) return false;
+  
+  int dia = sim->dia_actual + 1;
+  uint64_t traza = traza_inicio();
+  while (!heap_vacio(sim->heap) && heap_peek(sim->heap).prioridad <= dia) {
+    ElementoHeap elem = heap_extraer(sim->heap);
+    procesar_evento(sim, (EventoInfeccion *)elem.datos);
+  }
+  traza_fin("dia", "propagacion", traza, dia);
+  
+  sim->dia_actual = dia;
+  return true;
+}
+
+bool simulacion_ejecutar(EstadoSimulacion *sim, const char *ruta_checkpoint, int cada_dias) {
+  bool ok = true;
+  while (simulacion_avanzar_dia(sim)) {
+    if (ruta_checkpoint && cada_dias > 0 && sim->dia_actual % cada_dias == 0 &&
+        sim->dia_actual < sim->dias_simulacion) {
+      INSTR_AMBITO_INICIO(ambito, "checkpoint");
+      ok = simulacion_guardar_checkpoint(sim, ruta_checkpoint) && ok;
+      INSTR_AMBITO_FIN(ambito);
+    }
+  }
+  return ok;
+}
+
+void simulacion_liberar(EstadoSimulacion *sim) {
+  if (!sim) return;
+  
+  // Los eventos (pendientes o no) viven en la arena: se liberan de una vez
+  if (sim->heap) heap_liberar(sim->heap);
+  arena_liberar(sim->eventos);
+  bio_free(sim->estado);
+  bio_free(sim->dia_infeccion);
+  bio_free(sim->procesado);
+  liberar_resultado_propagacion(sim->resultado);
+  bio_free(sim);
+}
+
+ResultadoPropagacion* simulacion_finalizar(EstadoSimulacion *sim) {
+  ResultadoPropagacion *resultado = sim->resultado;
+  
   // Actualizar últimos días
-  for (int d = ultimo_dia + 1; d <= dias_simulacion; d++) {
+  for (int d = sim->ultimo_dia + 1; d <= sim->dias_simulacion; d++) {
     resultado->infectados_por_dia[d] = resultado->total_infectados;
     resultado->recuperados_por_dia[d] = resultado->total_recuperados;
     resultado->muertos_por_dia[d] = resultado->total_muertos;
   }
   
-  // Liberar recursos
-  heap_liberar(heap);
-  free(estado);
-  free(dia_infeccion);
-  free(procesado);
-  
+  sim->resultado = NULL;
+  simulacion_liberar(sim);
   return resultado;
 }
 
+// Simular propagación con Min-Heap
+ResultadoPropagacion* simular_propagacion_temporal(const IndiceTerritorios *indice,
+                                                   Poblacion *poblacion,
+                                                   Cepa *cepas,
+                                                   int num_cepas,
+                                                   int dias_simulacion,
+                                                   uint64_t semilla) {
+  EstadoSimulacion *sim = simulacion_iniciar(indice, poblacion, dias_simulacion, semilla);
+  
+  // Procesar eventos con Min-Heap O(n log n), día por día
+  simulacion_ejecutar(sim, NULL, 0);
+  return simulacion_finalizar(sim);
+}
+
+// ===== CHECKPOINTS =====
+// Disposición (orden de bytes nativo, marca para detectar otra arquitectura):
+//   magia[8] version orden_bytes
+//   num_poblacion dias_simulacion dia_actual ultimo_dia
+//   total_infectados total_recuperados total_muertos num_eventos
+//   RNG: clave[2] contador[4] bloque[4] usados
+//   infectados/recuperados/muertos_por_dia [dias + 1]
+//   estado[n] (1 byte) procesado[n] (1 byte) dia_infeccion[n]
+//   num_pendientes, eventos (tiempo, individuo, tipo) en el orden del heap
+
+static const char MAGIA_CHECKPOINT[8] = { 'B', 'I', 'O', 'S', 'I', 'M', 'C', 'P' };
+#define VERSION_CHECKPOINT 1
+#define MARCA_ORDEN_BYTES 0x01020304u
+#define BLOQUE_BYTES 65536
+
+static bool escribir_bloque(FILE *archivo, const void *datos, size_t bytes) {
+  return bytes == 0 || fwrite(datos, 1, bytes, archivo) == bytes;
+}
+
+static bool leer_bloque(FILE *archivo, void *datos, size_t bytes) {
+  return bytes == 0 || fread(datos, 1, bytes, archivo) == bytes;
+}
+
+static bool escribir_entero(FILE *archivo, int32_t valor) {
+  return escribir_bloque(archivo, &valor, sizeof(valor));
+}
+
+static bool leer_entero(FILE *archivo, int *valor) {
+  int32_t leido;
+  if (!leer_bloque(archivo, &leido, sizeof(leido))) return false;
+  *valor = (int)leido;
+  return true;
+}
+
+bool simulacion_guardar_checkpoint(const EstadoSimulacion *sim, const char *ruta) {
+  size_t largo_ruta = strlen(ruta);
+  char *ruta_temporal = (char *)bio_malloc(largo_ruta + 5);
+  memcpy(ruta_temporal, ruta, largo_ruta);
+  memcpy(ruta_temporal + largo_ruta, ".tmp", 5);
+  
+  FILE *archivo = fopen(ruta_temporal, "wb");
+  if (!archivo) {
+    bio_free(ruta_temporal);
+    return false;
+  }
+  
+  const ResultadoPropagacion *resultado = sim->resultado;
+  int n = sim->num_poblacion;
+  size_t dias = (size_t)sim->dias_simulacion + 1;
+  uint32_t version = VERSION_CHECKPOINT;
+  uint32_t orden = MARCA_ORDEN_BYTES;
+  
+  bool ok = escribir_bloque(archivo, MAGIA_CHECKPOINT, sizeof(MAGIA_CHECKPOINT)) &&
+            escribir_bloque(archivo, &version, sizeof(version)) &&
+            escribir_bloque(archivo, &orden, sizeof(orden)) &&
+            escribir_entero(archivo, n) &&
+            escribir_entero(archivo, sim->dias_simulacion) &&
+            escribir_entero(archivo, sim->dia_actual) &&
+            escribir_entero(archivo, sim->ultimo_dia) &&
+            escribir_entero(archivo, resultado->total_infectados) &&
+            escribir_entero(archivo, resultado->total_recuperados) &&
+            escribir_entero(archivo, resultado->total_muertos) &&
+            escribir_entero(archivo, resultado->num_eventos) &&
+            escribir_bloque(archivo, sim->rng.clave, sizeof(sim->rng.clave)) &&
+            escribir_bloque(archivo, sim->rng.contador, sizeof(sim->rng.contador)) &&
+            escribir_bloque(archivo, sim->rng.bloque, sizeof(sim->rng.bloque)) &&
+            escribir_entero(archivo, sim->rng.usados) &&
+            escribir_bloque(archivo, resultado->infectados_por_dia, dias * sizeof(int)) &&
+            escribir_bloque(archivo, resultado->recuperados_por_dia, dias * sizeof(int)) &&
+            escribir_bloque(archivo, resultado->muertos_por_dia, dias * sizeof(int));
+  
+  // estado y procesado se compactan a un byte por individuo
+  unsigned char buffer[BLOQUE_BYTES];
+  for (int desde = 0; ok && desde < n; desde += BLOQUE_BYTES) {
+    int cantidad = n - desde < BLOQUE_BYTES ? n - desde : BLOQUE_BYTES;
+    for (int k = 0; k < cantidad; k++) buffer[k] = (unsigned char)sim->estado[desde + k];
+    ok = escribir_bloque(archivo, buffer, cantidad);
+  }
+  for (int desde = 0; ok && desde < n; desde += BLOQUE_BYTES) {
+    int cantidad = n - desde < BLOQUE_BYTES ? n - desde : BLOQUE_BYTES;
+    for (int k = 0; k < cantidad; k++) buffer[k] = sim->procesado[desde + k] ? 1 : 0;
+    ok = escribir_bloque(archivo, buffer, cantidad);
+  }
+  ok = ok && escribir_bloque(archivo, sim->dia_infeccion, (size_t)n * sizeof(int));
+  
+  // Heap de eventos pendientes en su disposición interna: al restaurarlo
+  // tal cual, el orden de extracción (incluidos empates) es el mismo
+  ok = ok && escribir_entero(archivo, sim->heap->tamano);
+  for (int i = 0; ok && i < sim->heap->tamano; i++) {
+    const EventoInfeccion *evento = (const EventoInfeccion *)sim->heap->elementos[i].datos;
+    ok = escribir_entero(archivo, evento->tiempo) &&
+         escribir_entero(archivo, evento->individuo_id) &&
+         escribir_entero(archivo, evento->individuo_origen);
+  }
+  
+  if (fclose(archivo) != 0) ok = false;
+  
+#ifdef _WIN32
+  if (ok) remove(ruta); // rename no reemplaza destinos existentes en Windows
+#endif
+  if (ok) ok = rename(ruta_temporal, ruta) == 0;
+  if (!ok) remove(ruta_temporal);
+  bio_free(ruta_temporal);
+  return ok;
+}
+
+EstadoSimulacion* simulacion_reanudar(const char *ruta, const IndiceTerritorios *indice,
+                                      const Poblacion *poblacion) {
+  FILE *archivo = fopen(ruta, "rb");
+  if (!archivo) return NULL;
+  
+  char magia[8];
+  uint32_t version, orden;
+  int n, dias_simulacion;
+  bool ok = leer_bloque(archivo, magia, sizeof(magia)) &&
+            memcmp(magia, MAGIA_CHECKPOINT, sizeof(magia)) == 0 &&
+            leer_bloque(archivo, &version, sizeof(version)) && version == VERSION_CHECKPOINT &&
+            leer_bloque(archivo, &orden, sizeof(orden)) && orden == MARCA_ORDEN_BYTES &&
+            leer_entero(archivo, &n) && n == poblacion->num_individuos &&
+            leer_entero(archivo, &dias_simulacion) && dias_simulacion >= 0;
+  if (!ok) {
+    fclose(archivo);
+    return NULL;
+  }
+  
+  EstadoSimulacion *sim = reservar_simulacion(indice, poblacion, dias_simulacion);
+  ResultadoPropagacion *resultado = sim->resultado;
+  size_t dias = (size_t)dias_simulacion + 1;
+  
+  ok = leer_entero(archivo, &sim->dia_actual) &&
+       leer_entero(archivo, &sim->ultimo_dia) &&
+       leer_entero(archivo, &resultado->total_infectados) &&
+       leer_entero(archivo, &resultado->total_recuperados) &&
+       leer_entero(archivo, &resultado->total_muertos) &&
+       leer_entero(archivo, &resultado->num_eventos) &&
+       leer_bloque(archivo, sim->rng.clave, sizeof(sim->rng.clave)) &&
+       leer_bloque(archivo, sim->rng.contador, sizeof(sim->rng.contador)) &&
+       leer_bloque(archivo, sim->rng.bloque, sizeof(sim->rng.bloque)) &&
+       leer_entero(archivo, &sim->rng.usados) &&
+       leer_bloque(archivo, resultado->infectados_por_dia, dias * sizeof(int)) &&
+       leer_bloque(archivo, resultado->recuperados_por_dia, dias * sizeof(int)) &&
+       leer_bloque(archivo, resultado->muertos_por_dia, dias * sizeof(int));
+  
+  unsigned char buffer[BLOQUE_BYTES];
+  for (int desde = 0; ok && desde < n; desde += BLOQUE_BYTES) {
+    int cantidad = n - desde < BLOQUE_BYTES ? n - desde : BLOQUE_BYTES;
+    ok = leer_bloque(archivo, buffer, cantidad);
+    for (int k = 0; ok && k < cantidad; k++) sim->estado[desde + k] = (EstadoSalud)buffer[k];
+  }
+  for (int desde = 0; ok && desde < n; desde += BLOQUE_BYTES) {
+    int cantidad = n - desde < BLOQUE_BYTES ? n - desde : BLOQUE_BYTES;
+    ok = leer_bloque(archivo, buffer, cantidad);
+    for (int k = 0; ok && k < cantidad; k++) sim->procesado[desde + k] = buffer[k] != 0;
+  }
+  ok = ok && leer_bloque(archivo, sim->dia_infeccion, (size_t)n * sizeof(int));
+  
+  int pendientes = 0;
+  ok = ok && leer_entero(archivo, &pendientes) && pendientes >= 0;
+  if (ok) {
+    int capacidad = pendientes > n * 2 ? pendientes : n * 2;
+    sim->heap = heap_crear(capacidad > 0 ? capacidad : 1, true);
+  }
+  for (int i = 0; ok && i < pendientes; i++) {
+    int tiempo, individuo, tipo;
+    ok = leer_entero(archivo, &tiempo) && leer_entero(archivo, &individuo) &&
+         leer_entero(archivo, &tipo) && individuo >= 0 && individuo < n;
+    if (ok) {
+      ElementoHeap *elem = &sim->heap->elementos[i];
+      elem->individuo_id = individuo;
+      elem->prioridad = tiempo;
+      elem->datos = crear_evento(sim, tiempo, individuo, tipo);
+      sim->heap->tamano = i + 1;
+    }
+  }
+  
+  fclose(archivo);
+  if (!ok) {
+    simulacion_liberar(sim);
+    return NULL;
+  }
+  return sim;
+}
+
 // Liberar resultado
 void liberar_resultado_propagacion(ResultadoPropagacion *resultado) {
   if (resultado) {
-    free(resultado->infectados_por_dia);
-    free(resultado->recuperados_por_dia);
-    free(resultado->muertos_por_dia);
-    free(resultado);
+    bio_free(resultado->infectados_por_dia);
+    bio_free(resultado->recuperados_por_dia);
+    bio_free(resultado->muertos_por_dia);
+    bio_free(resultado);
   }
 }
 
 // Función de prueba
-void test_propagacion_temporal(Territorio *territorios, int num_territorios,
-                               Individuo *poblacion, int num_poblacion,
-                               Cepa *cepas, int num_cepas) {
-  printf("\n========== SUBPROBLEMA 3: PROPAGACION TEMPORAL ==========\n");
-  printf("Poblacion: %d individuos\n", num_poblacion);
-  printf("Territorios: %d\n", num_territorios);
-  printf("Cepas: %d\n", num_cepas);
-  
-  int dias = 60;
-  ResultadoPropagacion *resultado = simular_propagacion_temporal(
-    territorios, num_territorios, poblacion, num_poblacion, cepas, num_cepas, dias);
-  
-  printf("\n--- RESULTADOS DE SIMULACION (60 DIAS) ---\n");
-  printf("Total de eventos procesados: %d\n", resultado->num_eventos);
-  printf("Infectados totales: %d\n", resultado->total_infectados);
-  printf("Recuperados totales: %d\n", resultado->total_recuperados);
-  printf("Muertos totales: %d\n", resultado->total_muertos);
-  printf("Dias simulados: %d\n", resultado->dias_simulados);
-  
-  printf("\nProgresion por dia (muestra cada 10 dias):\n");
-  printf("  Dia | Infectados | Recuperados | Muertos\n");
-  printf("------+------------+-------------+--------\n");
+int test_propagacion_temporal(const IndiceTerritorios *indice,
+                              Poblacion *poblacion,
+                              Cepa *cepas, int num_cepas,
+                              const OpcionesPropagacion *opciones,
+                              uint64_t semilla,
+                              FILE *salida) {
+  int num_poblacion = poblacion->num_individuos;
+  (void)cepas;
+  
+  fprintf(salida, "\n========== SUBPROBLEMA 3: PROPAGACION TEMPORAL ==========\n");
+  fprintf(salida, "Poblacion: %d individuos\n", num_poblacion);
+  fprintf(salida, "Territorios: %d\n", indice->num_territorios);
+  fprintf(salida, "Cepas: %d\n", num_cepas);
+  
+  int dias = opciones && opciones->dias > 0 ? opciones->dias : 60;
+  const char *ruta = opciones ? opciones->ruta_checkpoint : NULL;
+  int cada_dias = opciones ? opciones->checkpoint_cada_dias : 0;
+  
+  // Reanudar desde checkpoint si se pidió y el archivo es compatible
+  EstadoSimulacion *sim = NULL;
+  if (ruta && opciones->reanudar) {
+    sim = simulacion_reanudar(ruta, indice, poblacion);
+    if (sim && sim->dias_simulacion != dias) {
+      fprintf(salida, "Checkpoint de %d dias ignorado (se piden %d)\n", sim->dias_simulacion, dias);
+      simulacion_liberar(sim);
+      sim = NULL;
+    }
+    if (sim) fprintf(salida, "Reanudando desde checkpoint %s (dia %d)\n", ruta, sim->dia_actual);
+  }
+  if (!sim) sim = simulacion_iniciar(indice, poblacion, dias, semilla);
+  
+  if (!simulacion_ejecutar(sim, ruta, cada_dias)) {
+    fprintf(salida, "ADVERTENCIA: no se pudo escribir el checkpoint %s\n", ruta);
+  } else if (ruta && cada_dias > 0) {
+    fprintf(salida, "Checkpoints cada %d dias en %s\n", cada_dias, ruta);
+  }
+  ResultadoPropagacion *resultado = simulacion_finalizar(sim);
+  
+  fprintf(salida, "\n--- RESULTADOS DE SIMULACION (%d DIAS) ---\n", dias);
+  fprintf(salida, "Total de eventos procesados: %d\n", resultado->num_eventos);
+  fprintf(salida, "Infectados totales: %d\n", resultado->total_infectados);
+  fprintf(salida, "Recuperados totales: %d\n", resultado->total_recuperados);
+  fprintf(salida, "Muertos totales: %d\n", resultado->total_muertos);
+  fprintf(salida, "Dias simulados: %d\n", resultado->dias_simulados);
+  
+  fprintf(salida, "\nProgresion por dia (muestra cada 10 dias):\n");
+  fprintf(salida, "  Dia | Infectados | Recuperados | Muertos\n");
+  fprintf(salida, "------+------------+-------------+--------\n");
   for (int d = 0; d <= dias && d <= resultado->dias_simulados; d += 10) {
-    printf("  %3d | %10d | %11d | %7d\n",
-           d,
-           resultado->infectados_por_dia[d],
-           resultado->recuperados_por_dia[d],
-           resultado->muertos_por_dia[d]);
+    fprintf(salida, "  %3d | %10d | %11d | %7d\n",
+            d,
+            resultado->infectados_por_dia[d],
+            resultado->recuperados_por_dia[d],
+            resultado->muertos_por_dia[d]);
   }
   
-  printf("\nEstadisticas finales (dia %d):\n", dias);
-  printf("  Infectados: %d (%.1f%% de poblacion)\n",
-         resultado->total_infectados,
-         (100.0f * resultado->total_infectados) / num_poblacion);
-  printf("  Recuperados: %d (%.1f%% de poblacion)\n",
-         resultado->total_recuperados,
-         (100.0f * resultado->total_recuperados) / num_poblacion);
-  printf("  Muertos: %d (%.1f%% de poblacion)\n",
-         resultado->total_muertos,
-         (100.0f * resultado->total_muertos) / num_poblacion);
+  fprintf(salida, "\nEstadisticas finales (dia %d):\n", dias);
+  fprintf(salida, "  Infectados: %d (%.1f%% de poblacion)\n",
+          resultado->total_infectados,
+          (100.0f * resultado->total_infectados) / num_poblacion);
+  fprintf(salida, "  Recuperados: %d (%.1f%% de poblacion)\n",
+          resultado->total_recuperados,
+          (100.0f * resultado->total_recuperados) / num_poblacion);
+  fprintf(salida, "  Muertos: %d (%.1f%% de poblacion)\n",
+          resultado->total_muertos,
+          (100.0f * resultado->total_muertos) / num_poblacion);
   
-  printf("\nComplejidad: O(n log n) donde n = %d eventos\n", resultado->num_eventos);
-  printf("===== FIN PRUEBAS SUBPROBLEMA 3 =====\n");
+  fprintf(salida, "\nComplejidad: O(n log n) donde n = %d eventos\n", resultado->num_eventos);
+  fprintf(salida, "===== FIN PRUEBAS SUBPROBLEMA 3 =====\n");
   
+  int num_eventos = resultado->num_eventos;
   liberar_resultado_propagacion(resultado);
+  return num_eventos;
 }
@@ -2,6 +2,8 @@
 #define PROPAGACION_TEMPORAL_H
 
 #include "estructuras.h"
+#include "arena.h"
+#include "rng.h"
 
 // ============================================================
 // SUBPROBLEMA 3: Propagación Temporal
@@ -10,30 +12,110 @@
 // Estructura: Min-Heap para gestionar eventos cronológicos
 // ============================================================
 
+// Estado completo de una simulación en curso
+// Todo lo necesario para continuarla vive aquí (no en variables locales),
+// de modo que puede guardarse en un checkpoint y reanudarse más tarde
+typedef struct {
+  const IndiceTerritorios *indice;
+  const Poblacion *poblacion;
+  int num_poblacion;
+  int dias_simulacion;
+  int dia_actual;        // Último día completamente procesado
+  int ultimo_dia;        // Día del último evento procesado
+  EstadoSalud *estado;
+  int *dia_infeccion;
+  bool *procesado;
+  Heap *heap;            // Min-Heap de EventoInfeccion* por día
+  Arena *eventos;        // Bloques de donde salen los EventoInfeccion
+  void *eventos_libres;  // Lista de eventos ya procesados, para reutilizar
+  RngFlujo rng;
+  ResultadoPropagacion *resultado;
+} EstadoSimulacion;
+
+// Opciones de la prueba: duración y checkpoints periódicos
+typedef struct {
+  int dias;                       // Días a simular
+  const char *ruta_checkpoint;    // NULL = sin checkpoints
+  int checkpoint_cada_dias;       // Intervalo entre checkpoints
+  bool reanudar;                  // Continuar desde ruta_checkpoint si existe
+} OpcionesPropagacion;
+
+/**
+ * Prepara una simulación: estado inicial, eventos del día 0
+ * El flujo aleatorio deriva de la semilla del escenario
+ * Complejidad: O(n log n)
+ */
+EstadoSimulacion* simulacion_iniciar(const IndiceTerritorios *indice, const Poblacion *poblacion,
+                                     int dias_simulacion, uint64_t semilla);
+
+/**
+ * Procesa todos los eventos del día siguiente
+ * Complejidad: O(k log n) con k = eventos del día
+ * Retorna: false si la simulación ya llegó a dias_simulacion
+ */
+bool simulacion_avanzar_dia(EstadoSimulacion *sim);
+
+/**
+ * Avanza hasta el final guardando un checkpoint cada 'cada_dias' días
+ * (ruta NULL o cada_dias <= 0: sin checkpoints)
+ * Complejidad: O(n log n)
+ * Retorna: false si algún checkpoint no pudo escribirse
+ */
+bool simulacion_ejecutar(EstadoSimulacion *sim, const char *ruta_checkpoint, int cada_dias);
+
+/**
+ * Escribe el estado completo (arrays, heap de eventos pendientes en su
+ * disposición interna, contadores y estado del RNG) en un archivo binario.
+ * Se escribe en ruta.tmp y se renombra: un corte a mitad de escritura
+ * conserva el checkpoint anterior
+ * Complejidad: O(n + eventos pendientes)
+ */
+bool simulacion_guardar_checkpoint(const EstadoSimulacion *sim, const char *ruta);
+
+/**
+ * Reconstruye una simulación desde un checkpoint
+ * La población debe ser la misma con la que se guardó
+ * Complejidad: O(n + eventos pendientes)
+ * Retorna: EstadoSimulacion o NULL si el archivo no es válido
+ */
+EstadoSimulacion* simulacion_reanudar(const char *ruta, const IndiceTerritorios *indice,
+                                      const Poblacion *poblacion);
+
+/**
+ * Completa las estadísticas de los días restantes y libera el estado
+ * Complejidad: O(dias + eventos pendientes)
+ * Retorna: ResultadoPropagacion (propiedad del llamador)
+ */
+ResultadoPropagacion* simulacion_finalizar(EstadoSimulacion *sim);
+
+/**
+ * Libera el estado sin producir resultado
+ * Complejidad: O(bloques de eventos)
+ */
+void simulacion_liberar(EstadoSimulacion *sim);
+
 /**
  * Simula la propagación temporal de la infección
  * Usa Min-Heap para procesar eventos en orden cronológico
  * Complejidad: O(n log n) donde n es número total de eventos
  * 
  * Parámetros:
- *   - territorios: array de territorios
- *   - num_territorios: cantidad de territorios
- *   - poblacion: array de individuos
- *   - num_poblacion: cantidad de individuos
+ *   - indice: índice territorio -> miembros
+ *   - poblacion: población columnar (se lee la columna de estado)
  *   - cepas: array de cepas virales
  *   - num_cepas: cantidad de cepas
  *   - dias_simulacion: número de días a simular
+ *   - semilla: semilla del escenario
  * 
  * Retorna: ResultadoPropagacion con estadísticas de la simulación
  */
 ResultadoPropagacion* simular_propagacion_temporal(
-  Territorio *territorios,
-  int num_territorios,
-  Individuo *poblacion,
-  int num_poblacion,
+  const IndiceTerritorios *indice,
+  Poblacion *poblacion,
   Cepa *cepas,
   int num_cepas,
-  int dias_simulacion
+  int dias_simulacion,
+  uint64_t semilla
 );
 
 /**
@@ -45,10 +127,16 @@ void liberar_resultado_propagacion(ResultadoPropagacion *resultado);
 /**
  * Función de prueba para Subproblema 3
  * Ejecuta simulación y muestra resultados
+ * opciones NULL: 60 días sin checkpoints
  * Complejidad: O(n log n)
+ * El reporte se escribe en salida (stdout o el buffer de la etapa)
+ * Retorna: Eventos procesados por la simulación
  */
-void test_propagacion_temporal(Territorio *territorios, int num_territorios,
-                               Individuo *poblacion, int num_poblacion,
-                               Cepa *cepas, int num_cepas);
+int test_propagacion_temporal(const IndiceTerritorios *indice,
+                              Poblacion *poblacion,
+                              Cepa *cepas, int num_cepas,
+                              const OpcionesPropagacion *opciones,
+                              uint64_t semilla,
+                              FILE *salida);
 
 #endif // PROPAGACION_TEMPORAL_H
@@ -0,0 +1,133 @@
+#include "registro_eventos.h"
+#include "memoria.h"
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================
+// IMPLEMENTACION REGISTRO DE EVENTOS
+// Las columnas crecen al doble todas juntas; los eventos nunca se
+// mueven de índice, así que las cadenas por fila siguen valiendo
+// ============================================================
+
+#define REGISTRO_CAPACIDAD_INICIAL 64
+
+// Amplía cada columna a 'capacidad' eventos (si falla alguna, las ya
+// ampliadas quedan más grandes y el registro sigue siendo válido)
+static bool ampliar(RegistroEventos *registro, int capacidad) {
+  time_t *timestamp = (time_t *)bio_realloc(registro->timestamp, (size_t)capacidad * sizeof(time_t));
+  if (!timestamp) return false;
+  registro->timestamp = timestamp;
+
+  int *individuo_id = (int *)bio_realloc(registro->individuo_id, (size_t)capacidad * sizeof(int));
+  if (!individuo_id) return false;
+  registro->individuo_id = individuo_id;
+
+  unsigned char *anterior = (unsigned char *)bio_realloc(registro->estado_anterior, (size_t)capacidad);
+  if (!anterior) return false;
+  registro->estado_anterior = anterior;
+
+  unsigned char *nuevo = (unsigned char *)bio_realloc(registro->estado_nuevo, (size_t)capacidad);
+  if (!nuevo) return false;
+  registro->estado_nuevo = nuevo;
+
+  int *siguiente = (int *)bio_realloc(registro->siguiente, (size_t)capacidad * sizeof(int));
+  if (!siguiente) return false;
+  registro->siguiente = siguiente;
+
+  registro->capacidad = capacidad;
+  return true;
+}
+
+RegistroEventos* registro_eventos_crear(int num_filas) {
+  if (num_filas < 0) return NULL;
+  RegistroEventos *registro = (RegistroEventos *)bio_calloc(1, sizeof(RegistroEventos));
+  if (!registro) return NULL;
+
+  size_t filas = (size_t)(num_filas > 0 ? num_filas : 1);
+  registro->primero = (int *)bio_malloc(filas * sizeof(int));
+  registro->ultimo = (int *)bio_malloc(filas * sizeof(int));
+  if (!registro->primero || !registro->ultimo) {
+    bio_free(registro->primero);
+    bio_free(registro->ultimo);
+    bio_free(registro);
+    return NULL;
+  }
+  memset(registro->primero, 0xFF, filas * sizeof(int));  // -1
+  memset(registro->ultimo, 0xFF, filas * sizeof(int));
+  registro->num_filas = num_filas;
+  pthread_mutex_init(&registro->cerrojo, NULL);
+  return registro;
+}
+
+bool registro_eventos_agregar(RegistroEventos *registro, int fila, int individuo_id,
+                              time_t timestamp, EstadoSalud anterior, EstadoSalud nuevo) {
+  if (!registro || fila < 0 || fila >= registro->num_filas) return false;
+  pthread_mutex_lock(&registro->cerrojo);
+
+  if (registro->num_eventos == registro->capacidad) {
+    int capacidad = registro->capacidad ? registro->capacidad * 2 : REGISTRO_CAPACIDAD_INICIAL;
+    if (registro->capacidad > (1 << 29) || !ampliar(registro, capacidad)) {
+      pthread_mutex_unlock(&registro->cerrojo);
+      return false;
+    }
+  }
+
+  int evento = registro->num_eventos++;
+  registro->timestamp[evento] = timestamp;
+  registro->individuo_id[evento] = individuo_id;
+  registro->estado_anterior[evento] = (unsigned char)anterior;
+  registro->estado_nuevo[evento] = (unsigned char)nuevo;
+  registro->siguiente[evento] = -1;
+
+  // Encadenar al final de los eventos de la fila
+  if (registro->ultimo[fila] < 0) {
+    registro->primero[fila] = evento;
+  } else {
+    registro->siguiente[registro->ultimo[fila]] = evento;
+  }
+  registro->ultimo[fila] = evento;
+
+  pthread_mutex_unlock(&registro->cerrojo);
+  return true;
+}
+
+int registro_eventos_historial(RegistroEventos *registro, int fila, CambioEstado *cambios, int max_cambios) {
+  if (!registro || fila < 0 || fila >= registro->num_filas) return 0;
+  pthread_mutex_lock(&registro->cerrojo);
+
+  int total = 0;
+  for (int evento = registro->primero[fila]; evento >= 0; evento = registro->siguiente[evento]) {
+    if (total < max_cambios) {
+      cambios[total].timestamp = registro->timestamp[evento];
+      cambios[total].estado_anterior = (EstadoSalud)registro->estado_anterior[evento];
+      cambios[total].estado_nuevo = (EstadoSalud)registro->estado_nuevo[evento];
+    }
+    total++;
+  }
+
+  pthread_mutex_unlock(&registro->cerrojo);
+  return total;
+}
+
+size_t registro_eventos_bytes(RegistroEventos *registro) {
+  if (!registro) return 0;
+  pthread_mutex_lock(&registro->cerrojo);
+  size_t por_evento = sizeof(time_t) + 2 * sizeof(int) + 2;
+  size_t bytes = sizeof(RegistroEventos) + (size_t)registro->capacidad * por_evento
+                 + 2 * (size_t)registro->num_filas * sizeof(int);
+  pthread_mutex_unlock(&registro->cerrojo);
+  return bytes;
+}
+
+void registro_eventos_liberar(RegistroEventos *registro) {
+  if (!registro) return;
+  pthread_mutex_destroy(&registro->cerrojo);
+  bio_free(registro->timestamp);
+  bio_free(registro->individuo_id);
+  bio_free(registro->estado_anterior);
+  bio_free(registro->estado_nuevo);
+  bio_free(registro->siguiente);
+  bio_free(registro->primero);
+  bio_free(registro->ultimo);
+  bio_free(registro);
+}
@@ -0,0 +1,75 @@
+#ifndef REGISTRO_EVENTOS_H
+#define REGISTRO_EVENTOS_H
+
+#include "estructuras.h"
+#include <pthread.h>
+#include <time.h>
+
+// ============================================================
+// REGISTRO DE EVENTOS - Historial de cambios de estado
+// Un solo registro de solo agregado para toda la Poblacion, guardado
+// por columnas (timestamp, id, estado anterior, estado nuevo). Los
+// eventos de una fila quedan encadenados (primero/ultimo por fila y
+// siguiente por evento): agregar es O(1) y el historial de una fila se
+// recorre en O(k) sin reservar nada por individuo de antemano.
+// Agregar y leer pueden venir de varios hilos (cerrojo interno).
+// ============================================================
+
+typedef struct {
+  time_t timestamp;
+  EstadoSalud estado_anterior;
+  EstadoSalud estado_nuevo;
+} CambioEstado;
+
+typedef struct {
+  int num_eventos;
+  int capacidad;
+  // Columnas (una posición por evento)
+  time_t *timestamp;
+  int *individuo_id;
+  unsigned char *estado_anterior;
+  unsigned char *estado_nuevo;
+  int *siguiente;            // Próximo evento de la misma fila (-1 = último)
+  // Cabeza y cola de la cadena de cada fila (-1 = sin eventos)
+  int num_filas;
+  int *primero;
+  int *ultimo;
+  pthread_mutex_t cerrojo;
+} RegistroEventos;
+
+/**
+ * Crea un registro vacío para una Poblacion de num_filas filas
+ * Complejidad: O(num_filas)
+ * Retorna: RegistroEventos o NULL si no hay memoria
+ */
+RegistroEventos* registro_eventos_crear(int num_filas);
+
+/**
+ * Agrega un cambio de estado de la fila al final del registro
+ * Complejidad: O(1) amortizado
+ * Retorna: false si no hay memoria o la fila no existe
+ */
+bool registro_eventos_agregar(RegistroEventos *registro, int fila, int individuo_id,
+                              time_t timestamp, EstadoSalud anterior, EstadoSalud nuevo);
+
+/**
+ * Copia los primeros max_cambios cambios de la fila (del más antiguo al
+ * más nuevo) en cambios
+ * Complejidad: O(k) con k = cambios de la fila
+ * Retorna: Cantidad total de cambios de la fila
+ */
+int registro_eventos_historial(RegistroEventos *registro, int fila, CambioEstado *cambios, int max_cambios);
+
+/**
+ * Memoria reservada por el registro, en bytes
+ * Complejidad: O(1)
+ */
+size_t registro_eventos_bytes(RegistroEventos *registro);
+
+/**
+ * Libera el registro
+ * Complejidad: O(1)
+ */
+void registro_eventos_liberar(RegistroEventos *registro);
+
+#endif // REGISTRO_EVENTOS_H
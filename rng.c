@@ -0,0 +1,147 @@
+#include "rng.h"
+
+// ============================================================
+// IMPLEMENTACION RNG: Philox4x32-10 (Salmon et al., SC'11)
+// 10 rondas de multiplicación 32x32->64 con clave de 64 bits
+// ============================================================
+
+#define PHILOX_M0 0xD2511F53u
+#define PHILOX_M1 0xCD9E8D57u
+#define PHILOX_W0 0x9E3779B9u
+#define PHILOX_W1 0xBB67AE85u
+
+// Escala para convertir 24 bits a float en [0, 1)
+#define RNG_ESCALA_24 (1.0f / 16777216.0f)
+
+static void philox4x32_10(const uint32_t entrada[4], const uint32_t clave_inicial[2],
+                          uint32_t salida[4]) {
+  uint32_t c0 = entrada[0], c1 = entrada[1], c2 = entrada[2], c3 = entrada[3];
+  uint32_t k0 = clave_inicial[0], k1 = clave_inicial[1];
+
+  for (int ronda = 0; ronda < 10; ronda++) {
+    uint64_t p0 = (uint64_t)PHILOX_M0 * c0;
+    uint64_t p1 = (uint64_t)PHILOX_M1 * c2;
+    uint32_t n0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+    uint32_t n1 = (uint32_t)p1;
+    uint32_t n2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+    uint32_t n3 = (uint32_t)p0;
+    c0 = n0; c1 = n1; c2 = n2; c3 = n3;
+    k0 += PHILOX_W0;
+    k1 += PHILOX_W1;
+  }
+
+  salida[0] = c0;
+  salida[1] = c1;
+  salida[2] = c2;
+  salida[3] = c3;
+}
+
+static void incrementar_contador(RngFlujo *rng) {
+  if (++rng->contador[0] == 0) {
+    ++rng->contador[1];
+  }
+}
+
+RngFlujo rng_flujo_crear(uint64_t semilla, uint64_t flujo) {
+  RngFlujo rng;
+  rng.clave[0] = (uint32_t)semilla;
+  rng.clave[1] = (uint32_t)(semilla >> 32);
+  rng.contador[0] = 0;
+  rng.contador[1] = 0;
+  rng.contador[2] = (uint32_t)flujo;
+  rng.contador[3] = (uint32_t)(flujo >> 32);
+  rng.bloque[0] = rng.bloque[1] = rng.bloque[2] = rng.bloque[3] = 0;
+  rng.usados = 4;
+  return rng;
+}
+
+uint32_t rng_siguiente(RngFlujo *rng) {
+  if (rng->usados >= 4) {
+    philox4x32_10(rng->contador, rng->clave, rng->bloque);
+    incrementar_contador(rng);
+    rng->usados = 0;
+  }
+  return rng->bloque[rng->usados++];
+}
+
+float rng_uniforme(RngFlujo *rng) {
+  return (rng_siguiente(rng) >> 8) * RNG_ESCALA_24;
+}
+
+float rng_rango_float(RngFlujo *rng, float min, float max) {
+  return min + rng_uniforme(rng) * (max - min);
+}
+
+int rng_entero(RngFlujo *rng, int n) {
+  if (n <= 0) return 0;
+  // Multiplicación y desplazamiento (Lemire): evita la división de %
+  return (int)(((uint64_t)rng_siguiente(rng) * (uint32_t)n) >> 32);
+}
+
+bool rng_bernoulli(RngFlujo *rng, float p) {
+  return rng_uniforme(rng) < p;
+}
+
+// Bloques por iteración en la generación por lotes
+#define RNG_CARRILES 8
+
+void rng_uniformes_lote(RngFlujo *rng, float *salida, int n) {
+  int i = 0;
+
+  // Consumir primero lo que quede del bloque actual
+  while (i < n && rng->usados < 4) {
+    salida[i++] = rng_uniforme(rng);
+  }
+
+  // Bloques completos: RNG_CARRILES contadores independientes por iteración
+  uint32_t entrada[RNG_CARRILES][4];
+  uint32_t bloques[RNG_CARRILES][4];
+  while (n - i >= 4 * RNG_CARRILES) {
+    for (int c = 0; c < RNG_CARRILES; c++) {
+      entrada[c][0] = rng->contador[0];
+      entrada[c][1] = rng->contador[1];
+      entrada[c][2] = rng->contador[2];
+      entrada[c][3] = rng->contador[3];
+      incrementar_contador(rng);
+    }
+    for (int c = 0; c < RNG_CARRILES; c++) {
+      philox4x32_10(entrada[c], rng->clave, bloques[c]);
+    }
+    for (int c = 0; c < RNG_CARRILES; c++) {
+      for (int w = 0; w < 4; w++) {
+        salida[i + 4 * c + w] = (bloques[c][w] >> 8) * RNG_ESCALA_24;
+      }
+    }
+    i += 4 * RNG_CARRILES;
+  }
+
+  // Resto
+  while (i < n) {
+    salida[i++] = rng_uniforme(rng);
+  }
+}
+
+void rng_bernoulli_lote(RngFlujo *rng, float p, unsigned char *salida, int n) {
+  float uniformes[4 * RNG_CARRILES];
+
+  for (int i = 0; i < n; i += 4 * RNG_CARRILES) {
+    int tramo = n - i < 4 * RNG_CARRILES ? n - i : 4 * RNG_CARRILES;
+    rng_uniformes_lote(rng, uniformes, tramo);
+    for (int j = 0; j < tramo; j++) {
+      salida[i + j] = uniformes[j] < p;
+    }
+  }
+}
+
+uint32_t rng_contador(uint64_t semilla, uint64_t flujo, uint64_t contador) {
+  uint32_t clave[2] = {(uint32_t)semilla, (uint32_t)(semilla >> 32)};
+  uint32_t entrada[4] = {(uint32_t)contador, (uint32_t)(contador >> 32),
+                         (uint32_t)flujo, (uint32_t)(flujo >> 32)};
+  uint32_t salida[4];
+  philox4x32_10(entrada, clave, salida);
+  return salida[0];
+}
+
+float rng_uniforme_contador(uint64_t semilla, uint64_t flujo, uint64_t contador) {
+  return (rng_contador(semilla, flujo, contador) >> 8) * RNG_ESCALA_24;
+}
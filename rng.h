@@ -0,0 +1,102 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// ============================================================
+// RNG - Generador pseudoaleatorio basado en contador (Philox4x32-10)
+// Cada flujo se identifica por (semilla, flujo): dos flujos distintos
+// nunca comparten estado, de modo que agentes, hilos y etapas pueden
+// generar en cualquier orden y la corrida sigue siendo reproducible.
+// Complejidad: O(1) por número generado
+// ============================================================
+
+// Categorías de flujo: el identificador de flujo combina la categoría
+// (16 bits altos) con un índice (agente, cepa, hilo, bloque...)
+typedef enum {
+  RNG_FLUJO_CEPAS = 1,
+  RNG_FLUJO_GRAFO,
+  RNG_FLUJO_POBLACION,
+  RNG_FLUJO_PACIENTES_CERO,
+  RNG_FLUJO_EXPOSICION,
+  RNG_FLUJO_CONTACTOS,
+  RNG_FLUJO_PROPAGACION
+} CategoriaFlujo;
+
+#define RNG_FLUJO(categoria, indice) \
+  (((uint64_t)(categoria) << 48) | ((uint64_t)(indice) & 0xFFFFFFFFFFFFULL))
+
+// Estado de un flujo: clave (semilla) + contador de 128 bits
+// contador[0..1] = número de bloque, contador[2..3] = identificador de flujo
+typedef struct {
+  uint32_t clave[2];
+  uint32_t contador[4];
+  uint32_t bloque[4]; // Última salida de Philox
+  int usados;         // Palabras de bloque ya consumidas (4 = agotado)
+} RngFlujo;
+
+/**
+ * Crea un flujo independiente identificado por (semilla, flujo)
+ * Complejidad: O(1)
+ */
+RngFlujo rng_flujo_crear(uint64_t semilla, uint64_t flujo);
+
+/**
+ * Siguiente entero de 32 bits del flujo
+ * Complejidad: O(1) (un bloque Philox cada 4 llamadas)
+ */
+uint32_t rng_siguiente(RngFlujo *rng);
+
+/**
+ * Uniforme en [0, 1) con 24 bits de precisión
+ * Complejidad: O(1)
+ */
+float rng_uniforme(RngFlujo *rng);
+
+/**
+ * Uniforme en [min, max)
+ * Complejidad: O(1)
+ */
+float rng_rango_float(RngFlujo *rng, float min, float max);
+
+/**
+ * Entero uniforme en [0, n)
+ * Complejidad: O(1)
+ */
+int rng_entero(RngFlujo *rng, int n);
+
+/**
+ * Ensayo de Bernoulli con probabilidad p
+ * Complejidad: O(1)
+ */
+bool rng_bernoulli(RngFlujo *rng, float p);
+
+/**
+ * Genera n uniformes en [0, 1) de una vez
+ * Los bloques completos se calculan en carriles independientes
+ * (sin dependencias entre iteraciones) para que el compilador vectorice
+ * Complejidad: O(n)
+ */
+void rng_uniformes_lote(RngFlujo *rng, float *salida, int n);
+
+/**
+ * Genera n ensayos de Bernoulli con probabilidad p (1 = éxito)
+ * Complejidad: O(n)
+ */
+void rng_bernoulli_lote(RngFlujo *rng, float p, unsigned char *salida, int n);
+
+/**
+ * Sorteo sin estado: palabra de 32 bits para (semilla, flujo, contador)
+ * Útil cuando cada elemento (p.ej. cada arista) debe tener su propio valor
+ * Complejidad: O(1)
+ */
+uint32_t rng_contador(uint64_t semilla, uint64_t flujo, uint64_t contador);
+
+/**
+ * Igual que rng_contador pero como uniforme en [0, 1)
+ * Complejidad: O(1)
+ */
+float rng_uniforme_contador(uint64_t semilla, uint64_t flujo, uint64_t contador);
+
+#endif // RNG_H
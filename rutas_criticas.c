@@ -1,4 +1,8 @@
 #include "rutas_criticas.h"
+#include "memoria.h"
+#include "instrumentacion.h"
+#include "pool_tareas.h"
+#include "traza.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
@@ -25,22 +29,46 @@ typedef struct {
   int distancia_saltos;  // Para desempates
 } NodoHeap;
 
-// Comparador para Max-Heap (máxima probabilidad primero)
-static int comparar_max_heap(const void *a, const void *b) {
-  const NodoHeap *nodo_a = (const NodoHeap *)a;
-  const NodoHeap *nodo_b = (const NodoHeap *)b;
-  
-  // Max-Heap: mayor probabilidad va primero
-  if (nodo_a->probabilidad_acumulada > nodo_b->probabilidad_acumulada) return -1;
-  if (nodo_a->probabilidad_acumulada < nodo_b->probabilidad_acumulada) return 1;
-  
-  // Desempate: menos saltos es mejor
-  if (nodo_a->distancia_saltos < nodo_b->distancia_saltos) return -1;
-  if (nodo_a->distancia_saltos > nodo_b->distancia_saltos) return 1;
-  
-  return 0;
+// Prioridad del Max-Heap: mayor probabilidad primero, menos saltos en empate
+static bool antes_que(const NodoHeap *a, const NodoHeap *b) {
+  if (a->probabilidad_acumulada != b->probabilidad_acumulada) {
+    return a->probabilidad_acumulada > b->probabilidad_acumulada;
+  }
+  return a->distancia_saltos < b->distancia_saltos;
 }
 
+// Max-Heap binario sobre un array: O(log n) por inserción y extracción
+static void heap_nodos_insertar(NodoHeap *heap, int *tamano, NodoHeap nodo) {
+  INSTR_CONTAR(CONTADOR_HEAP_INSERCIONES, 1);
+  int actual = (*tamano)++;
+  while (actual > 0) {
+    int padre = (actual - 1) / 2;
+    if (!antes_que(&nodo, &heap[padre])) break;
+    heap[actual] = heap[padre];
+    actual = padre;
+  }
+  heap[actual] = nodo;
+}
+
+static NodoHeap heap_nodos_extraer(NodoHeap *heap, int *tamano) {
+  INSTR_CONTAR(CONTADOR_HEAP_EXTRACCIONES, 1);
+  NodoHeap raiz = heap[0];
+  NodoHeap ultimo = heap[--(*tamano)];
+  int n = *tamano;
+  int actual = 0;
+  
+  while (2 * actual + 1 < n) {
+    int hijo = 2 * actual + 1;
+    if (hijo + 1 < n && antes_que(&heap[hijo + 1], &heap[hijo])) hijo++;
+    if (!antes_que(&heap[hijo], &ultimo)) break;
+    heap[actual] = heap[hijo];
+    actual = hijo;
+  }
+  if (n > 0) heap[actual] = ultimo;
+  return raiz;
+}
+
+
 // ============================================================
 // Dijkstra modificado para máxima probabilidad de una ruta
 // Complejidad: O((n + m) log n) con Max-Heap
@@ -49,11 +77,12 @@ static int comparar_max_heap(const void *a, const void *b) {
 // de infección sea MÁXIMA (no mínima como en Dijkstra clásico)
 // ============================================================
 RutaCritica dijkstra_maxima_probabilidad(
-  Grafo *grafo_territorios,
+  GrafoCSR *grafo_territorios,
   int territorio_origen,
   int territorio_destino,
   Cepa *cepas,
-  int num_cepas
+  int num_cepas,
+  Arena *arena
 ) {
   RutaCritica ruta;
   ruta.ruta = NULL;
@@ -67,11 +96,14 @@ RutaCritica dijkstra_maxima_probabilidad(
   }
   
   int n = grafo_territorios->num_nodos;
+  uint64_t traza = traza_inicio();
   
-  // Arrays para Dijkstra
-  float *max_probabilidad = (float *)malloc(n * sizeof(float));
-  int *padre = (int *)malloc(n * sizeof(int));
-  bool *visitado = (bool *)malloc(n * sizeof(bool));
+  // Arrays para Dijkstra (se devuelven a la arena al terminar la consulta)
+  Arena *temporal = arena ? arena : arena_crear(0);
+  MarcaArena marca = arena_marca(temporal);
+  float *max_probabilidad = (float *)arena_reservar(temporal, n * sizeof(float));
+  int *padre = (int *)arena_reservar(temporal, n * sizeof(int));
+  bool *visitado = (bool *)arena_reservar(temporal, n * sizeof(bool));
   
   // Inicialización
   for (int i = 0; i < n; i++) {
@@ -82,23 +114,29 @@ RutaCritica dijkstra_maxima_probabilidad(
   
   max_probabilidad[territorio_origen] = 1.0f;  // Probabilidad inicial = 1 (100%)
   
-  // Cola de prioridades (Max-Heap) - simulado con array
-  NodoHeap *heap = (NodoHeap *)malloc(n * sizeof(NodoHeap));
-  int heap_size = 1;
-  heap[0].territorio_id = territorio_origen;
-  heap[0].probabilidad_acumulada = 1.0f;
-  heap[0].distancia_saltos = 0;
+  // Usar beta promedio de todas las cepas para consistencia
+  // (constante durante toda la búsqueda: se calcula una sola vez)
+  float beta_promedio = 0.5f;
+  if (num_cepas > 0) {
+    float suma_beta = 0.0f;
+    for (int c = 0; c < num_cepas; c++) {
+      suma_beta += cepas[c].beta;
+    }
+    beta_promedio = suma_beta / num_cepas;
+  }
+  
+  // Cola de prioridades (Max-Heap binario) con borrado perezoso:
+  // cada arista relajada inserta a lo sumo una entrada -> capacidad m + 1
+  NodoHeap *heap = (NodoHeap *)arena_reservar(
+      temporal, (grafo_territorios->num_aristas + 1) * sizeof(NodoHeap));
+  int heap_size = 0;
+  NodoHeap inicial = { territorio_origen, 1.0f, 0 };
+  heap_nodos_insertar(heap, &heap_size, inicial);
   
   // Procesar nodos del heap
   while (heap_size > 0) {
-    // Extraer máximo (primer elemento del Max-Heap ordenado)
-    NodoHeap nodo_actual = heap[0];
-    
-    // Reorganizar heap (simulación - qsort)
-    if (heap_size > 1) {
-      heap[0] = heap[heap_size - 1];
-    }
-    heap_size--;
+    // Extraer máximo - O(log n)
+    NodoHeap nodo_actual = heap_nodos_extraer(heap, &heap_size);
     
     int territorio_actual = nodo_actual.territorio_id;
     
@@ -113,25 +151,16 @@ RutaCritica dijkstra_maxima_probabilidad(
       break;
     }
     
-    // Explorar vecinos
-    NodoAdyacencia *vecino = grafo_territorios->listas[territorio_actual];
-    while (vecino != NULL) {
-      int territorio_vecino = vecino->destino_id;
+    // Explorar vecinos (fila contigua del grafo CSR)
+    int fin_aristas = grafo_territorios->inicio[territorio_actual + 1];
+    INSTR_CONTAR(CONTADOR_ARISTAS_RELAJADAS, fin_aristas - grafo_territorios->inicio[territorio_actual]);
+    for (int e = grafo_territorios->inicio[territorio_actual]; e < fin_aristas; e++) {
+      int territorio_vecino = grafo_territorios->destino_id[e];
       
       if (!visitado[territorio_vecino]) {
         // Calcular probabilidad de transmisión (basada en distancia/peso)
         // Fórmula: prob = 1 / (1 + peso/20) - mayor peso = menor probabilidad
-        float prob_transmision = 1.0f / (1.0f + vecino->peso / 20.0f);
-        
-        // Usar beta promedio de todas las cepas para consistencia
-        float beta_promedio = 0.5f;
-        if (num_cepas > 0) {
-          float suma_beta = 0.0f;
-          for (int c = 0; c < num_cepas; c++) {
-            suma_beta += cepas[c].beta;
-          }
-          beta_promedio = suma_beta / num_cepas;
-        }
+        float prob_transmision = 1.0f / (1.0f + grafo_territorios->peso[e] / 20.0f);
         
         prob_transmision *= beta_promedio;
         float nueva_probabilidad = max_probabilidad[territorio_actual] * prob_transmision;
@@ -141,20 +170,12 @@ RutaCritica dijkstra_maxima_probabilidad(
           max_probabilidad[territorio_vecino] = nueva_probabilidad;
           padre[territorio_vecino] = territorio_actual;
           
-          // Añadir a heap si no está lleno
-          if (heap_size < n) {
-            heap[heap_size].territorio_id = territorio_vecino;
-            heap[heap_size].probabilidad_acumulada = nueva_probabilidad;
-            heap[heap_size].distancia_saltos = nodo_actual.distancia_saltos + 1;
-            heap_size++;
-            
-            // Ordenar heap (simple - para Max-Heap)
-            qsort(heap, heap_size, sizeof(NodoHeap), comparar_max_heap);
-          }
+          // Añadir al heap - O(log n)
+          NodoHeap vecino = { territorio_vecino, nueva_probabilidad,
+                              nodo_actual.distancia_saltos + 1 };
+          heap_nodos_insertar(heap, &heap_size, vecino);
         }
       }
-      
-      vecino = vecino->siguiente;
     }
   }
   
@@ -170,7 +191,7 @@ RutaCritica dijkstra_maxima_probabilidad(
       actual = padre[actual];
     }
     
-    ruta.ruta = (int *)malloc(nodos_ruta * sizeof(int));
+    ruta.ruta = (int *)bio_malloc(nodos_ruta * sizeof(int));
     ruta.longitud_ruta = nodos_ruta;
     
     // Llenar la ruta (en orden inverso)
@@ -181,12 +202,11 @@ RutaCritica dijkstra_maxima_probabilidad(
     }
   }
   
-  // Liberar memoria
-  free(max_probabilidad);
-  free(padre);
-  free(visitado);
-  free(heap);
+  // Liberar memoria temporal (la ruta resultado es del llamador)
+  arena_restaurar(temporal, marca);
+  if (!arena) arena_liberar(temporal);
   
+  traza_fin("dijkstra", "rutas", traza, territorio_destino);
   return ruta;
 }
 
@@ -194,43 +214,78 @@ RutaCritica dijkstra_maxima_probabilidad(
 // Dijkstra múltiple: desde un origen a todos los destinos
 // Complejidad: O((n + m) log n)
 // ============================================================
+
+// Destinos por tarea del pool: suficientes para amortizar la arena
+#define GRANO_DIJKSTRA 32
+
+typedef struct {
+  GrafoCSR *grafo;
+  int origen;
+  Cepa *cepas;
+  int num_cepas;
+  RutaCritica *rutas;
+} LoteDijkstra;
+
+static void calcular_rutas(const LoteDijkstra *lote, int desde, int hasta, Arena *arena) {
+  for (int destino = desde; destino < hasta; destino++) {
+    if (destino != lote->origen) {
+      lote->rutas[destino] = dijkstra_maxima_probabilidad(
+        lote->grafo,
+        lote->origen,
+        destino,
+        lote->cepas,
+        lote->num_cepas,
+        arena
+      );
+    } else {
+      // El origen a sí mismo tiene probabilidad 1 y ruta vacía
+      lote->rutas[destino].ruta = NULL;
+      lote->rutas[destino].longitud_ruta = 0;
+      lote->rutas[destino].probabilidad_total = 1.0f;
+    }
+  }
+}
+
+// Tarea del pool: cada trozo de destinos usa su propia arena
+static void calcular_rutas_trozo(void *contexto, int desde, int hasta) {
+  Arena *arena = arena_crear(0);
+  calcular_rutas((const LoteDijkstra *)contexto, desde, hasta, arena);
+  arena_liberar(arena);
+}
+
 RutaCritica* dijkstra_multiple(
-  Grafo *grafo_territorios,
+  GrafoCSR *grafo_territorios,
   int territorio_origen,
   Cepa *cepas,
   int num_cepas,
-  int num_territorios
+  int num_territorios,
+  Arena *arena
 ) {
-  RutaCritica *rutas = (RutaCritica *)malloc(num_territorios * sizeof(RutaCritica));
+  RutaCritica *rutas = (RutaCritica *)bio_malloc(num_territorios * sizeof(RutaCritica));
   
   if (!rutas || !grafo_territorios) {
     return rutas;
   }
   
-  // Ejecutar Dijkstra desde origen hacia cada destino
-  for (int destino = 0; destino < num_territorios; destino++) {
-    if (destino != territorio_origen) {
-      rutas[destino] = dijkstra_maxima_probabilidad(
-        grafo_territorios,
-        territorio_origen,
-        destino,
-        cepas,
-        num_cepas
-      );
-    } else {
-      // El origen a sí mismo tiene probabilidad 1 y ruta vacía
-      rutas[destino].ruta = NULL;
-      rutas[destino].longitud_ruta = 0;
-      rutas[destino].probabilidad_total = 1.0f;
-    }
+  LoteDijkstra lote = { grafo_territorios, territorio_origen, cepas, num_cepas, rutas };
+  uint64_t traza = traza_inicio();
+  
+  // Las consultas son independientes: con varios destinos por hilo se
+  // reparten en el pool; si no, todas reutilizan los buffers de la arena
+  PoolTareas *pool = pool_tareas_global();
+  if (num_territorios >= 2 * GRANO_DIJKSTRA && pool_tareas_hilos(pool) > 1) {
+    pool_tareas_para(pool, 0, num_territorios, GRANO_DIJKSTRA, calcular_rutas_trozo, &lote);
+  } else {
+    calcular_rutas(&lote, 0, num_territorios, arena);
   }
   
+  traza_fin("dijkstra_multiple", "rutas", traza, territorio_origen);
   return rutas;
 }
 
 void ruta_critica_liberar(RutaCritica *ruta) {
   if (ruta && ruta->ruta) {
-    free(ruta->ruta);
+    bio_free(ruta->ruta);
     ruta->ruta = NULL;
     ruta->longitud_ruta = 0;
   }
@@ -241,39 +296,43 @@ void ruta_critica_liberar(RutaCritica *ruta) {
 // ============================================================
 
 void test_rutas_criticas(
-  Grafo *grafo_territorios,
+  GrafoCSR *grafo_territorios,
   int num_territorios,
   Cepa *cepas,
-  int num_cepas
+  int num_cepas,
+  FILE *salida
 ) {
   if (!grafo_territorios || num_territorios <= 0) {
-    printf("ERROR: Grafo o territorios inválidos\n");
+    fprintf(salida, "ERROR: Grafo o territorios inválidos\n");
     return;
   }
   
-  printf("\n========== SUBPROBLEMA 5: RUTAS CRITICAS ==========\n");
-  printf("Territorios: %d\n", num_territorios);
-  printf("Cepas disponibles: %d\n", num_cepas);
-  printf("Algoritmo: Dijkstra modificado para maxima probabilidad\n\n");
+  fprintf(salida, "\n========== SUBPROBLEMA 5: RUTAS CRITICAS ==========\n");
+  fprintf(salida, "Territorios: %d\n", num_territorios);
+  fprintf(salida, "Cepas disponibles: %d\n", num_cepas);
+  fprintf(salida, "Algoritmo: Dijkstra modificado para maxima probabilidad\n\n");
+  
+  // Arena de la etapa: buffers de todas las consultas
+  Arena *arena = arena_crear(0);
   
   // Prueba 1: Ruta de territorio 0 a territorio 5
   if (num_territorios > 5) {
-    printf("--- PRUEBA 1: Ruta de Territorio 0 -> Territorio 5 ---\n");
+    fprintf(salida, "--- PRUEBA 1: Ruta de Territorio 0 -> Territorio 5 ---\n");
     RutaCritica ruta_1 = dijkstra_maxima_probabilidad(
-      grafo_territorios, 0, 5, cepas, num_cepas
+      grafo_territorios, 0, 5, cepas, num_cepas, arena
     );
     
-    printf("Probabilidad de infeccion: %.4f (%.2f%%)\n", 
-           ruta_1.probabilidad_total, ruta_1.probabilidad_total * 100);
-    printf("Saltos en la ruta: %d\n", ruta_1.longitud_ruta);
+    fprintf(salida, "Probabilidad de infeccion: %.4f (%.2f%%)\n", 
+            ruta_1.probabilidad_total, ruta_1.probabilidad_total * 100);
+    fprintf(salida, "Saltos en la ruta: %d\n", ruta_1.longitud_ruta);
     
     if (ruta_1.ruta && ruta_1.longitud_ruta > 0) {
-      printf("Ruta: ");
+      fprintf(salida, "Ruta: ");
       for (int i = 0; i < ruta_1.longitud_ruta; i++) {
-        printf("T%d", ruta_1.ruta[i]);
-        if (i < ruta_1.longitud_ruta - 1) printf(" -> ");
+        fprintf(salida, "T%d", ruta_1.ruta[i]);
+        if (i < ruta_1.longitud_ruta - 1) fprintf(salida, " -> ");
       }
-      printf("\n");
+      fprintf(salida, "\n");
     }
     
     ruta_critica_liberar(&ruta_1);
@@ -281,33 +340,33 @@ void test_rutas_criticas(
   
   // Prueba 2: Ruta de territorio 3 a territorio 15
   if (num_territorios > 15) {
-    printf("\n--- PRUEBA 2: Ruta de Territorio 3 -> Territorio 15 ---\n");
+    fprintf(salida, "\n--- PRUEBA 2: Ruta de Territorio 3 -> Territorio 15 ---\n");
     RutaCritica ruta_2 = dijkstra_maxima_probabilidad(
-      grafo_territorios, 3, 15, cepas, num_cepas
+      grafo_territorios, 3, 15, cepas, num_cepas, arena
     );
     
-    printf("Probabilidad de infeccion: %.4f (%.2f%%)\n", 
-           ruta_2.probabilidad_total, ruta_2.probabilidad_total * 100);
-    printf("Saltos en la ruta: %d\n", ruta_2.longitud_ruta);
+    fprintf(salida, "Probabilidad de infeccion: %.4f (%.2f%%)\n", 
+            ruta_2.probabilidad_total, ruta_2.probabilidad_total * 100);
+    fprintf(salida, "Saltos en la ruta: %d\n", ruta_2.longitud_ruta);
     
     if (ruta_2.ruta && ruta_2.longitud_ruta > 0) {
-      printf("Ruta: ");
+      fprintf(salida, "Ruta: ");
       for (int i = 0; i < ruta_2.longitud_ruta; i++) {
-        printf("T%d", ruta_2.ruta[i]);
-        if (i < ruta_2.longitud_ruta - 1) printf(" -> ");
+        fprintf(salida, "T%d", ruta_2.ruta[i]);
+        if (i < ruta_2.longitud_ruta - 1) fprintf(salida, " -> ");
       }
-      printf("\n");
+      fprintf(salida, "\n");
     }
     
     ruta_critica_liberar(&ruta_2);
   }
   
   // Prueba 3: Multiples rutas desde territorio 0
-  printf("\n--- PRUEBA 3: Rutas desde Territorio 0 hacia todos ---\n");
-  printf("(Mostrando top 5 destinos con maxima probabilidad)\n\n");
+  fprintf(salida, "\n--- PRUEBA 3: Rutas desde Territorio 0 hacia todos ---\n");
+  fprintf(salida, "(Mostrando top 5 destinos con maxima probabilidad)\n\n");
   
   RutaCritica *rutas_multiples = dijkstra_multiple(
-    grafo_territorios, 0, cepas, num_cepas, num_territorios
+    grafo_territorios, 0, cepas, num_cepas, num_territorios, arena
   );
   
   // Buscar los 5 destinos con máxima probabilidad
@@ -316,7 +375,7 @@ void test_rutas_criticas(
     float probabilidad;
   } ResultadoOrdenado;
   
-  ResultadoOrdenado *resultados = (ResultadoOrdenado *)malloc(num_territorios * sizeof(ResultadoOrdenado));
+  ResultadoOrdenado *resultados = (ResultadoOrdenado *)bio_malloc(num_territorios * sizeof(ResultadoOrdenado));
   
   for (int i = 0; i < num_territorios; i++) {
     resultados[i].territorio = i;
@@ -335,21 +394,21 @@ void test_rutas_criticas(
   }
   
   // Mostrar top 5
-  printf("Territorio | Probabilidad | Saltos\n");
-  printf("-----------+--------------+-------\n");
+  fprintf(salida, "Territorio | Probabilidad | Saltos\n");
+  fprintf(salida, "-----------+--------------+-------\n");
   
   int mostrar = (num_territorios < 6) ? num_territorios : 6;
   for (int i = 0; i < mostrar; i++) {
     if (resultados[i].territorio != 0) {  // Saltar origen
-      printf("T%-9d | %12.4f | %6d\n",
-             resultados[i].territorio,
-             resultados[i].probabilidad,
-             rutas_multiples[resultados[i].territorio].longitud_ruta);
+      fprintf(salida, "T%-9d | %12.4f | %6d\n",
+              resultados[i].territorio,
+              resultados[i].probabilidad,
+              rutas_multiples[resultados[i].territorio].longitud_ruta);
     }
   }
   
   // Estadísticas generales
-  printf("\n--- ESTADISTICAS GENERALES ---\n");
+  fprintf(salida, "\n--- ESTADISTICAS GENERALES ---\n");
   float probabilidad_promedio = 0.0f;
   int total_rutas_validas = 0;
   
@@ -364,21 +423,22 @@ void test_rutas_criticas(
     probabilidad_promedio /= total_rutas_validas;
   }
   
-  printf("Rutas alcanzables desde T0: %d/%d (%.1f%%)\n",
-         total_rutas_validas, num_territorios - 1,
-         (float)total_rutas_validas / (num_territorios - 1) * 100);
-  printf("Probabilidad promedio: %.4f (%.2f%%)\n",
-         probabilidad_promedio, probabilidad_promedio * 100);
+  fprintf(salida, "Rutas alcanzables desde T0: %d/%d (%.1f%%)\n",
+          total_rutas_validas, num_territorios - 1,
+          (float)total_rutas_validas / (num_territorios - 1) * 100);
+  fprintf(salida, "Probabilidad promedio: %.4f (%.2f%%)\n",
+          probabilidad_promedio, probabilidad_promedio * 100);
   
-  printf("\nComplejidad: O((n + m) log n) donde n=%d territorios\n", num_territorios);
-  printf("Algoritmo: Dijkstra modificado con Max-Heap\n");
+  fprintf(salida, "\nComplejidad: O((n + m) log n) donde n=%d territorios\n", num_territorios);
+  fprintf(salida, "Algoritmo: Dijkstra modificado con Max-Heap\n");
   
-  printf("\n===== FIN PRUEBAS SUBPROBLEMA 5 =====\n\n");
+  fprintf(salida, "\n===== FIN PRUEBAS SUBPROBLEMA 5 =====\n\n");
   
   // Liberar memoria
   for (int i = 0; i < num_territorios; i++) {
     ruta_critica_liberar(&rutas_multiples[i]);
   }
-  free(rutas_multiples);
-  free(resultados);
+  bio_free(rutas_multiples);
+  bio_free(resultados);
+  arena_liberar(arena);
 }
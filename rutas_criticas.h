@@ -2,6 +2,7 @@
 #define RUTAS_CRITICAS_H
 
 #include "estructuras.h"
+#include "arena.h"
 
 // ============================================================
 // SUBPROBLEMA 5: Rutas Críticas
@@ -22,26 +23,31 @@ typedef struct {
  * Complejidad: O((n + m) log n) donde n = territorios, m = conexiones
  * territorio_origen: ID del territorio de inicio
  * territorio_destino: ID del territorio destino
+ * arena: buffers temporales de la consulta (NULL = arena propia)
  * Retorna: RutaCritica con la ruta y probabilidad acumulada
  */
 RutaCritica dijkstra_maxima_probabilidad(
-  Grafo *grafo_territorios,
+  GrafoCSR *grafo_territorios,
   int territorio_origen,
   int territorio_destino,
   Cepa *cepas,
-  int num_cepas
+  int num_cepas,
+  Arena *arena
 );
 
 /**
  * Encuentra todas las rutas críticas desde un territorio hacia todos los demás
+ * Con el pool global de varios hilos los destinos se reparten en tareas
+ * (cada una con su arena); si no, todas las consultas usan 'arena'
  * Complejidad: O((n + m) log n)
  */
 RutaCritica* dijkstra_multiple(
-  Grafo *grafo_territorios,
+  GrafoCSR *grafo_territorios,
   int territorio_origen,
   Cepa *cepas,
   int num_cepas,
-  int num_territorios
+  int num_territorios,
+  Arena *arena
 );
 
 /**
@@ -53,12 +59,14 @@ void ruta_critica_liberar(RutaCritica *ruta);
 /**
  * Función de prueba para el algoritmo Dijkstra de rutas críticas
  * Encuentra múltiples rutas de máxima probabilidad
+ * El reporte se escribe en salida (stdout o el buffer de la etapa)
  */
 void test_rutas_criticas(
-  Grafo *grafo_territorios,
+  GrafoCSR *grafo_territorios,
   int num_territorios,
   Cepa *cepas,
-  int num_cepas
+  int num_cepas,
+  FILE *salida
 );
 
 #endif // RUTAS_CRITICAS_H
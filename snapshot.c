@@ -0,0 +1,291 @@
+#include "snapshot.h"
+#include "memoria.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================
+// IMPLEMENTACION SNAPSHOT
+// Disposición del archivo:
+//   [0]        CabeceraSnapshot + SeccionSnapshot[num_secciones]
+//   [k * 4096] sección 0, sección 1, ... (cada una alineada)
+// Todos los enteros se guardan en el orden de bytes nativo; la marca
+// orden_bytes permite rechazar archivos de otra arquitectura.
+// ============================================================
+
+static const char MAGIA[8] = { 'B', 'I', 'O', 'S', 'I', 'M', 'S', 'N' };
+#define MARCA_ORDEN_BYTES 0x01020304u
+
+typedef enum {
+  SECCION_ID = 1,
+  SECCION_ESTADO,
+  SECCION_RIESGO,
+  SECCION_TIEMPO_INFECCION,
+  SECCION_TERRITORIO_ID,
+  SECCION_NOMBRE,           // Opcional: ausente en poblaciones sintéticas
+  SECCION_INDICE_INICIO,
+  SECCION_INDICE_MIEMBROS,
+  SECCION_GRAFO_INICIO,
+  SECCION_GRAFO_DESTINO,
+  SECCION_GRAFO_PESO,
+  SECCION_CEPAS,
+  SECCION_TERRITORIOS,
+  MAX_SECCIONES
+} TipoSeccion;
+
+typedef struct {
+  char magia[8];
+  uint32_t version;
+  uint32_t orden_bytes;
+  uint32_t alineacion;
+  uint32_t num_secciones;
+  uint64_t semilla;
+  int32_t num_individuos;
+  int32_t num_territorios;
+  int32_t num_cepas;
+  int32_t num_aristas;
+} CabeceraSnapshot;
+
+typedef struct {
+  uint32_t tipo;
+  uint32_t tamano_elemento;
+  uint64_t desplazamiento;
+  uint64_t num_elementos;
+} SeccionSnapshot;
+
+// Sección pendiente de escritura
+typedef struct {
+  SeccionSnapshot descriptor;
+  const void *datos;
+} SeccionSalida;
+
+static uint64_t alinear(uint64_t valor) {
+  return (valor + SNAPSHOT_ALINEACION - 1) / SNAPSHOT_ALINEACION * SNAPSHOT_ALINEACION;
+}
+
+static void agregar_seccion(SeccionSalida *secciones, int *num_secciones, TipoSeccion tipo,
+                            const void *datos, size_t tamano_elemento, size_t num_elementos) {
+  SeccionSalida *s = &secciones[(*num_secciones)++];
+  s->descriptor.tipo = (uint32_t)tipo;
+  s->descriptor.tamano_elemento = (uint32_t)tamano_elemento;
+  s->descriptor.desplazamiento = 0;
+  s->descriptor.num_elementos = (uint64_t)num_elementos;
+  s->datos = datos;
+}
+
+static bool escribir_relleno(FILE *archivo, uint64_t desde, uint64_t hasta) {
+  static const char ceros[SNAPSHOT_ALINEACION] = { 0 };
+  while (desde < hasta) {
+    size_t bloque = (size_t)(hasta - desde < sizeof(ceros) ? hasta - desde : sizeof(ceros));
+    if (fwrite(ceros, 1, bloque, archivo) != bloque) return false;
+    desde += bloque;
+  }
+  return true;
+}
+
+bool snapshot_guardar(const char *ruta, uint64_t semilla,
+                      const Cepa *cepas, int num_cepas,
+                      const Territorio *territorios, int num_territorios,
+                      const Poblacion *poblacion, const IndiceTerritorios *indice,
+                      const GrafoCSR *grafo) {
+  if (!ruta || !cepas || !territorios || !poblacion || !indice || !grafo) return false;
+
+  size_t n = (size_t)poblacion->num_individuos;
+  size_t t = (size_t)num_territorios;
+  size_t m = (size_t)grafo->num_aristas;
+
+  SeccionSalida secciones[MAX_SECCIONES];
+  int num_secciones = 0;
+  agregar_seccion(secciones, &num_secciones, SECCION_ID, poblacion->id, sizeof(int), n);
+  agregar_seccion(secciones, &num_secciones, SECCION_ESTADO, poblacion->estado, sizeof(EstadoSalud), n);
+  agregar_seccion(secciones, &num_secciones, SECCION_RIESGO, poblacion->riesgo, sizeof(int), n);
+  agregar_seccion(secciones, &num_secciones, SECCION_TIEMPO_INFECCION, poblacion->tiempo_infeccion, sizeof(int), n);
+  agregar_seccion(secciones, &num_secciones, SECCION_TERRITORIO_ID, poblacion->territorio_id, sizeof(int), n);
+  if (poblacion->nombre) {
+    agregar_seccion(secciones, &num_secciones, SECCION_NOMBRE, poblacion->nombre, MAX_NOMBRE, n);
+  }
+  agregar_seccion(secciones, &num_secciones, SECCION_INDICE_INICIO, indice->inicio, sizeof(int), t + 1);
+  agregar_seccion(secciones, &num_secciones, SECCION_INDICE_MIEMBROS, indice->miembros, sizeof(int), n);
+  agregar_seccion(secciones, &num_secciones, SECCION_GRAFO_INICIO, grafo->inicio, sizeof(int), t + 1);
+  agregar_seccion(secciones, &num_secciones, SECCION_GRAFO_DESTINO, grafo->destino_id, sizeof(int), m);
+  agregar_seccion(secciones, &num_secciones, SECCION_GRAFO_PESO, grafo->peso, sizeof(float), m);
+  agregar_seccion(secciones, &num_secciones, SECCION_CEPAS, cepas, sizeof(Cepa), (size_t)num_cepas);
+  agregar_seccion(secciones, &num_secciones, SECCION_TERRITORIOS, territorios, sizeof(Territorio), t);
+
+  // Paso 1: calcular desplazamientos alineados - O(secciones)
+  uint64_t desplazamiento = alinear(sizeof(CabeceraSnapshot) + num_secciones * sizeof(SeccionSnapshot));
+  for (int s = 0; s < num_secciones; s++) {
+    secciones[s].descriptor.desplazamiento = desplazamiento;
+    desplazamiento = alinear(desplazamiento + secciones[s].descriptor.tamano_elemento *
+                                              secciones[s].descriptor.num_elementos);
+  }
+
+  CabeceraSnapshot cabecera;
+  memset(&cabecera, 0, sizeof(cabecera));
+  memcpy(cabecera.magia, MAGIA, sizeof(MAGIA));
+  cabecera.version = SNAPSHOT_VERSION;
+  cabecera.orden_bytes = MARCA_ORDEN_BYTES;
+  cabecera.alineacion = SNAPSHOT_ALINEACION;
+  cabecera.num_secciones = (uint32_t)num_secciones;
+  cabecera.semilla = semilla;
+  cabecera.num_individuos = poblacion->num_individuos;
+  cabecera.num_territorios = num_territorios;
+  cabecera.num_cepas = num_cepas;
+  cabecera.num_aristas = grafo->num_aristas;
+
+  FILE *archivo = fopen(ruta, "wb");
+  if (!archivo) return false;
+
+  // Paso 2: cabecera, tabla y secciones en orden - O(bytes)
+  bool ok = fwrite(&cabecera, sizeof(cabecera), 1, archivo) == 1;
+  uint64_t escrito = sizeof(cabecera);
+  for (int s = 0; s < num_secciones && ok; s++) {
+    ok = fwrite(&secciones[s].descriptor, sizeof(SeccionSnapshot), 1, archivo) == 1;
+    escrito += sizeof(SeccionSnapshot);
+  }
+
+  for (int s = 0; s < num_secciones && ok; s++) {
+    const SeccionSnapshot *d = &secciones[s].descriptor;
+    size_t bytes = (size_t)(d->tamano_elemento * d->num_elementos);
+    ok = escribir_relleno(archivo, escrito, d->desplazamiento);
+    if (ok && bytes > 0) ok = fwrite(secciones[s].datos, 1, bytes, archivo) == bytes;
+    escrito = d->desplazamiento + bytes;
+  }
+
+  // Relleno final: el archivo termina en un límite de página
+  if (ok) ok = escribir_relleno(archivo, escrito, alinear(escrito));
+
+  if (fclose(archivo) != 0) ok = false;
+  if (!ok) remove(ruta);
+  return ok;
+}
+
+// Busca una sección y valida tamaño de elemento, cantidad y límites
+static void* seccion_datos(const MapeoArchivo *mapeo, const SeccionSnapshot *tabla, uint32_t num_secciones,
+                           TipoSeccion tipo, size_t tamano_elemento, size_t num_elementos) {
+  for (uint32_t s = 0; s < num_secciones; s++) {
+    const SeccionSnapshot *d = &tabla[s];
+    if (d->tipo != (uint32_t)tipo) continue;
+
+    if (d->tamano_elemento != tamano_elemento || d->num_elementos != num_elementos) return NULL;
+    if (d->desplazamiento % SNAPSHOT_ALINEACION != 0) return NULL;
+    if (d->desplazamiento > mapeo->tamano ||
+        d->tamano_elemento * d->num_elementos > mapeo->tamano - d->desplazamiento) return NULL;
+
+    return (char *)mapeo->datos + d->desplazamiento;
+  }
+  return NULL;
+}
+
+// Comprueba que un array de desplazamientos CSR empiece en 0, no
+// decrezca y termine en total
+static bool desplazamientos_validos(const int *inicio, size_t num_grupos, size_t total) {
+  if (inicio[0] != 0 || (size_t)inicio[num_grupos] != total) return false;
+  for (size_t g = 0; g < num_grupos; g++) {
+    if (inicio[g] > inicio[g + 1]) return false;
+  }
+  return true;
+}
+
+// Comprueba que todos los ids estén en [0, limite)
+static bool ids_en_rango(const int *ids, size_t num_ids, size_t limite) {
+  for (size_t i = 0; i < num_ids; i++) {
+    if (ids[i] < 0 || (size_t)ids[i] >= limite) return false;
+  }
+  return true;
+}
+
+Snapshot* snapshot_cargar(const char *ruta) {
+  Snapshot *snapshot = (Snapshot *)bio_calloc(1, sizeof(Snapshot));
+  if (!snapshot) return NULL;
+
+  if (!mapeo_archivo_abrir(&snapshot->mapeo, ruta, MAPEO_COPIA_PRIVADA)) {
+    bio_free(snapshot);
+    return NULL;
+  }
+
+  const MapeoArchivo *mapeo = &snapshot->mapeo;
+  if (mapeo->tamano < sizeof(CabeceraSnapshot)) {
+    snapshot_cerrar(snapshot);
+    return NULL;
+  }
+
+  // Validar cabecera
+  const CabeceraSnapshot *cabecera = (const CabeceraSnapshot *)mapeo->datos;
+  if (memcmp(cabecera->magia, MAGIA, sizeof(MAGIA)) != 0 ||
+      cabecera->version != SNAPSHOT_VERSION ||
+      cabecera->orden_bytes != MARCA_ORDEN_BYTES ||
+      cabecera->alineacion != SNAPSHOT_ALINEACION ||
+      cabecera->num_secciones > MAX_SECCIONES ||
+      cabecera->num_individuos < 0 || cabecera->num_territorios <= 0 ||
+      cabecera->num_cepas < 0 || cabecera->num_aristas < 0 ||
+      sizeof(CabeceraSnapshot) + cabecera->num_secciones * sizeof(SeccionSnapshot) > mapeo->tamano) {
+    snapshot_cerrar(snapshot);
+    return NULL;
+  }
+
+  const SeccionSnapshot *tabla = (const SeccionSnapshot *)(cabecera + 1);
+  uint32_t k = cabecera->num_secciones;
+  size_t n = (size_t)cabecera->num_individuos;
+  size_t t = (size_t)cabecera->num_territorios;
+  size_t m = (size_t)cabecera->num_aristas;
+
+  snapshot->semilla = cabecera->semilla;
+  snapshot->num_cepas = cabecera->num_cepas;
+  snapshot->num_territorios = cabecera->num_territorios;
+
+  // Apuntar cada estructura a su sección (sin copias)
+  Poblacion *poblacion = &snapshot->poblacion;
+  poblacion->num_individuos = cabecera->num_individuos;
+  poblacion->id = (int *)seccion_datos(mapeo, tabla, k, SECCION_ID, sizeof(int), n);
+  poblacion->estado = (EstadoSalud *)seccion_datos(mapeo, tabla, k, SECCION_ESTADO, sizeof(EstadoSalud), n);
+  poblacion->riesgo = (int *)seccion_datos(mapeo, tabla, k, SECCION_RIESGO, sizeof(int), n);
+  poblacion->tiempo_infeccion = (int *)seccion_datos(mapeo, tabla, k, SECCION_TIEMPO_INFECCION, sizeof(int), n);
+  poblacion->territorio_id = (int *)seccion_datos(mapeo, tabla, k, SECCION_TERRITORIO_ID, sizeof(int), n);
+  poblacion->nombre = (char (*)[MAX_NOMBRE])seccion_datos(mapeo, tabla, k, SECCION_NOMBRE, MAX_NOMBRE, n);
+
+  IndiceTerritorios *indice = &snapshot->indice;
+  indice->num_territorios = cabecera->num_territorios;
+  indice->num_miembros = cabecera->num_individuos;
+  indice->inicio = (int *)seccion_datos(mapeo, tabla, k, SECCION_INDICE_INICIO, sizeof(int), t + 1);
+  indice->miembros = (int *)seccion_datos(mapeo, tabla, k, SECCION_INDICE_MIEMBROS, sizeof(int), n);
+
+  GrafoCSR *grafo = &snapshot->grafo;
+  grafo->num_nodos = cabecera->num_territorios;
+  grafo->num_aristas = cabecera->num_aristas;
+  grafo->inicio = (int *)seccion_datos(mapeo, tabla, k, SECCION_GRAFO_INICIO, sizeof(int), t + 1);
+  grafo->destino_id = (int *)seccion_datos(mapeo, tabla, k, SECCION_GRAFO_DESTINO, sizeof(int), m);
+  grafo->peso = (float *)seccion_datos(mapeo, tabla, k, SECCION_GRAFO_PESO, sizeof(float), m);
+
+  snapshot->cepas = (Cepa *)seccion_datos(mapeo, tabla, k, SECCION_CEPAS, sizeof(Cepa), (size_t)snapshot->num_cepas);
+  snapshot->territorios = (Territorio *)seccion_datos(mapeo, tabla, k, SECCION_TERRITORIOS, sizeof(Territorio), t);
+
+  // Todas las secciones son obligatorias salvo los nombres
+  if (!poblacion->id || !poblacion->estado || !poblacion->riesgo ||
+      !poblacion->tiempo_infeccion || !poblacion->territorio_id ||
+      !indice->inicio || !indice->miembros || !grafo->inicio ||
+      !grafo->destino_id || !grafo->peso || !snapshot->cepas || !snapshot->territorios) {
+    snapshot_cerrar(snapshot);
+    return NULL;
+  }
+
+  // Validar el contenido que se usa como índice: un archivo truncado o
+  // manipulado no debe provocar accesos fuera de los arrays - O(n + m + T)
+  if (!desplazamientos_validos(indice->inicio, t, n) ||
+      !desplazamientos_validos(grafo->inicio, t, m) ||
+      !ids_en_rango(indice->miembros, n, n) ||
+      !ids_en_rango(grafo->destino_id, m, t) ||
+      !ids_en_rango(poblacion->territorio_id, n, t)) {
+    snapshot_cerrar(snapshot);
+    return NULL;
+  }
+
+  return snapshot;
+}
+
+void snapshot_cerrar(Snapshot *snapshot) {
+  if (!snapshot) return;
+
+  mapeo_archivo_cerrar(&snapshot->mapeo);
+  bio_free(snapshot);
+}
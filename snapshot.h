@@ -0,0 +1,63 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "estructuras.h"
+#include "mapeo_archivo.h"
+#include <stdint.h>
+
+// ============================================================
+// SNAPSHOT - Estado completo del mundo en un archivo binario
+// Formato versionado: cabecera + tabla de secciones en la primera
+// página y cada array (columnas de población, índice de territorios,
+// grafo CSR, cepas, territorios) alineado a SNAPSHOT_ALINEACION.
+// La carga mapea el archivo y apunta las estructuras directamente a
+// las secciones: sin parseo ni copias, y con la caché de páginas
+// compartida entre procesos que abren el mismo snapshot.
+// ============================================================
+
+#define SNAPSHOT_VERSION 1
+#define SNAPSHOT_ALINEACION 4096
+
+// Mundo cargado desde un snapshot
+// Las estructuras apuntan dentro del mapeo: NO liberarlas con
+// poblacion_liberar / grafo_csr_liberar / ...; usar snapshot_cerrar
+typedef struct {
+  MapeoArchivo mapeo;
+  uint64_t semilla;
+  int num_cepas;
+  int num_territorios;
+  Cepa *cepas;
+  Territorio *territorios;
+  Poblacion poblacion;
+  IndiceTerritorios indice;
+  GrafoCSR grafo;
+} Snapshot;
+
+/**
+ * Escribe el mundo completo en ruta
+ * Complejidad: O(tamaño del mundo) en escritura secuencial
+ * Retorna: true si el archivo quedó completo
+ */
+bool snapshot_guardar(const char *ruta, uint64_t semilla,
+                      const Cepa *cepas, int num_cepas,
+                      const Territorio *territorios, int num_territorios,
+                      const Poblacion *poblacion, const IndiceTerritorios *indice,
+                      const GrafoCSR *grafo);
+
+/**
+ * Mapea un snapshot (copy-on-write: los cambios quedan en memoria del
+ * proceso y no modifican el archivo)
+ * Se validan cabecera, límites de las secciones y el contenido usado
+ * como índice (desplazamientos CSR e ids de individuos y territorios)
+ * Complejidad: O(n + m + T) lecturas secuenciales sobre el mapeo
+ * Retorna: Snapshot o NULL si el archivo no es válido
+ */
+Snapshot* snapshot_cargar(const char *ruta);
+
+/**
+ * Desmapea el snapshot y libera su descriptor
+ * Complejidad: O(1)
+ */
+void snapshot_cerrar(Snapshot *snapshot);
+
+#endif // SNAPSHOT_H
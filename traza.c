@@ -0,0 +1,181 @@
+#define _POSIX_C_SOURCE 200809L
+#include "traza.h"
+#include "instrumentacion.h"
+#include "memoria.h"
+#include <pthread.h>
+#include <stdio.h>
+
+// ============================================================
+// IMPLEMENTACION TRAZA
+// Un buffer circular por hilo, localizado con una clave pthread. Todos
+// los buffers quedan en una lista global para el volcado; al terminar un
+// hilo el destructor de la clave devuelve su buffer a la lista de libres
+// ============================================================
+
+typedef struct {
+  const char *nombre;
+  const char *categoria;
+  uint64_t inicio_ns;
+  uint64_t duracion_ns;
+  long long argumento;
+} IntervaloTraza;
+
+typedef struct {
+  int hilo;                  // Fila en la línea de tiempo (0 = principal)
+  bool en_uso;
+  uint64_t escritos;         // Total registrado (el buffer guarda los últimos)
+  IntervaloTraza *intervalos;
+} BufferTraza;
+
+static bool activa = false;
+static size_t capacidad_hilo = 0;   // Potencia de 2
+static uint64_t origen_ns = 0;
+
+static pthread_key_t clave_buffer;
+static pthread_mutex_t cerrojo = PTHREAD_MUTEX_INITIALIZER;
+static BufferTraza **buffers = NULL;
+static int num_buffers = 0;
+static int capacidad_buffers = 0;
+
+// Destructor de la clave: el buffer queda libre para el próximo hilo
+static void soltar_buffer(void *dato) {
+  BufferTraza *buffer = (BufferTraza *)dato;
+  pthread_mutex_lock(&cerrojo);
+  buffer->en_uso = false;
+  pthread_mutex_unlock(&cerrojo);
+}
+
+static BufferTraza* buffer_del_hilo(void) {
+  BufferTraza *buffer = (BufferTraza *)pthread_getspecific(clave_buffer);
+  if (buffer) return buffer;
+
+  pthread_mutex_lock(&cerrojo);
+  for (int b = 0; b < num_buffers; b++) {
+    if (!buffers[b]->en_uso) {
+      buffer = buffers[b];
+      break;
+    }
+  }
+  if (!buffer) {
+    if (num_buffers == capacidad_buffers) {
+      int nueva = capacidad_buffers > 0 ? capacidad_buffers * 2 : 8;
+      BufferTraza **ampliados = (BufferTraza **)bio_realloc(buffers, nueva * sizeof(BufferTraza *));
+      if (!ampliados) {
+        pthread_mutex_unlock(&cerrojo);
+        return NULL;
+      }
+      buffers = ampliados;
+      capacidad_buffers = nueva;
+    }
+    buffer = (BufferTraza *)bio_calloc(1, sizeof(BufferTraza));
+    IntervaloTraza *intervalos = (IntervaloTraza *)bio_malloc(capacidad_hilo * sizeof(IntervaloTraza));
+    if (!buffer || !intervalos) {
+      bio_free(buffer);
+      bio_free(intervalos);
+      pthread_mutex_unlock(&cerrojo);
+      return NULL;
+    }
+    buffer->hilo = num_buffers;
+    buffer->intervalos = intervalos;
+    buffers[num_buffers++] = buffer;
+  }
+  buffer->en_uso = true;
+  pthread_mutex_unlock(&cerrojo);
+
+  pthread_setspecific(clave_buffer, buffer);
+  return buffer;
+}
+
+bool traza_iniciar(size_t capacidad) {
+  if (activa) return true;
+  if (capacidad == 0) capacidad = TRAZA_CAPACIDAD_DEFECTO;
+  capacidad_hilo = 1;
+  while (capacidad_hilo < capacidad) capacidad_hilo <<= 1;
+
+  if (pthread_key_create(&clave_buffer, soltar_buffer) != 0) return false;
+  origen_ns = instr_reloj_ns();
+  activa = true;
+
+  // El hilo que inicia la traza ocupa la fila 0
+  if (!buffer_del_hilo()) {
+    traza_cerrar();
+    return false;
+  }
+  return true;
+}
+
+bool traza_activa(void) {
+  return activa;
+}
+
+uint64_t traza_inicio(void) {
+  return activa ? instr_reloj_ns() : 0;
+}
+
+void traza_fin(const char *nombre, const char *categoria, uint64_t inicio, long long argumento) {
+  if (!activa) return;
+  uint64_t fin = instr_reloj_ns();
+  BufferTraza *buffer = buffer_del_hilo();
+  if (!buffer) return;
+
+  IntervaloTraza *intervalo = &buffer->intervalos[buffer->escritos & (capacidad_hilo - 1)];
+  intervalo->nombre = nombre;
+  intervalo->categoria = categoria;
+  intervalo->inicio_ns = inicio;
+  intervalo->duracion_ns = fin - inicio;
+  intervalo->argumento = argumento;
+  buffer->escritos++;
+}
+
+bool traza_escribir(const char *ruta) {
+  if (!activa) return false;
+  FILE *archivo = fopen(ruta, "w");
+  if (!archivo) return false;
+
+  uint64_t descartados = 0;
+  fprintf(archivo, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+  pthread_mutex_lock(&cerrojo);
+  for (int b = 0; b < num_buffers; b++) {
+    const BufferTraza *buffer = buffers[b];
+    fprintf(archivo, "%s{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %d, "
+                     "\"args\": {\"name\": \"%s %d\"}}",
+            b > 0 ? ",\n" : "", buffer->hilo, buffer->hilo == 0 ? "principal" : "hilo",
+            buffer->hilo);
+
+    uint64_t primero = buffer->escritos > capacidad_hilo ? buffer->escritos - capacidad_hilo : 0;
+    descartados += primero;
+    for (uint64_t i = primero; i < buffer->escritos; i++) {
+      const IntervaloTraza *intervalo = &buffer->intervalos[i & (capacidad_hilo - 1)];
+      // Microsegundos desde traza_iniciar, con precisión de ns
+      fprintf(archivo, ",\n{\"name\": \"%s\", \"cat\": \"%s\", \"ph\": \"X\", \"pid\": 1, "
+                       "\"tid\": %d, \"ts\": %.3f, \"dur\": %.3f, \"args\": {\"n\": %lld}}",
+              intervalo->nombre, intervalo->categoria, buffer->hilo,
+              (double)(intervalo->inicio_ns - origen_ns) / 1000.0,
+              (double)intervalo->duracion_ns / 1000.0, intervalo->argumento);
+    }
+  }
+  pthread_mutex_unlock(&cerrojo);
+  fprintf(archivo, "\n], \"otherData\": {\"intervalos_descartados\": %llu}}\n",
+          (unsigned long long)descartados);
+
+  bool ok = !ferror(archivo);
+  return fclose(archivo) == 0 && ok;
+}
+
+void traza_cerrar(void) {
+  if (!activa) return;
+  activa = false;
+  pthread_setspecific(clave_buffer, NULL);
+  pthread_key_delete(clave_buffer);
+
+  pthread_mutex_lock(&cerrojo);
+  for (int b = 0; b < num_buffers; b++) {
+    bio_free(buffers[b]->intervalos);
+    bio_free(buffers[b]);
+  }
+  bio_free(buffers);
+  buffers = NULL;
+  num_buffers = 0;
+  capacidad_buffers = 0;
+  pthread_mutex_unlock(&cerrojo);
+}
@@ -0,0 +1,70 @@
+#ifndef TRAZA_H
+#define TRAZA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================================
+// TRAZA - Línea de tiempo en formato Chrome trace-event
+// Modo opcional (generador --traza ruta.json): cada hilo registra
+// intervalos (nombre, categoría, inicio, duración, argumento) en su
+// propio buffer circular y al terminar se vuelcan como JSON para
+// chrome://tracing o Perfetto. Sin traza_iniciar las funciones solo
+// comprueban una bandera.
+//
+// Uso:
+//   uint64_t inicio = traza_inicio();
+//   ...
+//   traza_fin("dijkstra", "rutas", inicio, origen);
+//
+// Cuando el buffer de un hilo se llena se pisan los intervalos más
+// antiguos. Los buffers de hilos terminados se reutilizan en hilos
+// nuevos, que aparecen en la misma fila de la línea de tiempo.
+// ============================================================
+
+// Intervalos por hilo si traza_iniciar recibe 0
+#define TRAZA_CAPACIDAD_DEFECTO (1 << 16)
+
+/**
+ * Activa la traza (llamar antes de crear hilos)
+ * capacidad = intervalos por hilo (se redondea a potencia de 2)
+ * Complejidad: O(1)
+ * Retorna: false si no se pudo reservar el estado
+ */
+bool traza_iniciar(size_t capacidad);
+
+/**
+ * true entre traza_iniciar y traza_cerrar
+ * Complejidad: O(1)
+ */
+bool traza_activa(void);
+
+/**
+ * Marca de tiempo para traza_fin (0 si la traza está inactiva)
+ * Complejidad: O(1)
+ */
+uint64_t traza_inicio(void);
+
+/**
+ * Registra el intervalo [inicio, ahora] en el buffer del hilo actual
+ * nombre y categoria: cadenas estáticas; argumento: p.ej. día u origen
+ * Complejidad: O(1) (O(hilos) la primera vez en cada hilo)
+ */
+void traza_fin(const char *nombre, const char *categoria, uint64_t inicio, long long argumento);
+
+/**
+ * Escribe todos los intervalos como JSON (traceEvents con fases "X" y
+ * nombres de hilo)
+ * Complejidad: O(intervalos registrados)
+ * Retorna: false si no se pudo escribir el archivo
+ */
+bool traza_escribir(const char *ruta);
+
+/**
+ * Desactiva la traza y libera los buffers (sin hilos trabajando)
+ * Complejidad: O(hilos)
+ */
+void traza_cerrar(void);
+
+#endif // TRAZA_H
@@ -1,4 +1,5 @@
 #include "trie.h"
+#include "memoria.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -23,8 +24,8 @@ static char indice_a_adn(int indice) {
 }
 
 Trie* trie_crear() {
-  Trie *trie = (Trie *)malloc(sizeof(Trie));
-  trie->raiz = (NodoTrie *)calloc(1, sizeof(NodoTrie));
+  Trie *trie = (Trie *)bio_malloc(sizeof(Trie));
+  trie->raiz = (NodoTrie *)bio_calloc(1, sizeof(NodoTrie));
   trie->raiz->es_final = false;
   trie->raiz->cepa_id = -1;
   return trie;
@@ -40,7 +41,7 @@ void trie_insertar(Trie *trie, const char *adn, int cepa_id) {
     if (indice < 0) continue;  // Ignorar bases inválidas
     
     if (actual->hijos[indice] == NULL) {
-      actual->hijos[indice] = (NodoTrie *)calloc(1, sizeof(NodoTrie));
+      actual->hijos[indice] = (NodoTrie *)bio_calloc(1, sizeof(NodoTrie));
       actual->hijos[indice]->es_final = false;
       actual->hijos[indice]->cepa_id = -1;
     }
@@ -86,7 +87,7 @@ int* trie_buscar_por_prefijo(Trie *trie, const char *prefijo, int *cantidad) {
   }
   
   // Contar cepas que comienzan con este prefijo (DFS)
-  int *resultados = (int *)malloc(sizeof(int) * 50);  // Max 50 cepas
+  int *resultados = (int *)bio_malloc(sizeof(int) * 50);  // Max 50 cepas
   int idx = 0;
   
   // DFS recursivo para recolectar todas las cepas bajo este nodo
@@ -116,12 +117,12 @@ static void trie_liberar_recurivo(NodoTrie *nodo) {
     }
   }
   
-  free(nodo);
+  bio_free(nodo);
 }
 
 void trie_liberar(Trie *trie) {
   if (!trie) return;
   
   trie_liberar_recurivo(trie->raiz);
-  free(trie);
+  bio_free(trie);
 }
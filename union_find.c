@@ -1,4 +1,5 @@
 #include "union_find.h"
+#include "memoria.h"
 #include <stdlib.h>
 
 // ============================================================
@@ -7,17 +8,21 @@
 // ============================================================
 
 UnionFind* union_find_crear(int n) {
-  UnionFind *uf = (UnionFind *)malloc(sizeof(UnionFind));
+  UnionFind *uf = (UnionFind *)bio_malloc(sizeof(UnionFind));
+  union_find_inicializar(uf, (int *)bio_malloc(n * sizeof(int)),
+                         (int *)bio_malloc(n * sizeof(int)), n);
+  return uf;
+}
+
+void union_find_inicializar(UnionFind *uf, int *padre, int *rango, int n) {
   uf->num_elementos = n;
-  uf->padre = (int *)malloc(n * sizeof(int));
-  uf->rango = (int *)malloc(n * sizeof(int));
+  uf->padre = padre;
+  uf->rango = rango;
   
   for (int i = 0; i < n; i++) {
     uf->padre[i] = i;
     uf->rango[i] = 0;
   }
-  
-  return uf;
 }
 
 int union_find_buscar(UnionFind *uf, int x) {
@@ -65,7 +70,7 @@ bool union_find_mismo_conjunto(UnionFind *uf, int x, int y) {
 void union_find_liberar(UnionFind *uf) {
   if (!uf) return;
   
-  free(uf->padre);
-  free(uf->rango);
-  free(uf);
+  bio_free(uf->padre);
+  bio_free(uf->rango);
+  bio_free(uf);
 }
@@ -16,6 +16,13 @@
  */
 UnionFind* union_find_crear(int n);
 
+/**
+ * Inicializa un Union-Find sobre arrays del llamador (p.ej. de una arena)
+ * padre y rango deben tener n elementos; no usar union_find_liberar
+ * Complejidad: O(n)
+ */
+void union_find_inicializar(UnionFind *uf, int *padre, int *rango, int n);
+
 /**
  * Encuentra el representante (raíz) del conjunto al que pertenece x
  * Con compresión de camino: O(α(n)) amortizado